@@ -7,6 +7,12 @@ public class InputSequence : ModuleRules
 	public InputSequence(ReadOnlyTargetRules Target) : base(Target)
 	{
 		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Evaluator core is plain C++, this hooks it to stats and Insights when built as part of the module
+		PrivateDefinitions.Add("INPUTSEQUENCE_CORE_WITH_UE=1");
+
+		// Hit counters cost an atomic increment per state event, they are left out of shipping builds
+		PublicDefinitions.Add("INPUTSEQUENCE_WITH_HIT_COUNTERS=" + (Target.Configuration == UnrealTargetConfiguration.Shipping ? "0" : "1"));
 		
 		PublicIncludePaths.AddRange(
 			new string[] {
@@ -25,7 +31,7 @@ public class InputSequence : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core", "CoreUObject"
+				"Core", "CoreUObject", "EnhancedInput"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -1,9 +1,120 @@
 // Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
 
 #include "InputSequence.h"
+#include "InputSequenceAsset.h"
+#include "InputSequenceHitCounters.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
 
 #define LOCTEXT_NAMESPACE "FInputSequenceModule"
 
+DEFINE_LOG_CATEGORY(LogInputSequence);
+
+static void DumpInputSequenceMemReport()
+{
+	FInputSequenceMemoryReport totalReport;
+
+	UE_LOG(LogInputSequence, Log, TEXT("%8s %8s %12s %12s %12s  %s"), TEXT("States"), TEXT("Actions"), TEXT("SourceBytes"), TEXT("Compiled"), TEXT("Runtime"), TEXT("Asset"));
+
+	for (TObjectIterator<UInputSequenceAsset> It; It; ++It)
+	{
+		if (It->HasAnyFlags(RF_ClassDefaultObject)) continue;
+
+		FInputSequenceMemoryReport memoryReport;
+		It->GetMemoryReport(memoryReport);
+
+		UE_LOG(LogInputSequence, Log, TEXT("%8d %8d %12llu %12llu %12llu  %s"), memoryReport.NumStates, memoryReport.NumActions, (uint64)memoryReport.SourceBytes, (uint64)memoryReport.CompiledBytes, (uint64)memoryReport.RuntimeBytes, *It->GetPathName());
+
+		totalReport.NumStates += memoryReport.NumStates;
+		totalReport.NumActions += memoryReport.NumActions;
+		totalReport.SourceBytes += memoryReport.SourceBytes;
+		totalReport.CompiledBytes += memoryReport.CompiledBytes;
+		totalReport.RuntimeBytes += memoryReport.RuntimeBytes;
+	}
+
+	UE_LOG(LogInputSequence, Log, TEXT("%8d %8d %12llu %12llu %12llu  %s"), totalReport.NumStates, totalReport.NumActions, (uint64)totalReport.SourceBytes, (uint64)totalReport.CompiledBytes, (uint64)totalReport.RuntimeBytes, TEXT("Total"));
+}
+
+static FAutoConsoleCommand InputSequenceMemReportCommand(
+	TEXT("InputSequence.MemReport"),
+	TEXT("Logs memory used by every loaded Input Sequence Asset: editor States (before) and compiled data (after)"),
+	FConsoleCommandDelegate::CreateStatic(&DumpInputSequenceMemReport));
+
+static void RecordInputSequences(const TArray<FString>& args)
+{
+	const bool bStart = args.Num() > 0 && args[0].Equals(TEXT("Start"), ESearchCase::IgnoreCase);
+	const bool bStop = args.Num() > 0 && args[0].Equals(TEXT("Stop"), ESearchCase::IgnoreCase);
+
+	if (!bStart && !bStop)
+	{
+		UE_LOG(LogInputSequence, Warning, TEXT("Usage: InputSequence.Record Start|Stop [Directory]"));
+		return;
+	}
+
+	const FString directory = args.Num() > 1 ? args[1] : FPaths::ProjectSavedDir() / TEXT("InputSequence");
+	const FString timestamp = FDateTime::Now().ToString();
+
+	for (TObjectIterator<UInputSequenceAsset> It; It; ++It)
+	{
+		if (It->HasAnyFlags(RF_ClassDefaultObject)) continue;
+
+		if (bStart)
+		{
+			It->StartRecording();
+		}
+		else if (It->IsRecording())
+		{
+			It->StopRecording(directory / FString::Printf(TEXT("%s_%s.isrec"), *It->GetName(), *timestamp));
+		}
+	}
+}
+
+static FAutoConsoleCommand InputSequenceRecordCommand(
+	TEXT("InputSequence.Record"),
+	TEXT("Start|Stop [Directory]: records input fed to every loaded Input Sequence Asset, on stop recordings are saved to Directory (Saved/InputSequence by default) for InputSequenceReplay commandlet"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RecordInputSequences));
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+
+static void CountInputSequenceHits(const TArray<FString>& args)
+{
+	FInputSequenceHitCounters& hitCounters = FInputSequenceHitCounters::Get();
+
+	const FString command = args.Num() > 0 ? args[0] : FString();
+
+	if (command.Equals(TEXT("Start"), ESearchCase::IgnoreCase))
+	{
+		hitCounters.Start();
+	}
+	else if (command.Equals(TEXT("Stop"), ESearchCase::IgnoreCase))
+	{
+		hitCounters.Stop();
+	}
+	else if (command.Equals(TEXT("Reset"), ESearchCase::IgnoreCase))
+	{
+		hitCounters.Reset();
+	}
+	else if (command.Equals(TEXT("Save"), ESearchCase::IgnoreCase))
+	{
+		const FString filePath = args.Num() > 1 ? args[1] : FPaths::ProjectSavedDir() / TEXT("InputSequence") / TEXT("HitCounters.ishits");
+
+		if (hitCounters.Save(filePath)) UE_LOG(LogInputSequence, Log, TEXT("Hit counters are saved to %s"), *filePath);
+	}
+	else
+	{
+		UE_LOG(LogInputSequence, Warning, TEXT("Usage: InputSequence.HitCounters Start|Stop|Reset|Save [FilePath]"));
+	}
+}
+
+static FAutoConsoleCommand InputSequenceHitCountersCommand(
+	TEXT("InputSequence.HitCounters"),
+	TEXT("Start|Stop|Reset|Save [FilePath]: counts entered, passed and reset states of every evaluated Input Sequence Asset. Save adds counts to ones already in file (Saved/InputSequence/HitCounters.ishits by default), so it collects many play sessions for heatmap of asset editor"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&CountInputSequenceHits));
+
+#endif
+
 void FInputSequenceModule::StartupModule()
 {
 }
@@ -1,17 +1,93 @@
 // Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
 
 #include "InputSequenceAsset.h"
+#include "InputSequence.h"
+#include "InputSequenceTrace.h"
+#include "InputSequenceRecording.h"
+#include "InputSequenceHitCounters.h"
+#include "Engine/EngineBaseTypes.h"
 
-FInputSequenceState::FInputSequenceState()
+void UInputSequenceEvent::OnExecuteByClass(const TSubclassOf<UInputSequenceEvent>& eventClass, int32 index, UObject* callingObject, const FString& callingContext, UObject* stateObject, const FString& stateContext, const TArray<FInputSequenceResetSource>& resetSources)
+{
+	INPUTSEQUENCE_SCOPE_CYCLE_COUNTER(STAT_InputSequence_EventDispatch);
+
+	if (eventClass)
+	{
+		if (UInputSequenceEvent* eventObject = eventClass->GetDefaultObject<UInputSequenceEvent>())
+		{
+			eventObject->NativeOnExecute(index, callingObject, callingContext, stateObject, stateContext, resetSources);
+		}
+	}
+}
+
+FString FInputSequenceAxisRegion::ToString() const
+{
+	FString result;
+	StaticStruct()->ExportText(result, this, nullptr, nullptr, PPF_None, nullptr);
+
+	return result;
+}
+
+bool FInputSequenceAxisRegion::InitFromString(const FString& sourceString)
+{
+	return !sourceString.IsEmpty() && StaticStruct()->ImportText(*sourceString, this, nullptr, PPF_None, GWarn, StaticStruct()->GetName()) != nullptr;
+}
+
+InputSequenceCore::FCompactRegion FInputSequenceAxisRegion::ToCompact() const
 {
-	AccumulatedTime = 0;
+	InputSequenceCore::FCompactRegion region = {};
+
+	const bool is2D = NumDimensions < 3;
 
+	switch (Shape)
+	{
+	case EInputSequenceAxisRegionShape::Box:
+	{
+		region.A[0] = FMath::Min(A.X, B.X); region.B[0] = FMath::Max(A.X, B.X);
+		region.A[1] = FMath::Min(A.Y, B.Y); region.B[1] = FMath::Max(A.Y, B.Y);
+		region.A[2] = is2D ? 0 : FMath::Min(A.Z, B.Z); region.B[2] = is2D ? 0 : FMath::Max(A.Z, B.Z);
+	}
+	break;
+
+	case EInputSequenceAxisRegionShape::Sphere:
+	{
+		region.A[0] = A.X;
+		region.A[1] = A.Y;
+		region.A[2] = is2D ? 0 : A.Z;
+		region.A[3] = FMath::Abs(B.X);
+	}
+	break;
+
+	case EInputSequenceAxisRegionShape::Cone:
+	{
+		const FVector direction = FVector(A.X, A.Y, is2D ? 0 : A.Z).GetSafeNormal();
+
+		region.A[0] = direction.X;
+		region.A[1] = direction.Y;
+		region.A[2] = direction.Z;
+		region.A[3] = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(B.X, 0, 180)));
+		region.B[0] = FMath::Max(B.Y, 0);
+		region.B[1] = B.Z > 0 ? B.Z : TNumericLimits<float>::Max();
+	}
+	break;
+
+	default:
+		break;
+	}
+
+	return region;
+}
+
+FInputSequenceState::FInputSequenceState()
+{
 	InputActions.Reset();
+	InputActionObjects.Reset();
 	PressedActions.Reset();
 	EnterEventClasses.Reset();
 	PassEventClasses.Reset();
 	ResetEventClasses.Reset();
 	NextIndice.Reset();
+	DepthIndex = 0;
 	FirstLayerParentIndex = INDEX_NONE;
 
 	StateObject = nullptr;
@@ -19,6 +95,7 @@ FInputSequenceState::FInputSequenceState()
 
 	IsInputNode = 0;
 	IsAxisNode = 0;
+	IsGestureNode = 0;
 
 	canBePassedAfterTime = 0;
 
@@ -31,76 +108,18 @@ FInputSequenceState::FInputSequenceState()
 	TimeParam = 0;
 }
 
-bool FInputSequenceState::IsOpen() const
+SIZE_T FInputSequenceState::GetAllocatedSize() const
 {
-	for (const TPair<FName, FInputActionState>& inputActionEntry : InputActions)
-	{
-		const FName& actionName = inputActionEntry.Key;
-		const FInputActionState& inputActionState = inputActionEntry.Value;
+	SIZE_T allocatedSize = InputActions.GetAllocatedSize() + PressedActions.GetAllocatedSize() + NextIndice.GetAllocatedSize() + StateContext.GetAllocatedSize() + InputActionObjects.GetAllocatedSize();
 
-		if (IsAxisNode && !inputActionState.IsOpen_Axis() || !inputActionState.IsOpen_Action()) return false;
-	}
-
-	return true;
-}
+	allocatedSize += EnterEventClasses.GetAllocatedSize() + PassEventClasses.GetAllocatedSize() + ResetEventClasses.GetAllocatedSize();
 
-bool FInputSequenceState::ConsumeInput(const TMap<FName, TEnumAsByte<EInputEvent>> inputActionEvents, const TSet<FName>& pressedActions, const TMap<FName, float>& inputAxisEvents)
-{
-	bool result = false;
-
-	for (TPair<FName, FInputActionState>& inputActionEntry : InputActions)
+	for (const TPair<FName, FInputActionState>& inputActionEntry : InputActions)
 	{
-		const FName& actionName = inputActionEntry.Key;
-		FInputActionState& inputActionState = inputActionEntry.Value;
-
-		if (IsAxisNode)
-		{
-			if (inputActionState.Is2DAxis())
-			{
-				if (inputAxisEvents.Contains(inputActionState.GetSubNameA()) && inputAxisEvents.Contains(inputActionState.GetSubNameB()))
-				{
-					if (inputActionState.ConsumeInput_2DAxis(inputAxisEvents[inputActionState.GetSubNameA()], inputAxisEvents[inputActionState.GetSubNameB()]))
-					{
-						AccumulatedTime = 0;
-						result = true;
-					}
-				}
-			}
-			else
-			{
-				if (inputAxisEvents.Contains(actionName) && !inputActionState.IsOpen_Axis())
-				{
-					if (inputActionState.ConsumeInput_Axis(inputAxisEvents[actionName]))
-					{
-						AccumulatedTime = 0;
-						result = true;
-					}
-				}
-			}
-		}
-		else
-		{
-			if (inputActionEvents.Contains(actionName) && !inputActionState.IsOpen_Action())
-			{
-				if (inputActionState.ConsumeInput_Action(inputActionEvents[actionName]))
-				{
-					AccumulatedTime = 0;
-					result = true;
-				}
-			}
-
-			if (pressedActions.Contains(actionName) && !inputActionState.IsOpen_Action())
-			{
-				if (inputActionState.ConsumeInput_Action(IE_Pressed))
-				{
-					AccumulatedTime = 0;
-					result = true;
-				}
-			}
-		}
+		allocatedSize += inputActionEntry.Value.GetInputEvents().GetAllocatedSize() + inputActionEntry.Value.GetGestureSteps().GetAllocatedSize();
 	}
 
-	return result;
+	return allocatedSize;
 }
 
 
@@ -115,350 +134,335 @@ UInputSequenceAsset::UInputSequenceAsset(const FObjectInitializer& objInit) :Sup
 	bStepFromStatesWhenGamePaused = 0;
 	bTickStatesWhenGamePaused = 0;
 
-	ActiveIndice.Empty();
+	bFilterAxisInput = 0;
+	AxisHysteresis = 0.05f;
+
 	ResetSources.Empty();
+
+	Instance.SetStateEventCallback(&UInputSequenceAsset::OnStateEvent, this);
 }
 
-void UInputSequenceAsset::OnInput(const float DeltaTime, const bool bGamePaused, const TMap<FName, TEnumAsByte<EInputEvent>>& inputActionEvents, const TMap<FName, float>& inputAxisEvents, TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources)
+void UInputSequenceAsset::PostLoad()
 {
-	for (const TPair<FName, TEnumAsByte<EInputEvent>>& inputActionEvent : inputActionEvents)
-	{
-		if (inputActionEvent.Value == EInputEvent::IE_Released) PressedActions.Remove(inputActionEvent.Key);
-		if (inputActionEvent.Value == EInputEvent::IE_Pressed) PressedActions.FindOrAdd(inputActionEvent.Key);
-	}
+	Super::PostLoad();
+
+#if WITH_EDITOR
+
+	if (!HasAnyFlags(RF_ClassDefaultObject)) CompileIfOutdated();
+
+#endif
+}
 
-	int32 inputActionEventsNum = inputActionEvents.Num();
-	int32 pressedActionsNum = PressedActions.Num();
+void UInputSequenceAsset::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	FInputSequenceMemoryReport memoryReport;
+	GetMemoryReport(memoryReport);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(memoryReport.SourceBytes + memoryReport.CompiledBytes + memoryReport.RuntimeBytes);
+}
+
+void UInputSequenceAsset::GetMemoryReport(FInputSequenceMemoryReport& outReport) const
+{
+	outReport = FInputSequenceMemoryReport();
 
-	if (ActiveIndice.IsEmpty()) MakeTransition(0, States[0].NextIndice, outEventCalls);
+	outReport.NumStates = CompiledData.NumStates();
+	outReport.NumActions = CompiledData.NumActions();
+	outReport.CompiledBytes = CompiledData.GetAllocatedSize();
+	outReport.RuntimeBytes = Instance.GetAllocatedSize() + NameIds.GetAllocatedSize();
 
-	TSet<int32> prevActiveIndice = ActiveIndice;
+#if WITH_EDITORONLY_DATA
 
-	if (!bGamePaused || bStepFromStatesWhenGamePaused)
+	outReport.SourceBytes = States.GetAllocatedSize();
+
+	for (const FInputSequenceState& state : States)
 	{
-		for (int32 activeIndex : prevActiveIndice)
-		{
-			FInputSequenceState& state = States[activeIndex];
-			int32 stateInputActionsNum = state.InputActions.Num();
-
-			if (!state.IsInputNode)
-			{
-				RequestResetWithNode(activeIndex, state);
-			}
-			else
-			{
-				bool match = true;
-
-				if ((inputActionEventsNum + pressedActionsNum) > 0)
-				{
-					// Match with Pressed Actions for all
-
-					for (const FName& pressedAction : PressedActions)
-					{
-						if (!state.PressedActions.Contains(pressedAction))
-						{
-							if (state.IsAxisNode)
-							{
-								match = false;
-								RequestResetWithNode(activeIndex, state);
-
-								break;
-							}
-							else if (requirePreciseMatch && !state.isOverridingRequirePreciseMatch || state.isOverridingRequirePreciseMatch && state.requirePreciseMatch)
-							{
-								if (!state.InputActions.Contains(pressedAction))
-								{
-									match = false;
-									RequestResetWithNode(activeIndex, state);
-
-									break;
-								}
-							}
-						}
-					}
-
-					// Match with Input Action Events only for Input Actions
-
-					if (match && !state.IsAxisNode)
-					{
-						if (requirePreciseMatch && !state.isOverridingRequirePreciseMatch || state.isOverridingRequirePreciseMatch && state.requirePreciseMatch)
-						{
-							for (const TPair<FName, TEnumAsByte<EInputEvent>>& inputActionEvent : inputActionEvents)
-							{
-								if (!state.InputActions.Contains(inputActionEvent.Key))
-								{
-									match = false;
-									RequestResetWithNode(activeIndex, state);
-
-									break;
-								}
-							}
-						}
-					}
-				}
-
-				// Match with must-Pressed Actions for all
-
-				if (match)
-				{
-					for (const FName& pressedAction : state.PressedActions)
-					{
-						if (!PressedActions.Contains(pressedAction))
-						{
-							match = false;
-							RequestResetWithNode(activeIndex, state);
-
-							break;
-						}
-					}
-				}
-
-				// Process if match
-
-				if (match && !state.IsOpen())
-				{
-					if (state.canBePassedAfterTime)
-					{
-						float accumulatedTime = state.AccumulatedTime;
-
-						if (state.ConsumeInput(inputActionEvents, PressedActions, inputAxisEvents))
-						{
-							match = state.IsOpen();
-
-							if (accumulatedTime < state.TimeParam)
-							{
-								match = false;
-								RequestResetWithNode(activeIndex, state);
-							}
-						}
-					}
-					else
-					{
-						match = state.ConsumeInput(inputActionEvents, PressedActions, inputAxisEvents) && state.IsOpen();
-					}
-				}
-
-				if (match) MakeTransition(activeIndex, state.NextIndice, outEventCalls);
-			}
-		}
+		outReport.SourceBytes += state.GetAllocatedSize();
 	}
 
-	if (!bGamePaused || bTickStatesWhenGamePaused)
-	{
-		for (int32 activeIndex : prevActiveIndice)
-		{
-			if (ActiveIndice.Contains(activeIndex)) // Tick on states that already were active before this frame
-			{
-				FInputSequenceState& state = States[activeIndex];
+#endif
+}
 
-				if (!state.IsInputNode) continue;
+#if WITH_EDITOR
 
-				state.AccumulatedTime += DeltaTime;
+FInputSequenceCompileDelegate UInputSequenceAsset::CompileDelegate;
 
-				if (state.canBePassedAfterTime) continue; // States that can be passed only after time are not reset by time at all
+void UInputSequenceAsset::BeginCacheForCookedPlatformData(const ITargetPlatform* TargetPlatform)
+{
+	Super::BeginCacheForCookedPlatformData(TargetPlatform);
 
-				if (state.isOverridingResetAfterTime ? state.isResetAfterTime : isResetAfterTime)
-				{
-					if (state.AccumulatedTime > (state.isOverridingResetAfterTime ? state.TimeParam : ResetAfterTime))
-					{
-						RequestResetWithNode(activeIndex, state);
-					}
-				}
-			}
-		}
-	}
+	CompileIfOutdated();
+}
+
+void UInputSequenceAsset::RebuildCompiledData()
+{
+	CompiledData.Build(States);
 
-	ProcessResetSources(outEventCalls, outResetSources);
+	ResetRuntimeStates();
 }
 
-void UInputSequenceAsset::MakeTransition(int32 fromIndex, const TSet<int32>& nextIndice, TArray<FInputSequenceEventCall>& outEventCalls)
+void UInputSequenceAsset::SetCompiledData(const FInputSequenceCompiledData& compiledData)
 {
-	if (nextIndice.Num() > 0)
-	{
-		for (int32 nextIndex : nextIndice) EnterNode(nextIndex, outEventCalls);
-	}
-	else // Make Transition to First Layer Parent if nextIndice is empty
-	{
-		FInputSequenceState& state = States[fromIndex];
-		EnterNode(state.FirstLayerParentIndex, outEventCalls);
-	}
+	CompiledData = compiledData;
 
-	PassNode(fromIndex, outEventCalls);
+	ResetRuntimeStates();
 }
 
-void UInputSequenceAsset::RequestResetWithNode(int32 nodeIndex, FInputSequenceState& state)
+void UInputSequenceAsset::CompileIfOutdated()
 {
-	if (state.IsFirstLayer())
+	if (CompileDelegate.IsBound())
 	{
-		state.Reset();
+		CompileDelegate.Execute(this);
 	}
-	else
+	else if (States.Num() > 0 && !CompiledData.IsUpToDate(FInputSequenceCompiledData::HashSource(States)))
 	{
-		FScopeLock Lock(&resetSourcesCS);
-
-		int32 emplacedIndex = ResetSources.Emplace();
-		ResetSources[emplacedIndex].SourceIndex = nodeIndex;
-
-		ActiveIndice.Remove(nodeIndex);
+		RebuildCompiledData();
 	}
 }
 
-void UInputSequenceAsset::EnterNode(int32 nodeIndex, TArray<FInputSequenceEventCall>& outEventCalls)
+#endif
+
+void UInputSequenceAsset::OnInput(const float DeltaTime, const bool bGamePaused, const TMap<FName, TEnumAsByte<EInputEvent>>& inputActionEvents, const TMap<FName, float>& inputAxisEvents, TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources)
 {
-	if (!ActiveIndice.Contains(nodeIndex))
+	INPUTSEQUENCE_SCOPE_CYCLE_COUNTER(STAT_InputSequence_OnInput);
+
+	FScopeLock Lock(&resetSourcesCS);
+
+	if (Recorder)
 	{
-		FInputSequenceState& state = States[nodeIndex];
+		TMap<FName, FVector3f> recordedAxisEvents;
+		for (const TPair<FName, float>& inputAxisEvent : inputAxisEvents) recordedAxisEvents.Add(inputAxisEvent.Key, FVector3f(inputAxisEvent.Value, 0, 0));
 
-		for (const TSubclassOf<UInputSequenceEvent>& enterEventClass : state.EnterEventClasses)
-		{
-			int32 emplacedIndex = outEventCalls.Emplace();
-			outEventCalls[emplacedIndex].EventClass = enterEventClass;
-			outEventCalls[emplacedIndex].Index = nodeIndex;
-			outEventCalls[emplacedIndex].Object = state.StateObject;
-			outEventCalls[emplacedIndex].Context = state.StateContext;
-		}
+		Recorder->RecordFrame(DeltaTime, bGamePaused, inputActionEvents, recordedAxisEvents);
+	}
+
+	if (NameIds.Num() < CompiledData.NumNames()) ResetRuntimeStates();
 
-		state.Reset();
-		ActiveIndice.Add(nodeIndex);
+	ActionInputs.clear();
+	AxisInputs.clear();
 
-		// Jump through empty Input nodes
+	for (const TPair<FName, TEnumAsByte<EInputEvent>>& inputActionEvent : inputActionEvents)
+	{
+		ActionInputs.push_back({ GetNameId(inputActionEvent.Key), (InputSequenceCore::EInputEvent)inputActionEvent.Value.GetValue() });
+	}
 
-		if (state.IsInputNode && state.IsEmpty()) MakeTransition(nodeIndex, state.NextIndice, outEventCalls);
+	for (const TPair<FName, float>& inputAxisEvent : inputAxisEvents)
+	{
+		AxisInputs.push_back({ GetNameId(inputAxisEvent.Key), inputAxisEvent.Value });
 	}
+
+	EvaluateInput(DeltaTime, bGamePaused, MakeArrayView(ActionInputs.data(), (int32)ActionInputs.size()), MakeArrayView(AxisInputs.data(), (int32)AxisInputs.size()), outEventCalls, outResetSources);
 }
 
-void UInputSequenceAsset::PassNode(int32 nodeIndex, TArray<FInputSequenceEventCall>& outEventCalls)
+void UInputSequenceAsset::OnNativeInput(float DeltaTime, bool bGamePaused, TConstArrayView<InputSequenceCore::FActionInput> actionInputs, TConstArrayView<InputSequenceCore::FAxisInput> axisInputs, TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources)
 {
-	if (ActiveIndice.Contains(nodeIndex))
+	INPUTSEQUENCE_SCOPE_CYCLE_COUNTER(STAT_InputSequence_OnInput);
+
+	FScopeLock Lock(&resetSourcesCS);
+
+	if (Recorder)
 	{
-		FInputSequenceState& state = States[nodeIndex];
+		// Recordings are keyed by names, so ids are resolved back only while recording
+
+		TMap<FName, TEnumAsByte<EInputEvent>> inputActionEvents;
+		TMap<FName, FVector3f> inputAxisEvents;
+
+		for (const InputSequenceCore::FActionInput& actionInput : actionInputs)
+		{
+			if (actionInput.NameId < (uint32)CompiledData.NumNames()) inputActionEvents.Add(CompiledData.GetName(actionInput.NameId), (EInputEvent)actionInput.Event);
+		}
 
-		for (const TSubclassOf<UInputSequenceEvent>& passEventClass : state.PassEventClasses)
+		for (const InputSequenceCore::FAxisInput& axisInput : axisInputs)
 		{
-			int32 emplacedIndex = outEventCalls.Emplace();
-			outEventCalls[emplacedIndex].EventClass = passEventClass;
-			outEventCalls[emplacedIndex].Index = nodeIndex;
-			outEventCalls[emplacedIndex].Object = state.StateObject;
-			outEventCalls[emplacedIndex].Context = state.StateContext;
+			if (axisInput.NameId < (uint32)CompiledData.NumNames()) inputAxisEvents.Add(CompiledData.GetName(axisInput.NameId), FVector3f(axisInput.Value, axisInput.ValueY, axisInput.ValueZ));
 		}
 
-		ActiveIndice.Remove(nodeIndex);
+		Recorder->RecordFrame(DeltaTime, bGamePaused, inputActionEvents, inputAxisEvents);
 	}
-}
 
-void UInputSequenceAsset::RequestReset(UObject* sourceObject, const FString& sourceContext)
-{
-	FScopeLock Lock(&resetSourcesCS);
+	if (NameIds.Num() < CompiledData.NumNames()) ResetRuntimeStates();
 
-	int32 emplacedIndex = ResetSources.Emplace();
-	ResetSources[emplacedIndex].SourceObject = sourceObject;
-	ResetSources[emplacedIndex].SourceContext = sourceContext;
+	EvaluateInput(DeltaTime, bGamePaused, actionInputs, axisInputs, outEventCalls, outResetSources);
 }
 
-void UInputSequenceAsset::ClearInputStates() { PressedActions.Empty(); }
-
-void UInputSequenceAsset::ProcessResetSources(TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources)
+void UInputSequenceAsset::EvaluateInput(float DeltaTime, bool bGamePaused, TConstArrayView<InputSequenceCore::FActionInput> actionInputs, TConstArrayView<InputSequenceCore::FAxisInput> axisInputs, TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources)
 {
-	bool bResetAll = false;
+	InputSequenceCore::FSettings settings;
+	settings.ResetAfterTime = ResetAfterTime;
+	settings.bRequirePreciseMatch = requirePreciseMatch;
+	settings.bIsResetAfterTime = isResetAfterTime;
+	settings.bStepFromStatesWhenGamePaused = bStepFromStatesWhenGamePaused;
+	settings.bTickStatesWhenGamePaused = bTickStatesWhenGamePaused;
+	settings.bFilterAxisInput = bFilterAxisInput;
+	settings.AxisHysteresis = AxisHysteresis;
 
-	TSet<int32> nodeSources;
-	TSet<int32> resetFLParents;
-	TSet<int32> checkFLParents;
+	CoreEventCalls.clear();
+	CoreResetSources.clear();
 
-	ProcessResetSources(bResetAll, nodeSources, resetFLParents, checkFLParents, outResetSources);
+	Instance.OnInput(CompiledData.GetView(), settings, DeltaTime, bGamePaused, actionInputs.GetData(), actionInputs.Num(), axisInputs.GetData(), axisInputs.Num(), CoreEventCalls, CoreResetSources);
 
-	for (int32 nodeIndex : nodeSources)
+	for (const InputSequenceCore::FEventCall& coreEventCall : CoreEventCalls)
 	{
-		const FInputSequenceState& state = States[nodeIndex];
+		const FInputSequenceCompactState& state = CompiledData.GetState(coreEventCall.StateIndex);
 
-		for (const TSubclassOf<UInputSequenceEvent>& resetEventClass : state.ResetEventClasses)
-		{
-			int32 emplacedIndex = outEventCalls.Emplace();
-			outEventCalls[emplacedIndex].EventClass = resetEventClass;
-			outEventCalls[emplacedIndex].Index = nodeIndex;
-			outEventCalls[emplacedIndex].Object = state.StateObject;
-			outEventCalls[emplacedIndex].Context = state.StateContext;
-		}
+		int32 emplacedIndex = outEventCalls.Emplace();
+		outEventCalls[emplacedIndex].EventClass = CompiledData.GetEventClass(coreEventCall.EventClassIndex);
+		outEventCalls[emplacedIndex].Index = coreEventCall.StateIndex;
+		outEventCalls[emplacedIndex].Object = CompiledData.GetObject(state.StateObjectIndex);
+		outEventCalls[emplacedIndex].Context = CompiledData.GetContext(state.StateContextIndex);
 	}
 
-	if (bResetAll)
+	for (const InputSequenceCore::FResetSource& coreResetSource : CoreResetSources)
 	{
-		for (int32 activeIndex : ActiveIndice)
+		if (coreResetSource.SourceIndex == INDEX_NONE)
 		{
-			const FInputSequenceState& state = States[activeIndex];
-
-			for (const TSubclassOf<UInputSequenceEvent>& resetEventClass : state.ResetEventClasses)
-			{
-				int32 emplacedIndex = outEventCalls.Emplace();
-				outEventCalls[emplacedIndex].EventClass = resetEventClass;
-				outEventCalls[emplacedIndex].Object = state.StateObject;
-				outEventCalls[emplacedIndex].Context = state.StateContext;
-			}
+			outResetSources.Add(ResetSources[coreResetSource.ExternalId]);
 		}
+		else
+		{
+			int32 emplacedIndex = outResetSources.Emplace();
+			outResetSources[emplacedIndex].SourceIndex = coreResetSource.SourceIndex;
+		}
+	}
+
+	// Requests that came before compiled data is ready are kept by core evaluator until next frame
+
+	if (CompiledData.NumStates() > 0) ResetSources.Reset();
+
+	const InputSequenceCore::FFrameStats& frameStats = Instance.GetFrameStats();
+
+	INC_DWORD_STAT_BY(STAT_InputSequence_Transitions, frameStats.Transitions);
+	INC_DWORD_STAT_BY(STAT_InputSequence_Resets, frameStats.Resets);
+	INC_DWORD_STAT_BY(STAT_InputSequence_EventCalls, frameStats.EventCalls);
+	INC_DWORD_STAT_BY(STAT_InputSequence_AxisZoneChanges, frameStats.AxisZoneChanges);
+	INC_DWORD_STAT_BY(STAT_InputSequence_ActiveStates, Instance.GetNumActiveStates());
+}
+
+bool UInputSequenceAsset::GetStateTimer(int32 stateIndex, float& outTime, float& outTimeLimit) const
+{
+	using namespace InputSequenceCore;
+
+	const FGraphView graph = CompiledData.GetView();
+
+	if (!graph.IsValidStateIndex(stateIndex) || !Instance.IsStateActive(stateIndex)) return false;
+
+	const FCompactState& state = graph.GetState(stateIndex);
 
-		ActiveIndice.Empty();
+	if (state.HasFlag(EStateFlags::CanBePassedAfterTime))
+	{
+		outTimeLimit = state.TimeParam;
+	}
+	else if (state.HasFlag(EStateFlags::OverridingResetAfterTime) ? state.HasFlag(EStateFlags::ResetAfterTime) : isResetAfterTime)
+	{
+		outTimeLimit = state.HasFlag(EStateFlags::OverridingResetAfterTime) ? state.TimeParam : ResetAfterTime;
 	}
 	else
 	{
-		for (TSet<int32>::TIterator It(ActiveIndice); It; ++It)
-		{
-			const FInputSequenceState& state = States[*It];
-
-			if (resetFLParents.Contains(state.FirstLayerParentIndex))
-			{
-				for (const TSubclassOf<UInputSequenceEvent>& resetEventClass : state.ResetEventClasses)
-				{
-					int32 emplacedIndex = outEventCalls.Emplace();
-					outEventCalls[emplacedIndex].EventClass = resetEventClass;
-					outEventCalls[emplacedIndex].Object = state.StateObject;
-					outEventCalls[emplacedIndex].Context = state.StateContext;
-				}
-
-				It.RemoveCurrent();
-
-				if (checkFLParents.Contains(state.FirstLayerParentIndex))
-				{
-					checkFLParents.Remove(state.FirstLayerParentIndex);
-				}
-			}
-			else if (checkFLParents.Contains(state.FirstLayerParentIndex))
-			{
-				checkFLParents.Remove(state.FirstLayerParentIndex);
-			}
-		}
+		return false;
+	}
+
+	outTime = Instance.GetStateTime(stateIndex);
+
+	return outTimeLimit > 0;
+}
+
+void UInputSequenceAsset::ResetRuntimeStates()
+{
+	Instance.Reset(CompiledData.GetView());
+	Instance.ClearPressedActions();
 
-		if (resetFLParents.Num() > 0) MakeTransition(0, resetFLParents, outEventCalls);
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+	UpdateHitCounters();
+#endif
 
-		if (checkFLParents.Num() > 0) MakeTransition(0, checkFLParents, outEventCalls);
+	NameIds.Reset();
+
+	for (int32 nameIndex = 0; nameIndex < CompiledData.NumNames(); nameIndex++)
+	{
+		NameIds.Add(CompiledData.GetName(nameIndex), nameIndex);
+	}
+}
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+
+void UInputSequenceAsset::UpdateHitCounters()
+{
+	FInputSequenceHitCounters& hitCounters = FInputSequenceHitCounters::Get();
+
+	Instance.SetHitCounters(hitCounters.IsStarted() && CompiledData.IsValid() ? hitCounters.FindOrAdd(CompiledData, GetName()) : nullptr);
+}
+
+#endif
+
+uint32 UInputSequenceAsset::GetNameId(const FName& name)
+{
+	if (NameIds.Num() < CompiledData.NumNames()) ResetRuntimeStates();
+
+	if (const uint32* nameId = NameIds.Find(name)) return *nameId;
+	return NameIds.Add(name, NameIds.Num());
+}
+
+void UInputSequenceAsset::OnStateEvent(void* userData, uint16 stateIndex, InputSequenceCore::EStateEvent stateEvent)
+{
+	UInputSequenceAsset* asset = static_cast<UInputSequenceAsset*>(userData);
+
+	asset->NativeStateEvent.Broadcast(asset, stateIndex, stateEvent);
+
+#if INPUTSEQUENCE_TRACE_ENABLED
+
+	switch (stateEvent)
+	{
+	case InputSequenceCore::EStateEvent::Enter: TRACE_INPUTSEQUENCE_STATE(asset, asset->CompiledData.GetSourceHash(), stateIndex, Enter); break;
+	case InputSequenceCore::EStateEvent::Pass: TRACE_INPUTSEQUENCE_STATE(asset, asset->CompiledData.GetSourceHash(), stateIndex, Pass); break;
+	case InputSequenceCore::EStateEvent::Reset: TRACE_INPUTSEQUENCE_STATE(asset, asset->CompiledData.GetSourceHash(), stateIndex, Reset); break;
 	}
+
+#endif
 }
 
-void UInputSequenceAsset::ProcessResetSources(bool& bResetAll, TSet<int32>& nodeSources, TSet<int32>& resetFLParents, TSet<int32>& checkFLParents, TArray<FInputSequenceResetSource>& outResetSources)
+void UInputSequenceAsset::RequestReset(UObject* sourceObject, const FString& sourceContext)
 {
 	FScopeLock Lock(&resetSourcesCS);
 
-	outResetSources = ResetSources;
+	if (Recorder) Recorder->RecordReset(sourceObject, sourceContext);
+
+	int32 emplacedIndex = ResetSources.Emplace();
+	ResetSources[emplacedIndex].SourceObject = sourceObject;
+	ResetSources[emplacedIndex].SourceContext = sourceContext;
+
+	Instance.RequestReset(emplacedIndex);
+}
+
+void UInputSequenceAsset::ClearInputStates()
+{
+	FScopeLock Lock(&resetSourcesCS);
+
+	Instance.ClearPressedActions();
+}
+
+void UInputSequenceAsset::StartRecording()
+{
+	FScopeLock Lock(&resetSourcesCS);
+
+	Recorder = MakeShared<FInputSequenceRecordingWriter>(GetPathName());
+}
+
+bool UInputSequenceAsset::StopRecording(const FString& filePath)
+{
+	TSharedPtr<FInputSequenceRecordingWriter> recorder;
 
-	for (const FInputSequenceResetSource& resetSource : ResetSources)
 	{
-		bResetAll |= resetSource.SourceIndex == INDEX_NONE;
+		FScopeLock Lock(&resetSourcesCS);
 
-		if (States.IsValidIndex(resetSource.SourceIndex))
-		{
-			nodeSources.Add(resetSource.SourceIndex);
-
-			const FInputSequenceState& state = States[resetSource.SourceIndex];
-
-			if (!state.IsInputNode) // GoToStartNode is reseting all Active nodes that have the same FirstLayerParentIndex
-			{
-				if (!resetFLParents.Contains(state.FirstLayerParentIndex)) resetFLParents.Add(state.FirstLayerParentIndex);
-			}
-			else
-			{
-				if (!checkFLParents.Contains(state.FirstLayerParentIndex)) checkFLParents.Add(state.FirstLayerParentIndex);
-			}
-		}
+		recorder = MoveTemp(Recorder);
 	}
 
-	ResetSources.Empty();
+	if (!recorder) return false;
+
+	const bool bIsSaved = recorder->SaveToFile(filePath);
+
+	UE_LOG(LogInputSequence, Log, TEXT("Input Sequence recording of %s: %lld frames, %lld bytes, %s %s"), *GetPathName(), recorder->GetNumFrames(), recorder->GetNumBytes(), bIsSaved ? TEXT("saved to") : TEXT("failed to save to"), *filePath);
+
+	return bIsSaved;
 }
\ No newline at end of file
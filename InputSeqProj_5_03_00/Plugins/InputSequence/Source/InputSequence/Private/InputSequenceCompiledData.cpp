@@ -0,0 +1,419 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceCompiledData.h"
+#include "InputSequence.h"
+#include "InputSequenceAsset.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Serialization/CustomVersion.h"
+#include "Hash/Blake3.h"
+
+const FGuid FInputSequenceCustomVersion::GUID(0x6C3A1F52, 0x8E4B4D27, 0x9B5E0A71, 0x2D94C3E8);
+
+FCustomVersionRegistration GRegisterInputSequenceCustomVersion(FInputSequenceCustomVersion::GUID, FInputSequenceCustomVersion::LatestVersion, TEXT("InputSequenceVer"));
+
+SIZE_T FInputSequenceCompiledData::GetAllocatedSize() const
+{
+	SIZE_T allocatedSize = Blob.GetAllocatedSize() + Names.GetAllocatedSize() + Contexts.GetAllocatedSize() + Objects.GetAllocatedSize() + EventClasses.GetAllocatedSize() + InputActions.GetAllocatedSize();
+
+	for (const FString& context : Contexts)
+	{
+		allocatedSize += context.GetAllocatedSize();
+	}
+
+	return allocatedSize;
+}
+
+bool FInputSequenceCompiledData::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FInputSequenceCustomVersion::GUID);
+
+	if (Ar.IsLoading() && Ar.CustomVer(FInputSequenceCustomVersion::GUID) < FInputSequenceCustomVersion::CompiledDataBlob) return false; // Fallback to tagged properties
+
+	// Blob goes as one memcpy, loading it makes single allocation regardless of states count
+
+	Blob.BulkSerialize(Ar);
+
+	Ar << Names;
+	Ar << Contexts;
+	Ar << Objects;
+	Ar << EventClasses;
+
+	if (Ar.CustomVer(FInputSequenceCustomVersion::GUID) >= FInputSequenceCustomVersion::CompilerVersionAndSourceHash)
+	{
+		Ar << CompiledWithVersion;
+		Ar << SourceHash;
+	}
+
+	if (Ar.CustomVer(FInputSequenceCustomVersion::GUID) >= FInputSequenceCustomVersion::NameInputActions)
+	{
+		Ar << InputActions;
+	}
+
+	if (Ar.IsLoading() && Blob.Num() > 0 && !ValidateBlob())
+	{
+		UE_LOG(LogInputSequence, Warning, TEXT("Compiled Input Sequence data of %s is outdated or corrupted and is discarded"), *Ar.GetArchiveName());
+		Reset();
+	}
+
+	return true;
+}
+
+void FInputSequenceCompiledData::Reset()
+{
+	Blob.Empty();
+	Names.Empty();
+	Contexts.Empty();
+	Objects.Empty();
+	EventClasses.Empty();
+	InputActions.Empty();
+
+	CompiledWithVersion = 0;
+	SourceHash = FIoHash::Zero;
+}
+
+bool FInputSequenceCompiledData::ValidateBlob() const
+{
+	if (InputActions.Num() > 0 && InputActions.Num() != Names.Num()) return false;
+
+	return GetView().Validate(Names.Num(), Objects.Num(), Contexts.Num(), EventClasses.Num());
+}
+
+#if WITH_EDITOR
+
+bool FInputSequenceCompiledData::Build(const TArray<FInputSequenceState>& states)
+{
+	Reset();
+
+	if (states.Num() >= FInputSequenceCompactState::IndexNone)
+	{
+		UE_LOG(LogInputSequence, Error, TEXT("Input Sequence has %d states, compiled format supports up to %d"), states.Num(), FInputSequenceCompactState::IndexNone - 1);
+		return false;
+	}
+
+	TArray<FInputSequenceCompactState> compactStates;
+	TArray<FInputSequenceCompactAction> compactActions;
+	TArray<FInputSequenceCompactEventList> eventLists;
+	TArray<uint16> indices;
+	TArray<FInputSequenceCompactRegion> compactRegions;
+
+	TMap<FName, uint16> nameMapping;
+	TMap<FString, uint16> contextMapping;
+	TMap<UObject*, uint16> objectMapping;
+	TMap<UClass*, uint16> eventClassMapping;
+
+	// Event list 0 and context 0 are shared by all states without events and context
+
+	eventLists.Add({ 0, 0 });
+	contextMapping.Add(FString(), (uint16)Contexts.Add(FString()));
+
+	auto addName = [&](const FName& name)
+	{
+		if (const uint16* index = nameMapping.Find(name)) return *index;
+		return nameMapping.Add(name, (uint16)Names.Add(name));
+	};
+
+	auto addContext = [&](const FString& context)
+	{
+		if (const uint16* index = contextMapping.Find(context)) return *index;
+		return contextMapping.Add(context, (uint16)Contexts.Add(context));
+	};
+
+	auto addObject = [&](UObject* object)
+	{
+		if (!object) return FInputSequenceCompactState::IndexNone;
+		if (const uint16* index = objectMapping.Find(object)) return *index;
+		return objectMapping.Add(object, (uint16)Objects.Add(object));
+	};
+
+	auto addEventList = [&](const TArray<TSubclassOf<UInputSequenceEvent>>& eventClasses)
+	{
+		if (eventClasses.Num() == 0) return (uint16)0;
+
+		TArray<uint16, TInlineAllocator<8>> eventIndices;
+
+		for (const TSubclassOf<UInputSequenceEvent>& eventClass : eventClasses)
+		{
+			const uint16* index = eventClassMapping.Find(eventClass.Get());
+			eventIndices.Add(index ? *index : eventClassMapping.Add(eventClass.Get(), (uint16)EventClasses.Add(eventClass)));
+		}
+
+		for (int32 eventListIndex = 1; eventListIndex < eventLists.Num(); eventListIndex++)
+		{
+			const FInputSequenceCompactEventList& eventList = eventLists[eventListIndex];
+
+			if (eventList.NumEvents == eventIndices.Num() && FMemory::Memcmp(&indices[eventList.FirstEvent], eventIndices.GetData(), eventIndices.Num() * sizeof(uint16)) == 0)
+			{
+				return (uint16)eventListIndex;
+			}
+		}
+
+		eventLists.Add({ (uint32)indices.Num(), (uint32)eventIndices.Num() });
+		indices.Append(eventIndices);
+
+		return (uint16)(eventLists.Num() - 1);
+	};
+
+	for (const FInputSequenceState& state : states)
+	{
+		FInputSequenceCompactState& compactState = compactStates.AddZeroed_GetRef();
+
+		compactState.TimeParam = state.TimeParam;
+		compactState.FirstLayerParentIndex = state.FirstLayerParentIndex == INDEX_NONE ? FInputSequenceCompactState::IndexNone : (uint16)state.FirstLayerParentIndex;
+		compactState.DepthIndex = (uint16)FMath::Clamp(state.DepthIndex, 0, (int32)MAX_uint16);
+
+		if (state.IsInputNode) compactState.Flags |= EInputSequenceStateFlags::InputNode;
+		if (state.IsAxisNode) compactState.Flags |= EInputSequenceStateFlags::AxisNode;
+		if (state.IsGestureNode) compactState.Flags |= EInputSequenceStateFlags::GestureNode;
+		if (state.canBePassedAfterTime) compactState.Flags |= EInputSequenceStateFlags::CanBePassedAfterTime;
+		if (state.isOverridingResetAfterTime) compactState.Flags |= EInputSequenceStateFlags::OverridingResetAfterTime;
+		if (state.isResetAfterTime) compactState.Flags |= EInputSequenceStateFlags::ResetAfterTime;
+		if (state.isOverridingRequirePreciseMatch) compactState.Flags |= EInputSequenceStateFlags::OverridingRequirePreciseMatch;
+		if (state.requirePreciseMatch) compactState.Flags |= EInputSequenceStateFlags::RequirePreciseMatch;
+
+		compactState.EnterEventList = addEventList(state.EnterEventClasses);
+		compactState.PassEventList = addEventList(state.PassEventClasses);
+		compactState.ResetEventList = addEventList(state.ResetEventClasses);
+
+		compactState.StateObjectIndex = addObject(state.StateObject);
+		compactState.StateContextIndex = addContext(state.StateContext);
+
+		if (state.InputActions.Num() > MAX_uint8 || state.PressedActions.Num() > MAX_uint8)
+		{
+			UE_LOG(LogInputSequence, Error, TEXT("Input Sequence state has %d actions and %d pressed actions, compiled format supports up to %d"), state.InputActions.Num(), state.PressedActions.Num(), MAX_uint8);
+			Reset();
+			return false;
+		}
+
+		compactState.FirstAction = compactActions.Num();
+		compactState.NumActions = state.InputActions.Num();
+
+		for (const TPair<FName, FInputActionState>& inputActionEntry : state.InputActions)
+		{
+			const FInputActionState& inputActionState = inputActionEntry.Value;
+
+			FInputSequenceCompactAction& compactAction = compactActions.AddZeroed_GetRef();
+			compactAction.X = inputActionState.GetX();
+			compactAction.Y = inputActionState.GetY();
+			compactAction.Z = inputActionState.GetZ();
+			compactAction.NameIndex = addName(inputActionEntry.Key);
+			compactAction.SubNameAIndex = addName(inputActionState.GetSubNameA());
+			compactAction.SubNameBIndex = addName(inputActionState.GetSubNameB());
+
+			if (inputActionState.IsRegionAxis())
+			{
+				compactAction.RegionShape = (InputSequenceCore::ERegionShape)inputActionState.GetRegion().Shape;
+				compactAction.RegionIndex = (uint16)compactRegions.Add(inputActionState.GetRegion().ToCompact());
+				compactAction.NumRegions = 1;
+			}
+			else if (inputActionState.IsGesture())
+			{
+				const TArray<FInputSequenceAxisRegion>& gestureSteps = inputActionState.GetGestureSteps();
+
+				if (gestureSteps.Num() > MAX_uint8)
+				{
+					UE_LOG(LogInputSequence, Error, TEXT("Input Sequence gesture has %d steps, compiled format supports up to %d"), gestureSteps.Num(), MAX_uint8);
+					Reset();
+					return false;
+				}
+
+				// Steps of one path are consecutive regions, all of the same shape
+
+				compactAction.RegionShape = (InputSequenceCore::ERegionShape)gestureSteps[0].Shape;
+				compactAction.RegionIndex = (uint16)compactRegions.Num();
+				compactAction.NumRegions = (uint8)gestureSteps.Num();
+
+				for (const FInputSequenceAxisRegion& gestureStep : gestureSteps) compactRegions.Add(gestureStep.ToCompact());
+			}
+
+			const TArray<TEnumAsByte<EInputEvent>>& inputEvents = inputActionState.GetInputEvents();
+			check(inputEvents.Num() <= UE_ARRAY_COUNT(compactAction.InputEvents));
+
+			compactAction.NumInputEvents = inputEvents.Num();
+			for (int32 eventIndex = 0; eventIndex < inputEvents.Num(); eventIndex++) compactAction.InputEvents[eventIndex] = (uint8)inputEvents[eventIndex].GetValue();
+		}
+
+		compactState.FirstNext = indices.Num();
+		compactState.NumNext = state.NextIndice.Num();
+		for (int32 nextIndex : state.NextIndice) indices.Add((uint16)nextIndex);
+
+		compactState.FirstPressed = indices.Num();
+		compactState.NumPressed = state.PressedActions.Num();
+		for (const FName& pressedAction : state.PressedActions) indices.Add(addName(pressedAction));
+
+		// Pools are referred to by 16 bit indices and IndexNone is reserved, so indices taken past the limit above are already truncated
+
+		const TPair<const TCHAR*, int32> pools[] =
+		{
+			{ TEXT("names"), Names.Num() },
+			{ TEXT("contexts"), Contexts.Num() },
+			{ TEXT("objects"), Objects.Num() },
+			{ TEXT("event classes"), EventClasses.Num() },
+			{ TEXT("event lists"), eventLists.Num() },
+			{ TEXT("regions"), compactRegions.Num() },
+		};
+
+		for (const TPair<const TCHAR*, int32>& pool : pools)
+		{
+			if (pool.Value > FInputSequenceCompactState::IndexNone)
+			{
+				UE_LOG(LogInputSequence, Error, TEXT("Input Sequence has %d %s, compiled format supports up to %d"), pool.Value, pool.Key, FInputSequenceCompactState::IndexNone);
+				Reset();
+				return false;
+			}
+		}
+	}
+
+	FInputSequenceCompiledHeader header;
+	header.Magic = Magic;
+	header.Version = BlobVersion;
+	header.NumNames = Names.Num();
+
+	uint32 offset = sizeof(FInputSequenceCompiledHeader);
+
+	header.NumStates = compactStates.Num();
+	header.StatesOffset = offset = Align(offset, alignof(FInputSequenceCompactState));
+	offset += compactStates.Num() * sizeof(FInputSequenceCompactState);
+
+	header.NumActions = compactActions.Num();
+	header.ActionsOffset = offset = Align(offset, alignof(FInputSequenceCompactAction));
+	offset += compactActions.Num() * sizeof(FInputSequenceCompactAction);
+
+	header.NumEventLists = eventLists.Num();
+	header.EventListsOffset = offset = Align(offset, alignof(FInputSequenceCompactEventList));
+	offset += eventLists.Num() * sizeof(FInputSequenceCompactEventList);
+
+	header.NumIndices = indices.Num();
+	header.IndicesOffset = offset = Align(offset, alignof(uint16));
+	offset += indices.Num() * sizeof(uint16);
+
+	header.NumRegions = compactRegions.Num();
+	header.RegionsOffset = offset = Align(offset, alignof(FInputSequenceCompactRegion));
+	offset += compactRegions.Num() * sizeof(FInputSequenceCompactRegion);
+
+	Blob.SetNumZeroed(offset);
+
+	FMemory::Memcpy(Blob.GetData(), &header, sizeof(FInputSequenceCompiledHeader));
+	FMemory::Memcpy(Blob.GetData() + header.StatesOffset, compactStates.GetData(), compactStates.Num() * sizeof(FInputSequenceCompactState));
+	FMemory::Memcpy(Blob.GetData() + header.ActionsOffset, compactActions.GetData(), compactActions.Num() * sizeof(FInputSequenceCompactAction));
+	FMemory::Memcpy(Blob.GetData() + header.EventListsOffset, eventLists.GetData(), eventLists.Num() * sizeof(FInputSequenceCompactEventList));
+	FMemory::Memcpy(Blob.GetData() + header.IndicesOffset, indices.GetData(), indices.Num() * sizeof(uint16));
+	FMemory::Memcpy(Blob.GetData() + header.RegionsOffset, compactRegions.GetData(), compactRegions.Num() * sizeof(FInputSequenceCompactRegion));
+
+	for (const FInputSequenceState& state : states)
+	{
+		for (const TPair<FName, TObjectPtr<UObject>>& inputActionEntry : state.InputActionObjects)
+		{
+			const uint16* nameIndex = nameMapping.Find(inputActionEntry.Key);
+
+			if (nameIndex && inputActionEntry.Value)
+			{
+				InputActions.SetNum(Names.Num());
+				InputActions[*nameIndex] = inputActionEntry.Value;
+			}
+		}
+	}
+
+	CompiledWithVersion = CompilerVersion;
+	SourceHash = HashSource(states);
+
+	Names.Shrink();
+	Contexts.Shrink();
+	Objects.Shrink();
+	EventClasses.Shrink();
+	InputActions.Shrink();
+
+	return true;
+}
+
+FIoHash FInputSequenceCompiledData::HashSource(const TArray<FInputSequenceState>& states)
+{
+	FBlake3 hasher;
+
+	auto hashValue = [&hasher](const auto& value) { hasher.Update(&value, sizeof(value)); };
+
+	auto hashString = [&hasher, &hashValue](const FString& string)
+	{
+		hashValue(string.Len());
+		hasher.Update(*string, string.Len() * sizeof(TCHAR));
+	};
+
+	auto hashObject = [&hashString](const UObject* object) { hashString(object ? object->GetPathName() : FString()); };
+
+	auto hashEventClasses = [&hashValue, &hashObject](const TArray<TSubclassOf<UInputSequenceEvent>>& eventClasses)
+	{
+		hashValue(eventClasses.Num());
+		for (const TSubclassOf<UInputSequenceEvent>& eventClass : eventClasses) hashObject(eventClass.Get());
+	};
+
+	auto hashRegion = [&hashValue](const FInputSequenceAxisRegion& region)
+	{
+		hashValue(region.Shape);
+		hashValue(region.NumDimensions);
+		hashValue(region.A);
+		hashValue(region.B);
+	};
+
+	hashValue(CompilerVersion);
+	hashValue(BlobVersion);
+	hashValue(states.Num());
+
+	for (const FInputSequenceState& state : states)
+	{
+		hashValue(state.InputActions.Num());
+
+		for (const TPair<FName, FInputActionState>& inputActionEntry : state.InputActions)
+		{
+			const FInputActionState& inputActionState = inputActionEntry.Value;
+
+			hashString(inputActionEntry.Key.ToString());
+			hashString(inputActionState.GetSubNameA().ToString());
+			hashString(inputActionState.GetSubNameB().ToString());
+
+			hashValue(inputActionState.GetX());
+			hashValue(inputActionState.GetY());
+			hashValue(inputActionState.GetZ());
+
+			hashValue(inputActionState.IsRegionAxis());
+
+			if (inputActionState.IsRegionAxis()) hashRegion(inputActionState.GetRegion());
+
+			hashValue(inputActionState.GetGestureSteps().Num());
+			for (const FInputSequenceAxisRegion& gestureStep : inputActionState.GetGestureSteps()) hashRegion(gestureStep);
+
+			hashValue(inputActionState.GetInputEvents().Num());
+			for (const TEnumAsByte<EInputEvent>& inputEvent : inputActionState.GetInputEvents()) hashValue(inputEvent.GetValue());
+		}
+
+		hashValue(state.PressedActions.Num());
+		for (const FName& pressedAction : state.PressedActions) hashString(pressedAction.ToString());
+
+		hashValue(state.NextIndice.Num());
+		for (int32 nextIndex : state.NextIndice) hashValue(nextIndex);
+
+		hashEventClasses(state.EnterEventClasses);
+		hashEventClasses(state.PassEventClasses);
+		hashEventClasses(state.ResetEventClasses);
+
+		hashObject(state.StateObject);
+
+		hashValue(state.InputActionObjects.Num());
+
+		for (const TPair<FName, TObjectPtr<UObject>>& inputActionEntry : state.InputActionObjects)
+		{
+			hashString(inputActionEntry.Key.ToString());
+			hashObject(inputActionEntry.Value);
+		}
+		hashString(state.StateContext);
+
+		hashValue(state.DepthIndex);
+		hashValue(state.FirstLayerParentIndex);
+		hashValue(state.TimeParam);
+
+		const uint8 flags[] = { state.IsInputNode, state.IsAxisNode, state.IsGestureNode, state.canBePassedAfterTime, state.isOverridingResetAfterTime, state.isResetAfterTime, state.isOverridingRequirePreciseMatch, state.requirePreciseMatch };
+		hashValue(flags);
+	}
+
+	return FIoHash(hasher.Finalize());
+}
+
+#endif
\ No newline at end of file
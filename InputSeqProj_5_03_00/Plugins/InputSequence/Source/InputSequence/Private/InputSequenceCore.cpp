@@ -0,0 +1,1363 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if INPUTSEQUENCE_CORE_WITH_UE
+#include "InputSequenceTrace.h"
+#define INPUTSEQUENCE_CORE_SCOPE(Name) INPUTSEQUENCE_SCOPE_CYCLE_COUNTER(STAT_InputSequence_##Name)
+#endif
+
+#ifndef INPUTSEQUENCE_CORE_SCOPE
+#define INPUTSEQUENCE_CORE_SCOPE(Name)
+#endif
+
+namespace InputSequenceCore
+{
+	namespace
+	{
+		constexpr float Pi = 3.14159265358979323846f;
+
+		constexpr uint8_t NoInputEvent = 0xFF;
+
+		template<typename T>
+		bool AddUnique(std::vector<T>& values, T value)
+		{
+			if (std::find(values.begin(), values.end(), value) != values.end()) return false;
+
+			values.push_back(value);
+			return true;
+		}
+
+		template<typename T>
+		bool Contains(const std::vector<T>& values, T value) { return std::find(values.begin(), values.end(), value) != values.end(); }
+
+		int32_t FindAxisZone(const float* bounds, uint32_t numBounds, float value)
+		{
+			for (uint32_t i = 0; i < numBounds; i++)
+			{
+				if (value < bounds[i]) return 2 * i;
+				if (value == bounds[i]) return 2 * i + 1;
+			}
+
+			return 2 * numBounds;
+		}
+
+		void GetAxisZoneLimits(const float* bounds, uint32_t numBounds, int32_t zone, float& outMin, float& outMax)
+		{
+			const uint32_t i = zone / 2;
+
+			if (zone % 2 == 1)
+			{
+				outMin = outMax = bounds[i];
+			}
+			else
+			{
+				outMin = i > 0 ? bounds[i - 1] : -std::numeric_limits<float>::infinity();
+				outMax = i < numBounds ? bounds[i] : std::numeric_limits<float>::infinity();
+			}
+		}
+
+		/* Value inside of zone that every compiled range treats the same way as any other value of that zone */
+		float GetAxisZoneValue(const float* bounds, uint32_t numBounds, int32_t zone)
+		{
+			const uint32_t i = zone / 2;
+
+			if (zone % 2 == 1) return bounds[i];
+			if (i == 0) return bounds[0] - 1;
+			if (i == numBounds) return bounds[numBounds - 1] + 1;
+
+			return (bounds[i - 1] + bounds[i]) / 2;
+		}
+
+		/*
+		* Sorted bounds of 1D ranges per compiled name. Names used by 2D sectors or regions get no bounds, as they do not split into per-component zones.
+		* outNumComponents is number of axis components that graph reads per name, zero for names that are not used by axes
+		*/
+		void CollectAxisBounds(const FGraphView& graph, std::vector<uint32_t>& outOffsets, std::vector<float>& outBounds, std::vector<uint8_t>& outNumComponents)
+		{
+			const int32_t numNames = graph.NumNames();
+
+			std::vector<std::vector<float>> nameBounds(numNames);
+			std::vector<uint8_t> isUnfiltered(numNames, 0);
+
+			outNumComponents.assign(numNames, 0);
+
+			for (int32_t stateIndex = 0; stateIndex < graph.NumStates(); stateIndex++)
+			{
+				const FCompactState& state = graph.GetState(stateIndex);
+
+				if (!state.IsAxisNode()) continue;
+
+				const FCompactAction* actions = graph.GetActions(state);
+
+				for (int32_t actionIndex = 0; actionIndex < state.NumActions; actionIndex++)
+				{
+					const FCompactAction& action = actions[actionIndex];
+
+					if (action.Is2DAxis())
+					{
+						isUnfiltered[action.SubNameAIndex] = 1;
+						isUnfiltered[action.SubNameBIndex] = 1;
+
+						outNumComponents[action.SubNameAIndex] = std::max<uint8_t>(outNumComponents[action.SubNameAIndex], 1);
+						outNumComponents[action.SubNameBIndex] = std::max<uint8_t>(outNumComponents[action.SubNameBIndex], 1);
+					}
+					else if (action.IsRegionAxis())
+					{
+						isUnfiltered[action.NameIndex] = 1;
+
+						outNumComponents[action.NameIndex] = 3;
+					}
+					else
+					{
+						nameBounds[action.NameIndex].push_back(action.X);
+						nameBounds[action.NameIndex].push_back(action.Y);
+
+						outNumComponents[action.NameIndex] = std::max<uint8_t>(outNumComponents[action.NameIndex], 1);
+					}
+				}
+			}
+
+			outOffsets.assign(numNames + 1, 0);
+			outBounds.clear();
+
+			for (int32_t nameId = 0; nameId < numNames; nameId++)
+			{
+				outOffsets[nameId] = (uint32_t)outBounds.size();
+
+				if (isUnfiltered[nameId]) continue;
+
+				std::vector<float>& bounds = nameBounds[nameId];
+				std::sort(bounds.begin(), bounds.end());
+				bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+				outBounds.insert(outBounds.end(), bounds.begin(), bounds.end());
+			}
+
+			outOffsets[numNames] = (uint32_t)outBounds.size();
+		}
+
+		/* Number of bits for values in [0, numValues) */
+		uint32_t GetNumBits(uint32_t numValues)
+		{
+			uint32_t numBits = 0;
+			while (numBits < 32 && (1ull << numBits) < numValues) numBits++;
+
+			return numBits;
+		}
+
+		/* Fixed point of 2D and 3D axis components in stream, covers [-4, 4] */
+		constexpr float StreamComponentScale = 8192;
+
+		constexpr uint32_t StreamComponentBits = 16;
+
+		/* Delta time in stream is counted in 0.1 ms */
+		constexpr float StreamDeltaTimeScale = 10000;
+
+		constexpr uint32_t StreamDeltaTimeBits = 16;
+
+		template<typename T>
+		void Remove(std::vector<T>& values, T value)
+		{
+			typename std::vector<T>::iterator it = std::find(values.begin(), values.end(), value);
+			if (it != values.end()) values.erase(it);
+		}
+	}
+
+	bool FCompactAction::ConsumeInput_Action(uint8_t& progress, uint8_t inputEvent) const
+	{
+		if (progress < NumInputEvents && InputEvents[progress] == inputEvent) { progress++; return true; }
+		return false;
+	}
+
+	bool FCompactAction::ConsumeInput_Axis(uint8_t& progress, float axisValue) const
+	{
+		if (X <= axisValue && axisValue <= Y) { if (progress < 0xFF) progress++; return true; }
+		return false;
+	}
+
+	bool FCompactAction::ConsumeInput_2DAxis(uint8_t& progress, float axisValueA, float axisValueB) const
+	{
+		if (axisValueA * axisValueA + axisValueB * axisValueB <= Z * Z) return false;
+
+		float axisAngleRad = std::atan(axisValueB / axisValueA);
+		if (axisValueA < 0) axisAngleRad += Pi;
+
+		while (axisAngleRad < X) axisAngleRad += 2 * Pi;
+
+		if (X <= axisAngleRad && axisAngleRad <= Y) { if (progress < 0xFF) progress++; return true; }
+
+		return false;
+	}
+
+	bool FCompactAction::ConsumeInput_Region(uint8_t& progress, const FCompactRegion& region, float axisValueX, float axisValueY, float axisValueZ) const
+	{
+		if (region.Contains(RegionShape, axisValueX, axisValueY, axisValueZ)) { if (progress < 0xFF) progress++; return true; }
+		return false;
+	}
+
+	bool FCompactRegion::Contains(ERegionShape shape, float x, float y, float z) const
+	{
+		switch (shape)
+		{
+		case ERegionShape::Box:
+			return A[0] <= x && x <= B[0] && A[1] <= y && y <= B[1] && A[2] <= z && z <= B[2];
+
+		case ERegionShape::Sphere:
+		{
+			const float dx = x - A[0];
+			const float dy = y - A[1];
+			const float dz = z - A[2];
+
+			return dx * dx + dy * dy + dz * dz <= A[3] * A[3];
+		}
+
+		case ERegionShape::Cone:
+		{
+			const float lengthSquared = x * x + y * y + z * z;
+
+			if (lengthSquared < B[0] * B[0] || lengthSquared > B[1] * B[1]) return false;
+
+			return x * A[0] + y * A[1] + z * A[2] >= A[3] * std::sqrt(lengthSquared);
+		}
+
+		default:
+			return false;
+		}
+	}
+
+
+
+	bool FGraphView::Validate(size_t numNames, size_t numObjects, size_t numContexts, size_t numEventClasses) const
+	{
+		if (!IsValid()) return false;
+
+		const FCompiledHeader& header = GetHeader();
+		const uint64_t blobSize = Size;
+
+		auto isSectionValid = [blobSize](uint32_t offset, uint32_t num, uint32_t elementSize, uint32_t alignment)
+		{
+			return offset % alignment == 0 && (uint64_t)offset + (uint64_t)num * elementSize <= blobSize;
+		};
+
+		if (!isSectionValid(header.StatesOffset, header.NumStates, sizeof(FCompactState), alignof(FCompactState))) return false;
+		if (!isSectionValid(header.ActionsOffset, header.NumActions, sizeof(FCompactAction), alignof(FCompactAction))) return false;
+		if (!isSectionValid(header.EventListsOffset, header.NumEventLists, sizeof(FCompactEventList), alignof(FCompactEventList))) return false;
+		if (!isSectionValid(header.IndicesOffset, header.NumIndices, sizeof(uint16_t), alignof(uint16_t))) return false;
+		if (!isSectionValid(header.RegionsOffset, header.NumRegions, sizeof(FCompactRegion), alignof(FCompactRegion))) return false;
+
+		if (header.NumNames != numNames || header.NumEventLists == 0 || numContexts == 0) return false;
+
+		const FCompactEventList* eventLists = GetSection<FCompactEventList>(header.EventListsOffset);
+		const uint16_t* indices = GetSection<uint16_t>(header.IndicesOffset);
+
+		for (uint32_t eventListIndex = 0; eventListIndex < header.NumEventLists; eventListIndex++)
+		{
+			const FCompactEventList& eventList = eventLists[eventListIndex];
+
+			if ((uint64_t)eventList.FirstEvent + eventList.NumEvents > header.NumIndices) return false;
+
+			for (uint32_t i = 0; i < eventList.NumEvents; i++)
+			{
+				if (indices[eventList.FirstEvent + i] >= numEventClasses) return false;
+			}
+		}
+
+		const FCompactAction* actions = GetSection<FCompactAction>(header.ActionsOffset);
+
+		for (uint32_t actionIndex = 0; actionIndex < header.NumActions; actionIndex++)
+		{
+			const FCompactAction& action = actions[actionIndex];
+
+			if (action.NameIndex >= numNames || action.SubNameAIndex >= numNames || action.SubNameBIndex >= numNames) return false;
+			if (action.NumInputEvents > sizeof(action.InputEvents)) return false;
+			if (action.RegionShape > ERegionShape::Cone) return false;
+			if (action.IsRegionAxis() && (action.NumRegions == 0 || (uint32_t)action.RegionIndex + action.NumRegions > header.NumRegions)) return false;
+		}
+
+		const FCompactState* states = GetSection<FCompactState>(header.StatesOffset);
+
+		for (uint32_t stateIndex = 0; stateIndex < header.NumStates; stateIndex++)
+		{
+			const FCompactState& state = states[stateIndex];
+
+			if ((uint64_t)state.FirstAction + state.NumActions > header.NumActions) return false;
+			if ((uint64_t)state.FirstNext + state.NumNext > header.NumIndices) return false;
+			if ((uint64_t)state.FirstPressed + state.NumPressed > header.NumIndices) return false;
+
+			for (uint16_t nextIndex : GetNextIndice(state)) if (nextIndex >= header.NumStates) return false;
+			for (uint16_t pressedIndex : GetPressedActions(state)) if (pressedIndex >= numNames) return false;
+
+			if (!state.IsStartNode() && state.FirstLayerParentIndex >= header.NumStates) return false;
+
+			if (state.EnterEventList >= header.NumEventLists || state.PassEventList >= header.NumEventLists || state.ResetEventList >= header.NumEventLists) return false;
+
+			if (state.StateObjectIndex != FCompactState::IndexNone && state.StateObjectIndex >= numObjects) return false;
+			if (state.StateContextIndex >= numContexts) return false;
+		}
+
+		return true;
+	}
+
+	TSpan<uint16_t> FGraphView::GetEventList(uint16_t eventListIndex) const
+	{
+		const FCompactEventList& eventList = GetSection<FCompactEventList>(GetHeader().EventListsOffset)[eventListIndex];
+		return { GetSection<uint16_t>(GetHeader().IndicesOffset) + eventList.FirstEvent, eventList.NumEvents };
+	}
+
+
+
+	void FInstance::Reset(const FGraphView& graph)
+	{
+		StateTimes.assign(graph.NumStates(), 0);
+		ActionProgress.assign(graph.NumActions(), 0);
+		GestureTimes.assign(graph.NumActions(), 0);
+
+		ActiveStates.clear();
+		IsActiveFlags.assign(graph.NumStates(), 0);
+
+		FrameActionEvents.assign(graph.NumNames(), NoInputEvent);
+		FrameAxisValues.assign(graph.NumNames(), 0);
+		FrameAxisValuesY.assign(graph.NumNames(), 0);
+		FrameAxisValuesZ.assign(graph.NumNames(), 0);
+		HasFrameAxisValues.assign(graph.NumNames(), 0);
+
+		AxisHeldValues.assign(graph.NumNames(), 0);
+		HasAxisHeldValues.assign(graph.NumNames(), 0);
+
+		BuildAxisZones(graph);
+	}
+
+	void FInstance::OnInput(const FGraphView& graph, const FSettings& settings, float deltaTime, bool bGamePaused, const FActionInput* actionInputs, size_t numActionInputs, const FAxisInput* axisInputs, size_t numAxisInputs, std::vector<FEventCall>& outEventCalls, std::vector<FResetSource>& outResetSources)
+	{
+		FrameStats = FFrameStats();
+
+		if (DebugRing) DebugRing->BeginFrame();
+
+		PassedStates.clear();
+
+		for (size_t i = 0; i < numActionInputs; i++)
+		{
+			const FActionInput& actionInput = actionInputs[i];
+
+			if (actionInput.Event == EInputEvent::Released && IsPressed(actionInput.NameId))
+			{
+				IsPressedFlags[actionInput.NameId] = 0;
+				Remove(PressedActions, actionInput.NameId);
+			}
+
+			if (actionInput.Event == EInputEvent::Pressed && !IsPressed(actionInput.NameId))
+			{
+				if (actionInput.NameId >= IsPressedFlags.size()) IsPressedFlags.resize(actionInput.NameId + 1, 0);
+
+				IsPressedFlags[actionInput.NameId] = 1;
+				PressedActions.push_back(actionInput.NameId);
+			}
+		}
+
+		if (graph.NumStates() == 0) return;
+
+		if (StateTimes.size() != (size_t)graph.NumStates() || ActionProgress.size() != (size_t)graph.NumActions() || FrameActionEvents.size() != (size_t)graph.NumNames()) Reset(graph);
+
+		if (bIsAxisFilterActive != settings.bFilterAxisInput)
+		{
+			bIsAxisFilterActive = settings.bFilterAxisInput;
+			ClearAxisZones();
+		}
+
+		AxisHysteresis = settings.AxisHysteresis;
+
+		FrameDeltaTime = deltaTime;
+
+		SetFrameInput(actionInputs, numActionInputs, axisInputs, numAxisInputs, true);
+
+		const size_t inputActionEventsNum = numActionInputs;
+		const size_t pressedActionsNum = PressedActions.size();
+
+		if (ActiveStates.empty()) MakeTransition(graph, 0, graph.GetNextIndice(graph.GetState(0)), outEventCalls);
+
+		PrevActiveStates = ActiveStates;
+
+		if (!bGamePaused || settings.bStepFromStatesWhenGamePaused)
+		{
+			INPUTSEQUENCE_CORE_SCOPE(Matching);
+
+			for (uint16_t activeIndex : PrevActiveStates)
+			{
+				const FCompactState& state = graph.GetState(activeIndex);
+
+				if (!state.IsInputNode())
+				{
+					RequestResetWithNode(activeIndex, state);
+				}
+				else
+				{
+					bool match = true;
+
+					const bool stateRequirePreciseMatch = state.HasFlag(EStateFlags::OverridingRequirePreciseMatch) ? state.HasFlag(EStateFlags::RequirePreciseMatch) : settings.bRequirePreciseMatch;
+
+					if ((inputActionEventsNum + pressedActionsNum) > 0)
+					{
+						// Match with Pressed Actions for all
+
+						for (uint32_t pressedAction : PressedActions)
+						{
+							if (!HasPressedAction(graph, state, pressedAction))
+							{
+								if (state.IsAxisNode())
+								{
+									match = false;
+									RequestResetWithNode(activeIndex, state);
+
+									break;
+								}
+								else if (stateRequirePreciseMatch)
+								{
+									if (!HasInputAction(graph, state, pressedAction))
+									{
+										match = false;
+										RequestResetWithNode(activeIndex, state);
+
+										break;
+									}
+								}
+							}
+						}
+
+						// Match with Input Action Events only for Input Actions
+
+						if (match && !state.IsAxisNode())
+						{
+							if (stateRequirePreciseMatch)
+							{
+								for (size_t i = 0; i < numActionInputs; i++)
+								{
+									if (!HasInputAction(graph, state, actionInputs[i].NameId))
+									{
+										match = false;
+										RequestResetWithNode(activeIndex, state);
+
+										break;
+									}
+								}
+							}
+						}
+					}
+
+					// Match with must-Pressed Actions for all
+
+					if (match)
+					{
+						for (uint16_t pressedActionIndex : graph.GetPressedActions(state))
+						{
+							if (!IsPressed(pressedActionIndex))
+							{
+								match = false;
+								RequestResetWithNode(activeIndex, state);
+
+								break;
+							}
+						}
+					}
+
+					// Process if match
+
+					if (match && !IsStateOpen(graph, state))
+					{
+						if (state.HasFlag(EStateFlags::CanBePassedAfterTime))
+						{
+							float accumulatedTime = StateTimes[activeIndex];
+
+							if (ConsumeInput(graph, activeIndex, state))
+							{
+								match = IsStateOpen(graph, state);
+
+								if (accumulatedTime < state.TimeParam)
+								{
+									match = false;
+									RequestResetWithNode(activeIndex, state);
+								}
+							}
+						}
+						else
+						{
+							match = ConsumeInput(graph, activeIndex, state) && IsStateOpen(graph, state);
+						}
+					}
+
+					if (match) MakeTransition(graph, activeIndex, graph.GetNextIndice(state), outEventCalls);
+				}
+			}
+		}
+
+		if (!bGamePaused || settings.bTickStatesWhenGamePaused)
+		{
+			for (uint16_t activeIndex : PrevActiveStates)
+			{
+				if (IsActive(activeIndex)) // Tick on states that already were active before this frame
+				{
+					const FCompactState& state = graph.GetState(activeIndex);
+
+					if (!state.IsInputNode()) continue;
+
+					StateTimes[activeIndex] += deltaTime;
+
+					if (state.HasFlag(EStateFlags::CanBePassedAfterTime)) continue; // States that can be passed only after time are not reset by time at all
+
+					const bool isOverridingResetAfterTime = state.HasFlag(EStateFlags::OverridingResetAfterTime);
+
+					if (isOverridingResetAfterTime ? state.HasFlag(EStateFlags::ResetAfterTime) : settings.bIsResetAfterTime)
+					{
+						if (StateTimes[activeIndex] > (isOverridingResetAfterTime ? state.TimeParam : settings.ResetAfterTime))
+						{
+							RequestResetWithNode(activeIndex, state);
+						}
+					}
+				}
+			}
+		}
+
+		SetFrameInput(actionInputs, numActionInputs, axisInputs, numAxisInputs, false);
+
+		ProcessResetSources(graph, outEventCalls, outResetSources);
+	}
+
+	void FInstance::RequestReset(uint32_t externalId)
+	{
+		FResetSource resetSource;
+		resetSource.ExternalId = externalId;
+
+		ResetSources.push_back(resetSource);
+	}
+
+	void FInstance::ClearPressedActions()
+	{
+		PressedActions.clear();
+		std::fill(IsPressedFlags.begin(), IsPressedFlags.end(), (uint8_t)0);
+	}
+
+	size_t FInstance::GetAllocatedSize() const
+	{
+		return StateTimes.capacity() * sizeof(float) + ActionProgress.capacity() + GestureTimes.capacity() * sizeof(float) + ActiveStates.capacity() * sizeof(uint16_t) + IsActiveFlags.capacity()
+			+ PressedActions.capacity() * sizeof(uint32_t) + IsPressedFlags.capacity() + ResetSources.capacity() * sizeof(FResetSource) + PassedStates.capacity() * sizeof(uint16_t)
+			+ FrameActionEvents.capacity() + (FrameAxisValues.capacity() + FrameAxisValuesY.capacity() + FrameAxisValuesZ.capacity()) * sizeof(float) + HasFrameAxisValues.capacity()
+			+ AxisHeldValues.capacity() * sizeof(float) + HasAxisHeldValues.capacity()
+			+ AxisBoundaryOffsets.capacity() * sizeof(uint32_t) + AxisBoundaries.capacity() * sizeof(float) + AxisZones.capacity() * sizeof(int32_t)
+			+ PrevActiveStates.capacity() * sizeof(uint16_t) + (NodeSources.capacity() + ResetFLParents.capacity() + CheckFLParents.capacity()) * sizeof(int32_t) + TransitionIndice.capacity() * sizeof(uint16_t);
+	}
+
+	void FDebugRing::Write(uint16_t stateIndex, EStateEvent stateEvent)
+	{
+		const uint64_t index = ReservedIndex.load(std::memory_order_relaxed);
+
+		// Reservation must be visible to reader before slot contents change
+		ReservedIndex.store(index + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		const uint64_t packed = (uint64_t)Frame.load(std::memory_order_relaxed) | (uint64_t)stateIndex << 32 | (uint64_t)stateEvent << 48;
+		Records[index & (Capacity - 1)].store(packed, std::memory_order_relaxed);
+
+		CommittedIndex.store(index + 1, std::memory_order_release);
+	}
+
+	uint64_t FDebugRing::Read(uint64_t& readIndex, std::vector<FDebugRecord>& outRecords) const
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity of debug ring must be power of two");
+
+		const uint64_t endIndex = CommittedIndex.load(std::memory_order_acquire);
+
+		const uint64_t firstIndex = endIndex > Capacity ? std::max(readIndex, endIndex - Capacity) : readIndex;
+
+		const size_t firstRecord = outRecords.size();
+
+		for (uint64_t i = firstIndex; i < endIndex; i++)
+		{
+			const uint64_t packed = Records[i & (Capacity - 1)].load(std::memory_order_relaxed);
+			outRecords.push_back({ (uint32_t)packed, (uint16_t)(packed >> 32), (EStateEvent)(uint8_t)(packed >> 48) });
+		}
+
+		// Slots reserved again while they were copied may hold newer records, those are dropped
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t reservedIndex = ReservedIndex.load(std::memory_order_relaxed);
+
+		const uint64_t validIndex = std::min(endIndex, reservedIndex > Capacity ? std::max(firstIndex, reservedIndex - Capacity) : firstIndex);
+
+		outRecords.erase(outRecords.begin() + firstRecord, outRecords.begin() + firstRecord + (validIndex - firstIndex));
+
+		const uint64_t numLost = readIndex < validIndex ? validIndex - readIndex : 0;
+
+		readIndex = std::max(readIndex, endIndex);
+
+		return numLost;
+	}
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+
+	FHitCounters::FHitCounters(size_t numStates)
+		: NumStates(numStates)
+		, Counters(new std::atomic<uint64_t>[numStates * NumEvents])
+	{
+		Reset();
+	}
+
+	uint64_t FHitCounters::Get(size_t stateIndex, EStateEvent stateEvent) const
+	{
+		return stateIndex < NumStates ? Counters[stateIndex * NumEvents + (size_t)stateEvent].load(std::memory_order_relaxed) : 0;
+	}
+
+	void FHitCounters::Append(size_t stateIndex, EStateEvent stateEvent, uint64_t count)
+	{
+		if (stateIndex < NumStates) Counters[stateIndex * NumEvents + (size_t)stateEvent].fetch_add(count, std::memory_order_relaxed);
+	}
+
+	void FHitCounters::Reset()
+	{
+		for (size_t i = 0; i < NumStates * NumEvents; i++) Counters[i].store(0, std::memory_order_relaxed);
+	}
+
+#endif
+
+	void FInstance::SetFrameInput(const FActionInput* actionInputs, size_t numActionInputs, const FAxisInput* axisInputs, size_t numAxisInputs, bool bSet)
+	{
+		// Input of frame is spread over per-name slots, so matching does no lookups. Only touched slots are cleared afterwards
+
+		const size_t numNames = FrameActionEvents.size();
+
+		for (size_t i = 0; i < numActionInputs; i++)
+		{
+			if (actionInputs[i].NameId < numNames) FrameActionEvents[actionInputs[i].NameId] = bSet ? (uint8_t)actionInputs[i].Event : NoInputEvent;
+		}
+
+		for (size_t i = 0; i < numAxisInputs; i++)
+		{
+			if (axisInputs[i].NameId < numNames && bIsAxisFilterActive && IsFilteredAxis(axisInputs[i].NameId))
+			{
+				if (bSet && UpdateAxisZone(axisInputs[i].NameId, axisInputs[i].Value)) FrameStats.AxisZoneChanges++;
+
+				// Held value outlives the frame, only frame input is cleared
+
+				if (!bSet)
+				{
+					FrameAxisValues[axisInputs[i].NameId] = 0;
+					HasFrameAxisValues[axisInputs[i].NameId] = 0;
+				}
+			}
+			else if (axisInputs[i].NameId < numNames)
+			{
+				FrameAxisValues[axisInputs[i].NameId] = bSet ? axisInputs[i].Value : 0;
+				FrameAxisValuesY[axisInputs[i].NameId] = bSet ? axisInputs[i].ValueY : 0;
+				FrameAxisValuesZ[axisInputs[i].NameId] = bSet ? axisInputs[i].ValueZ : 0;
+				HasFrameAxisValues[axisInputs[i].NameId] = bSet ? 1 : 0;
+			}
+		}
+	}
+
+	void FInstance::BuildAxisZones(const FGraphView& graph)
+	{
+		// Sectors and regions do not split into per-component zones, such axes are applied as they come
+
+		std::vector<uint8_t> numComponents;
+		CollectAxisBounds(graph, AxisBoundaryOffsets, AxisBoundaries, numComponents);
+
+		AxisZones.assign(graph.NumNames(), -1);
+	}
+
+	void FInstance::ClearAxisZones()
+	{
+		for (size_t nameId = 0; nameId < AxisZones.size(); nameId++)
+		{
+			if (IsFilteredAxis((uint32_t)nameId))
+			{
+				AxisZones[nameId] = -1;
+				AxisHeldValues[nameId] = 0;
+				HasAxisHeldValues[nameId] = 0;
+			}
+		}
+	}
+
+	bool FInstance::UpdateAxisZone(uint32_t nameId, float axisValue)
+	{
+		const float* bounds = AxisBoundaries.data() + AxisBoundaryOffsets[nameId];
+		const uint32_t numBounds = AxisBoundaryOffsets[nameId + 1] - AxisBoundaryOffsets[nameId];
+
+		const int32_t zone = FindAxisZone(bounds, numBounds, axisValue);
+
+		if (zone == AxisZones[nameId]) return false;
+
+		if (AxisZones[nameId] >= 0 && AxisHysteresis > 0)
+		{
+			float zoneMin;
+			float zoneMax;
+			GetAxisZoneLimits(bounds, numBounds, AxisZones[nameId], zoneMin, zoneMax);
+
+			if (zoneMin - AxisHysteresis <= axisValue && axisValue <= zoneMax + AxisHysteresis) return false;
+		}
+
+		AxisZones[nameId] = zone;
+
+		AxisHeldValues[nameId] = GetAxisZoneValue(bounds, numBounds, zone);
+		HasAxisHeldValues[nameId] = 1;
+
+		FrameAxisValues[nameId] = AxisHeldValues[nameId];
+		HasFrameAxisValues[nameId] = 1;
+
+		return true;
+	}
+
+	void FInstance::AddActive(int32_t stateIndex)
+	{
+		IsActiveFlags[stateIndex] = 1;
+		ActiveStates.push_back((uint16_t)stateIndex);
+	}
+
+	void FInstance::RemoveActive(int32_t stateIndex)
+	{
+		if (IsActive(stateIndex))
+		{
+			IsActiveFlags[stateIndex] = 0;
+			Remove(ActiveStates, (uint16_t)stateIndex);
+		}
+	}
+
+	void FInstance::ResetState(int32_t stateIndex, const FCompactState& state)
+	{
+		StateTimes[stateIndex] = 0;
+		std::memset(ActionProgress.data() + state.FirstAction, 0, state.NumActions);
+		std::fill(GestureTimes.begin() + state.FirstAction, GestureTimes.begin() + state.FirstAction + state.NumActions, 0.f);
+	}
+
+	bool FInstance::IsStateOpen(const FGraphView& graph, const FCompactState& state) const
+	{
+		const FCompactAction* actions = graph.GetActions(state);
+		const uint8_t* progress = ActionProgress.data() + state.FirstAction;
+
+		for (int32_t actionIndex = 0; actionIndex < state.NumActions; actionIndex++)
+		{
+			if (state.IsGestureNode())
+			{
+				if (!actions[actionIndex].IsOpen_Gesture(progress[actionIndex])) return false;
+			}
+			else if ((state.IsAxisNode() && !actions[actionIndex].IsOpen_Axis(progress[actionIndex])) || !actions[actionIndex].IsOpen_Action(progress[actionIndex])) return false;
+		}
+
+		return true;
+	}
+
+	bool FInstance::HasInputAction(const FGraphView& graph, const FCompactState& state, uint32_t nameId) const
+	{
+		const FCompactAction* actions = graph.GetActions(state);
+
+		for (int32_t actionIndex = 0; actionIndex < state.NumActions; actionIndex++)
+		{
+			if (actions[actionIndex].NameIndex == nameId) return true;
+		}
+
+		return false;
+	}
+
+	bool FInstance::HasPressedAction(const FGraphView& graph, const FCompactState& state, uint32_t nameId) const
+	{
+		for (uint16_t pressedActionIndex : graph.GetPressedActions(state))
+		{
+			if (pressedActionIndex == nameId) return true;
+		}
+
+		return false;
+	}
+
+	bool FInstance::ConsumeInput(const FGraphView& graph, int32_t stateIndex, const FCompactState& state)
+	{
+		bool result = false;
+
+		const FCompactAction* actions = graph.GetActions(state);
+		uint8_t* progress = ActionProgress.data() + state.FirstAction;
+
+		for (int32_t actionIndex = 0; actionIndex < state.NumActions; actionIndex++)
+		{
+			const FCompactAction& action = actions[actionIndex];
+			uint8_t& actionProgress = progress[actionIndex];
+
+			if (state.IsGestureNode())
+			{
+				if (!action.IsOpen_Gesture(actionProgress))
+				{
+					result |= ConsumeInput_Gesture(graph, state.FirstAction + actionIndex, action, actionProgress);
+				}
+			}
+			else if (state.IsAxisNode())
+			{
+				if (action.IsRegionAxis())
+				{
+					if (HasFrameAxisValues[action.NameIndex])
+					{
+						result |= action.ConsumeInput_Region(actionProgress, graph.GetRegion(action.RegionIndex), FrameAxisValues[action.NameIndex], FrameAxisValuesY[action.NameIndex], FrameAxisValuesZ[action.NameIndex]);
+					}
+				}
+				else if (action.Is2DAxis())
+				{
+					if (HasFrameAxisValues[action.SubNameAIndex] && HasFrameAxisValues[action.SubNameBIndex])
+					{
+						result |= action.ConsumeInput_2DAxis(actionProgress, FrameAxisValues[action.SubNameAIndex], FrameAxisValues[action.SubNameBIndex]);
+					}
+				}
+				else if (!action.IsOpen_Axis(actionProgress))
+				{
+					// Range is a condition on current value of axis, filtered axis keeps it between zone changes
+
+					if (bIsAxisFilterActive && IsFilteredAxis(action.NameIndex))
+					{
+						if (HasAxisHeldValues[action.NameIndex])
+						{
+							result |= action.ConsumeInput_Axis(actionProgress, AxisHeldValues[action.NameIndex]);
+						}
+					}
+					else if (HasFrameAxisValues[action.NameIndex])
+					{
+						result |= action.ConsumeInput_Axis(actionProgress, FrameAxisValues[action.NameIndex]);
+					}
+				}
+			}
+			else
+			{
+				if (!action.IsOpen_Action(actionProgress))
+				{
+					if (FrameActionEvents[action.NameIndex] != NoInputEvent)
+					{
+						result |= action.ConsumeInput_Action(actionProgress, FrameActionEvents[action.NameIndex]);
+					}
+				}
+
+				if (!action.IsOpen_Action(actionProgress) && IsPressed(action.NameIndex))
+				{
+					result |= action.ConsumeInput_Action(actionProgress, (uint8_t)EInputEvent::Pressed);
+				}
+			}
+		}
+
+		if (result) StateTimes[stateIndex] = 0;
+
+		return result;
+	}
+
+	bool FInstance::ConsumeInput_Gesture(const FGraphView& graph, uint32_t actionIndex, const FCompactAction& action, uint8_t& progress)
+	{
+		float& gestureTime = GestureTimes[actionIndex];
+
+		if (progress > 0)
+		{
+			gestureTime += FrameDeltaTime;
+
+			if (gestureTime > action.X) progress = 0; // Path took too long, current sample may start it again
+		}
+
+		float x;
+		float y;
+
+		if (action.Is2DAxis())
+		{
+			if (!HasFrameAxisValues[action.SubNameAIndex] || !HasFrameAxisValues[action.SubNameBIndex]) return false;
+
+			x = FrameAxisValues[action.SubNameAIndex];
+			y = FrameAxisValues[action.SubNameBIndex];
+		}
+		else
+		{
+			if (!HasFrameAxisValues[action.NameIndex]) return false;
+
+			x = FrameAxisValues[action.NameIndex];
+			y = FrameAxisValuesY[action.NameIndex];
+		}
+
+		const FCompactRegion* steps = &graph.GetRegion(action.RegionIndex);
+
+		if (steps[progress].Contains(action.RegionShape, x, y, 0))
+		{
+			if (progress == 0) gestureTime = 0;
+
+			progress++;
+			return true;
+		}
+
+		if (progress > 0 && !steps[progress - 1].Contains(action.RegionShape, x, y, 0))
+		{
+			// Samples inside of dead zone or of step already reached keep path, any other direction breaks it
+
+			const float minLength = steps[progress - 1].B[0];
+
+			if (x * x + y * y >= minLength * minLength)
+			{
+				progress = 0;
+
+				if (steps[0].Contains(action.RegionShape, x, y, 0))
+				{
+					gestureTime = 0;
+
+					progress++;
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void FInstance::AddEventCalls(const FGraphView& graph, uint16_t eventListIndex, int32_t stateIndex, std::vector<FEventCall>& outEventCalls)
+	{
+		for (uint16_t eventClassIndex : graph.GetEventList(eventListIndex))
+		{
+			outEventCalls.push_back({ (uint16_t)stateIndex, eventClassIndex });
+
+			FrameStats.EventCalls++;
+		}
+	}
+
+	void FInstance::MakeTransition(const FGraphView& graph, int32_t fromIndex, TSpan<uint16_t> nextIndice, std::vector<FEventCall>& outEventCalls)
+	{
+		INPUTSEQUENCE_CORE_SCOPE(MakeTransition);
+
+		FrameStats.Transitions++;
+
+		if (nextIndice.Num() > 0)
+		{
+			for (uint16_t nextIndex : nextIndice) EnterNode(graph, nextIndex, outEventCalls);
+		}
+		else // Make Transition to First Layer Parent if nextIndice is empty
+		{
+			const FCompactState& state = graph.GetState(fromIndex);
+			EnterNode(graph, state.GetFirstLayerParentIndex(), outEventCalls);
+		}
+
+		PassNode(graph, fromIndex, outEventCalls);
+	}
+
+	void FInstance::RequestResetWithNode(int32_t nodeIndex, const FCompactState& state)
+	{
+		if (state.IsFirstLayer())
+		{
+			ResetState(nodeIndex, state);
+
+			FrameStats.Resets++;
+			NotifyStateEvent(nodeIndex, EStateEvent::Reset);
+		}
+		else
+		{
+			FResetSource resetSource;
+			resetSource.SourceIndex = nodeIndex;
+
+			ResetSources.push_back(resetSource);
+
+			RemoveActive(nodeIndex);
+		}
+	}
+
+	void FInstance::EnterNode(const FGraphView& graph, int32_t nodeIndex, std::vector<FEventCall>& outEventCalls)
+	{
+		if (graph.IsValidStateIndex(nodeIndex) && !IsActive(nodeIndex))
+		{
+			const FCompactState& state = graph.GetState(nodeIndex);
+
+			AddEventCalls(graph, state.EnterEventList, nodeIndex, outEventCalls);
+
+			NotifyStateEvent(nodeIndex, EStateEvent::Enter);
+
+			ResetState(nodeIndex, state);
+			AddActive(nodeIndex);
+
+			// Jump through empty Input nodes
+
+			if (state.IsInputNode() && state.IsEmpty()) MakeTransition(graph, nodeIndex, graph.GetNextIndice(state), outEventCalls);
+		}
+	}
+
+	void FInstance::PassNode(const FGraphView& graph, int32_t nodeIndex, std::vector<FEventCall>& outEventCalls)
+	{
+		if (graph.IsValidStateIndex(nodeIndex) && IsActive(nodeIndex))
+		{
+			const FCompactState& state = graph.GetState(nodeIndex);
+
+			AddEventCalls(graph, state.PassEventList, nodeIndex, outEventCalls);
+
+			NotifyStateEvent(nodeIndex, EStateEvent::Pass);
+
+			PassedStates.push_back((uint16_t)nodeIndex);
+
+			RemoveActive(nodeIndex);
+		}
+	}
+
+	void FInstance::ProcessResetSources(const FGraphView& graph, std::vector<FEventCall>& outEventCalls, std::vector<FResetSource>& outResetSources)
+	{
+		INPUTSEQUENCE_CORE_SCOPE(ProcessResetSources);
+
+		bool bResetAll = false;
+
+		NodeSources.clear();
+		ResetFLParents.clear();
+		CheckFLParents.clear();
+
+		outResetSources = ResetSources;
+
+		for (const FResetSource& resetSource : ResetSources)
+		{
+			bResetAll |= resetSource.SourceIndex == -1;
+
+			if (graph.IsValidStateIndex(resetSource.SourceIndex))
+			{
+				AddUnique(NodeSources, resetSource.SourceIndex);
+
+				const FCompactState& state = graph.GetState(resetSource.SourceIndex);
+
+				if (!state.IsInputNode()) // GoToStartNode is reseting all Active nodes that have the same FirstLayerParentIndex
+				{
+					AddUnique(ResetFLParents, state.GetFirstLayerParentIndex());
+				}
+				else
+				{
+					AddUnique(CheckFLParents, state.GetFirstLayerParentIndex());
+				}
+			}
+		}
+
+		ResetSources.clear();
+
+		for (int32_t nodeIndex : NodeSources)
+		{
+			const FCompactState& state = graph.GetState(nodeIndex);
+
+			AddEventCalls(graph, state.ResetEventList, nodeIndex, outEventCalls);
+
+			FrameStats.Resets++;
+			NotifyStateEvent(nodeIndex, EStateEvent::Reset);
+		}
+
+		if (bResetAll)
+		{
+			for (uint16_t activeIndex : ActiveStates)
+			{
+				const FCompactState& state = graph.GetState(activeIndex);
+
+				AddEventCalls(graph, state.ResetEventList, activeIndex, outEventCalls);
+
+				FrameStats.Resets++;
+				NotifyStateEvent(activeIndex, EStateEvent::Reset);
+
+				IsActiveFlags[activeIndex] = 0;
+			}
+
+			ActiveStates.clear();
+		}
+		else
+		{
+			for (size_t i = 0; i < ActiveStates.size();)
+			{
+				const uint16_t activeIndex = ActiveStates[i];
+
+				const FCompactState& state = graph.GetState(activeIndex);
+				const int32_t firstLayerParentIndex = state.GetFirstLayerParentIndex();
+
+				if (Contains(ResetFLParents, firstLayerParentIndex))
+				{
+					AddEventCalls(graph, state.ResetEventList, activeIndex, outEventCalls);
+
+					FrameStats.Resets++;
+					NotifyStateEvent(activeIndex, EStateEvent::Reset);
+
+					IsActiveFlags[activeIndex] = 0;
+					ActiveStates.erase(ActiveStates.begin() + i);
+
+					Remove(CheckFLParents, firstLayerParentIndex);
+
+					continue;
+				}
+				else
+				{
+					Remove(CheckFLParents, firstLayerParentIndex);
+				}
+
+				i++;
+			}
+
+			if (!ResetFLParents.empty())
+			{
+				TransitionIndice.clear();
+				for (int32_t resetFLParent : ResetFLParents) TransitionIndice.push_back((uint16_t)resetFLParent);
+				MakeTransition(graph, 0, { TransitionIndice.data(), TransitionIndice.size() }, outEventCalls);
+			}
+
+			if (!CheckFLParents.empty())
+			{
+				TransitionIndice.clear();
+				for (int32_t checkFLParent : CheckFLParents) TransitionIndice.push_back((uint16_t)checkFLParent);
+				MakeTransition(graph, 0, { TransitionIndice.data(), TransitionIndice.size() }, outEventCalls);
+			}
+		}
+	}
+
+	void FBitWriter::Write(uint32_t value, uint32_t numBits)
+	{
+		for (uint32_t bit = 0; bit < numBits; bit++, NumBits++)
+		{
+			if (NumBits % 8 == 0) Data.push_back(0);
+
+			if (value & (1u << bit)) Data.back() |= (uint8_t)(1u << (NumBits % 8));
+		}
+	}
+
+	bool FBitReader::Read(uint32_t& outValue, uint32_t numBits)
+	{
+		outValue = 0;
+
+		if (bIsError || Offset + numBits > NumBits)
+		{
+			bIsError = true;
+			return false;
+		}
+
+		for (uint32_t bit = 0; bit < numBits; bit++, Offset++)
+		{
+			if (Data[Offset / 8] & (1u << (Offset % 8))) outValue |= 1u << bit;
+		}
+
+		return true;
+	}
+
+	void FInputStreamCodec::Reset(const FGraphView& graph)
+	{
+		NumNames = (uint32_t)graph.NumNames();
+
+		// Names graph does not know are all written as one id past its names, that's enough for precise match to fail on them
+
+		NameBits = GetNumBits(NumNames + 1);
+
+		std::vector<uint8_t> numComponents;
+		CollectAxisBounds(graph, AxisBoundaryOffsets, AxisBoundaries, numComponents);
+
+		Axes.clear();
+		AxisSlots.assign(NumNames, -1);
+
+		for (uint32_t nameId = 0; nameId < NumNames; nameId++)
+		{
+			if (numComponents[nameId] == 0) continue;
+
+			FStreamAxis streamAxis;
+			streamAxis.NameId = nameId;
+			streamAxis.FirstBound = AxisBoundaryOffsets[nameId];
+			streamAxis.NumBounds = AxisBoundaryOffsets[nameId + 1] - AxisBoundaryOffsets[nameId];
+			streamAxis.NumComponents = streamAxis.NumBounds > 0 ? 0 : numComponents[nameId];
+			streamAxis.LastCodes[0] = streamAxis.LastCodes[1] = streamAxis.LastCodes[2] = -1;
+
+			AxisSlots[nameId] = (int32_t)Axes.size();
+			Axes.push_back(streamAxis);
+		}
+	}
+
+	void FInputStreamCodec::Write(const FGraphView& graph, const FActionInput* actionInputs, size_t numActionInputs, const FAxisInput* axisInputs, size_t numAxisInputs, FBitWriter& writer, std::vector<FActionInput>& outActionInputs, std::vector<FAxisInput>& outAxisInputs)
+	{
+		if (NumNames != (uint32_t)graph.NumNames() || AxisSlots.size() != NumNames) Reset(graph);
+
+		outActionInputs.clear();
+		outAxisInputs.clear();
+
+		for (size_t i = 0; i < numActionInputs; i++)
+		{
+			// Event is written in 2 bits, events past them (e.g. Axis) are not action events and are dropped, so both sides skip them
+
+			if ((uint8_t)actionInputs[i].Event > (uint8_t)EInputEvent::DoubleClick) continue;
+
+			const FActionInput actionInput = { std::min(actionInputs[i].NameId, NumNames), actionInputs[i].Event };
+
+			writer.Write(1, 1);
+			writer.Write(actionInput.NameId, NameBits);
+			writer.Write((uint8_t)actionInput.Event, 2);
+
+			outActionInputs.push_back(actionInput);
+		}
+
+		writer.Write(0, 1);
+
+		// Only last value of each axis in frame matters to evaluator
+
+		FrameAxisInputs.assign(Axes.size(), -1);
+
+		for (size_t i = 0; i < numAxisInputs; i++)
+		{
+			if (axisInputs[i].NameId < NumNames && AxisSlots[axisInputs[i].NameId] >= 0) FrameAxisInputs[AxisSlots[axisInputs[i].NameId]] = (int32_t)i;
+		}
+
+		for (size_t axisIndex = 0; axisIndex < Axes.size(); axisIndex++)
+		{
+			FStreamAxis& streamAxis = Axes[axisIndex];
+
+			writer.Write(FrameAxisInputs[axisIndex] >= 0 ? 1 : 0, 1);
+
+			if (FrameAxisInputs[axisIndex] < 0) continue;
+
+			const FAxisInput& axisInput = axisInputs[FrameAxisInputs[axisIndex]];
+
+			int32_t codes[3] = { 0, 0, 0 };
+
+			if (streamAxis.NumComponents == 0)
+			{
+				codes[0] = FindAxisZone(AxisBoundaries.data() + streamAxis.FirstBound, streamAxis.NumBounds, axisInput.Value);
+			}
+			else
+			{
+				const float values[3] = { axisInput.Value, axisInput.ValueY, axisInput.ValueZ };
+
+				for (uint32_t component = 0; component < streamAxis.NumComponents; component++)
+				{
+					const float scaled = std::round(std::min(std::max(values[component], -4.f), 4.f) * StreamComponentScale);
+					codes[component] = (int32_t)(uint16_t)(int16_t)std::min(std::max(scaled, -32768.f), 32767.f);
+				}
+			}
+
+			const uint32_t numCodes = streamAxis.NumComponents == 0 ? 1 : streamAxis.NumComponents;
+			const bool bIsChanged = !std::equal(codes, codes + numCodes, streamAxis.LastCodes);
+
+			writer.Write(bIsChanged ? 1 : 0, 1);
+
+			if (bIsChanged)
+			{
+				for (uint32_t i = 0; i < numCodes; i++)
+				{
+					writer.Write((uint32_t)codes[i], streamAxis.NumComponents == 0 ? GetNumBits(2 * streamAxis.NumBounds + 1) : StreamComponentBits);
+					streamAxis.LastCodes[i] = codes[i];
+				}
+			}
+
+			ApplyCodes(streamAxis, streamAxis.LastCodes, outAxisInputs);
+		}
+	}
+
+	bool FInputStreamCodec::Read(const FGraphView& graph, FBitReader& reader, std::vector<FActionInput>& outActionInputs, std::vector<FAxisInput>& outAxisInputs)
+	{
+		if (NumNames != (uint32_t)graph.NumNames() || AxisSlots.size() != NumNames) Reset(graph);
+
+		outActionInputs.clear();
+		outAxisInputs.clear();
+
+		uint32_t hasAction;
+
+		while (reader.Read(hasAction, 1) && hasAction)
+		{
+			uint32_t nameId;
+			uint32_t inputEvent;
+
+			if (!reader.Read(nameId, NameBits) || !reader.Read(inputEvent, 2) || nameId > NumNames) return false;
+
+			outActionInputs.push_back({ nameId, (EInputEvent)inputEvent });
+		}
+
+		for (FStreamAxis& streamAxis : Axes)
+		{
+			uint32_t isFed;
+			if (!reader.Read(isFed, 1)) return false;
+
+			if (!isFed) continue;
+
+			uint32_t isChanged;
+			if (!reader.Read(isChanged, 1)) return false;
+
+			const uint32_t numCodes = streamAxis.NumComponents == 0 ? 1 : streamAxis.NumComponents;
+
+			if (isChanged)
+			{
+				for (uint32_t i = 0; i < numCodes; i++)
+				{
+					uint32_t code;
+					if (!reader.Read(code, streamAxis.NumComponents == 0 ? GetNumBits(2 * streamAxis.NumBounds + 1) : StreamComponentBits)) return false;
+
+					if (streamAxis.NumComponents == 0 && code > 2 * streamAxis.NumBounds) return false;
+
+					streamAxis.LastCodes[i] = (int32_t)code;
+				}
+			}
+			else if (streamAxis.LastCodes[0] < 0)
+			{
+				return false; // Unchanged value that was never written, frames came out of order
+			}
+
+			ApplyCodes(streamAxis, streamAxis.LastCodes, outAxisInputs);
+		}
+
+		return !reader.IsError();
+	}
+
+	void FInputStreamCodec::WritePassedStates(const FGraphView& graph, const uint16_t* stateIndice, size_t numStateIndice, FBitWriter& writer) const
+	{
+		const uint32_t stateBits = GetNumBits((uint32_t)graph.NumStates());
+
+		for (size_t i = 0; i < numStateIndice; i++)
+		{
+			writer.Write(1, 1);
+			writer.Write(stateIndice[i], stateBits);
+		}
+
+		writer.Write(0, 1);
+	}
+
+	bool FInputStreamCodec::ReadPassedStates(const FGraphView& graph, FBitReader& reader, std::vector<uint16_t>& outStateIndice) const
+	{
+		const uint32_t stateBits = GetNumBits((uint32_t)graph.NumStates());
+
+		outStateIndice.clear();
+
+		uint32_t hasState;
+
+		while (reader.Read(hasState, 1) && hasState)
+		{
+			uint32_t stateIndex;
+			if (!reader.Read(stateIndex, stateBits) || !graph.IsValidStateIndex((int32_t)stateIndex)) return false;
+
+			outStateIndice.push_back((uint16_t)stateIndex);
+		}
+
+		return !reader.IsError();
+	}
+
+	void FInputStreamCodec::WriteDeltaTime(FBitWriter& writer, float& inOutDeltaTime)
+	{
+		const uint32_t code = (uint32_t)std::min(std::max(std::round(inOutDeltaTime * StreamDeltaTimeScale), 0.f), (float)((1u << StreamDeltaTimeBits) - 1));
+
+		writer.Write(code, StreamDeltaTimeBits);
+
+		inOutDeltaTime = code / StreamDeltaTimeScale;
+	}
+
+	bool FInputStreamCodec::ReadDeltaTime(FBitReader& reader, float& outDeltaTime)
+	{
+		uint32_t code;
+		if (!reader.Read(code, StreamDeltaTimeBits)) return false;
+
+		outDeltaTime = code / StreamDeltaTimeScale;
+		return true;
+	}
+
+	void FInputStreamCodec::ApplyCodes(const FStreamAxis& streamAxis, const int32_t* codes, std::vector<FAxisInput>& outAxisInputs) const
+	{
+		FAxisInput axisInput;
+		axisInput.NameId = streamAxis.NameId;
+
+		if (streamAxis.NumComponents == 0)
+		{
+			axisInput.Value = GetAxisZoneValue(AxisBoundaries.data() + streamAxis.FirstBound, streamAxis.NumBounds, codes[0]);
+		}
+		else
+		{
+			float* values[3] = { &axisInput.Value, &axisInput.ValueY, &axisInput.ValueZ };
+
+			for (uint32_t component = 0; component < streamAxis.NumComponents; component++)
+			{
+				*values[component] = (int16_t)(uint16_t)codes[component] / StreamComponentScale;
+			}
+		}
+
+		outAxisInputs.push_back(axisInput);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceEventReplicationComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+namespace
+{
+	/* Frame offsets past this are clamped, receivers only use them to order and space records within batch */
+	constexpr uint32 FrameOffsetBits = 5;
+
+	uint32 GetNumBits(uint32 numValues)
+	{
+		return numValues > 1 ? FMath::CeilLogTwo(numValues) : 0;
+	}
+}
+
+UInputSequenceEventReplicationComponent::UInputSequenceEventReplicationComponent(const FObjectInitializer& objInit) :Super(objInit)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bTickEvenWhenPaused = true;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+	SetIsReplicatedByDefault(true);
+
+	bExecuteEvents = true;
+
+	LastFlushTime = 0;
+}
+
+void UInputSequenceEventReplicationComponent::ReplicateInstance(int32 assetIndex, UInputSequenceAsset* instance)
+{
+	if (!instance || !InputSequenceAssets.IsValidIndex(assetIndex)) return;
+
+	StopReplicatingInstance(instance);
+
+	FReplicatedInstance& replicatedInstance = ReplicatedInstances.AddDefaulted_GetRef();
+	replicatedInstance.Instance = instance;
+	replicatedInstance.Handle = instance->OnNativeStateEvent().AddUObject(this, &UInputSequenceEventReplicationComponent::OnInstanceStateEvent, assetIndex);
+}
+
+void UInputSequenceEventReplicationComponent::StopReplicatingInstance(UInputSequenceAsset* instance)
+{
+	for (int32 i = ReplicatedInstances.Num() - 1; i >= 0; i--)
+	{
+		if (ReplicatedInstances[i].Instance == instance)
+		{
+			if (instance) instance->OnNativeStateEvent().Remove(ReplicatedInstances[i].Handle);
+
+			ReplicatedInstances.RemoveAtSwap(i);
+		}
+	}
+}
+
+void UInputSequenceEventReplicationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (const FReplicatedInstance& replicatedInstance : ReplicatedInstances)
+	{
+		if (UInputSequenceAsset* instance = replicatedInstance.Instance.Get()) instance->OnNativeStateEvent().Remove(replicatedInstance.Handle);
+	}
+
+	ReplicatedInstances.Empty();
+	Records.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInputSequenceEventReplicationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (Records.Num() == 0) return;
+
+	// One batch per net update of owner, so bandwidth follows number of events and not frame rate
+
+	const AActor* owner = GetOwner();
+	const double currentTime = GetWorld()->GetRealTimeSeconds();
+
+	if (owner && owner->NetUpdateFrequency > 0 && currentTime - LastFlushTime < 1.0 / owner->NetUpdateFrequency) return;
+
+	LastFlushTime = currentTime;
+
+	FlushRecords();
+}
+
+void UInputSequenceEventReplicationComponent::OnInstanceStateEvent(UInputSequenceAsset* instance, uint16 stateIndex, InputSequenceCore::EStateEvent stateEvent, int32 assetIndex)
+{
+	if (stateEvent == InputSequenceCore::EStateEvent::Reset) return;
+
+	FRecord& record = Records.AddDefaulted_GetRef();
+	record.AssetIndex = assetIndex;
+	record.StateIndex = stateIndex;
+	record.Kind = stateEvent == InputSequenceCore::EStateEvent::Enter ? EInputSequenceReplicatedEvent::Enter : EInputSequenceReplicatedEvent::Pass;
+	record.Frame = GFrameCounter;
+}
+
+void UInputSequenceEventReplicationComponent::FlushRecords()
+{
+	BatchWriter.Reset();
+
+	const uint32 assetBits = GetNumBits(InputSequenceAssets.Num());
+	const uint64 firstFrame = Records[0].Frame;
+
+	for (const FRecord& record : Records)
+	{
+		const int32 numStates = InputSequenceAssets[record.AssetIndex] ? InputSequenceAssets[record.AssetIndex]->GetCompiledData().NumStates() : 0;
+
+		if (record.StateIndex >= numStates) continue;
+
+		BatchWriter.Write(1, 1);
+		BatchWriter.Write(record.AssetIndex, assetBits);
+		BatchWriter.Write(record.StateIndex, GetNumBits(numStates));
+		BatchWriter.Write((uint32)record.Kind, 1);
+		BatchWriter.Write((uint32)FMath::Min<uint64>(record.Frame - firstFrame, (1 << FrameOffsetBits) - 1), FrameOffsetBits);
+	}
+
+	BatchWriter.Write(0, 1);
+
+	Records.Reset();
+
+	MulticastStateEvents(TArray<uint8>(BatchWriter.GetData().data(), (int32)BatchWriter.GetData().size()));
+}
+
+void UInputSequenceEventReplicationComponent::MulticastStateEvents_Implementation(const TArray<uint8>& batchData)
+{
+	// Server and owning client evaluate sequences on their own
+
+	if (GetOwnerRole() != ROLE_SimulatedProxy) return;
+
+	InputSequenceCore::FBitReader reader(batchData.GetData(), batchData.Num());
+
+	const uint32 assetBits = GetNumBits(InputSequenceAssets.Num());
+
+	uint32 hasRecord;
+
+	while (reader.Read(hasRecord, 1) && hasRecord)
+	{
+		uint32 assetIndex;
+		if (!reader.Read(assetIndex, assetBits) || !InputSequenceAssets.IsValidIndex(assetIndex) || !InputSequenceAssets[assetIndex]) return;
+
+		UInputSequenceAsset* asset = InputSequenceAssets[assetIndex];
+		const FInputSequenceCompiledData& compiledData = asset->GetCompiledData();
+
+		uint32 stateIndex;
+		uint32 kind;
+		uint32 frameOffset;
+		if (!reader.Read(stateIndex, GetNumBits(compiledData.NumStates())) || !reader.Read(kind, 1) || !reader.Read(frameOffset, FrameOffsetBits)) return;
+
+		if (!compiledData.IsValidStateIndex(stateIndex)) return;
+
+		const FInputSequenceCompactState& state = compiledData.GetState(stateIndex);
+		const EInputSequenceReplicatedEvent stateEvent = (EInputSequenceReplicatedEvent)kind;
+
+		if (bExecuteEvents)
+		{
+			EventCalls.Reset();
+
+			for (uint16 eventClassIndex : compiledData.GetEventList(stateEvent == EInputSequenceReplicatedEvent::Enter ? state.EnterEventList : state.PassEventList))
+			{
+				FInputSequenceEventCall& eventCall = EventCalls.AddDefaulted_GetRef();
+				eventCall.EventClass = compiledData.GetEventClass(eventClassIndex);
+				eventCall.Index = stateIndex;
+				eventCall.Object = compiledData.GetObject(state.StateObjectIndex);
+				eventCall.Context = compiledData.GetContext(state.StateContextIndex);
+			}
+
+			for (const FInputSequenceEventCall& eventCall : EventCalls)
+			{
+				UInputSequenceEvent::OnExecuteByClass(eventCall.EventClass, eventCall.Index, GetOwner(), CallingContext, eventCall.Object, eventCall.Context, TArray<FInputSequenceResetSource>());
+			}
+		}
+
+		OnReplicatedStateEvent.Broadcast(asset, stateIndex, stateEvent, frameOffset);
+	}
+}
\ No newline at end of file
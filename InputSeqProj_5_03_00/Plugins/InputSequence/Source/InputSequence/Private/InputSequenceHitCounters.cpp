@@ -0,0 +1,235 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceHitCounters.h"
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+
+#include "InputSequence.h"
+#include "InputSequenceAsset.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectIterator.h"
+
+namespace InputSequenceHitCounters
+{
+	constexpr uint32 Magic = 0x54485349; // "ISHT"
+
+	constexpr uint32 Version = 1;
+}
+
+FInputSequenceHitCounters& FInputSequenceHitCounters::Get()
+{
+	static FInputSequenceHitCounters hitCounters;
+	return hitCounters;
+}
+
+void FInputSequenceHitCounters::Start()
+{
+	if (bIsStarted) return;
+
+	bIsStarted = true;
+
+	for (TObjectIterator<UInputSequenceAsset> It; It; ++It)
+	{
+		if (!It->HasAnyFlags(RF_ClassDefaultObject)) It->UpdateHitCounters();
+	}
+}
+
+void FInputSequenceHitCounters::Stop()
+{
+	if (!bIsStarted) return;
+
+	bIsStarted = false;
+
+	for (TObjectIterator<UInputSequenceAsset> It; It; ++It)
+	{
+		if (!It->HasAnyFlags(RF_ClassDefaultObject)) It->UpdateHitCounters();
+	}
+}
+
+void FInputSequenceHitCounters::Reset()
+{
+	FScopeLock lock(&EntriesCS);
+
+	for (TPair<FIoHash, FEntry>& entry : Entries)
+	{
+		entry.Value.Counters->Reset();
+		entry.Value.SavedCounts.Reset();
+		entry.Value.ResetGeneration++;
+	}
+}
+
+InputSequenceCore::FHitCounters* FInputSequenceHitCounters::FindOrAdd(const FInputSequenceCompiledData& compiledData, const FString& assetName)
+{
+	FScopeLock lock(&EntriesCS);
+
+	FEntry& entry = Entries.FindOrAdd(compiledData.GetSourceHash());
+
+	if (!entry.Counters.IsValid())
+	{
+		entry.AssetName = assetName;
+		entry.Counters = MakeUnique<InputSequenceCore::FHitCounters>(compiledData.NumStates());
+	}
+
+	return entry.Counters.Get();
+}
+
+bool FInputSequenceHitCounters::GetRecord(const FIoHash& sourceHash, FInputSequenceHitCountersRecord& outRecord) const
+{
+	FScopeLock lock(&EntriesCS);
+
+	const FEntry* entry = Entries.Find(sourceHash);
+
+	if (!entry) return false;
+
+	const InputSequenceCore::FHitCounters& counters = *entry->Counters;
+
+	outRecord.AssetName = entry->AssetName;
+	outRecord.Counts.Reset((int32)(counters.GetNumStates() * InputSequenceCore::FHitCounters::NumEvents));
+
+	for (size_t stateIndex = 0; stateIndex < counters.GetNumStates(); stateIndex++)
+	{
+		outRecord.Counts.Add(counters.Get(stateIndex, InputSequenceCore::EStateEvent::Enter));
+		outRecord.Counts.Add(counters.Get(stateIndex, InputSequenceCore::EStateEvent::Pass));
+		outRecord.Counts.Add(counters.Get(stateIndex, InputSequenceCore::EStateEvent::Reset));
+	}
+
+	return true;
+}
+
+bool FInputSequenceHitCounters::Save(const FString& filePath)
+{
+	TMap<FIoHash, FInputSequenceHitCountersRecord> records;
+
+	if (FPaths::FileExists(filePath) && !LoadFromFile(filePath, records))
+	{
+		UE_LOG(LogInputSequence, Error, TEXT("Hit counters file %s can't be read, it is not overwritten"), *filePath);
+		return false;
+	}
+
+	TArray<FIoHash> sourceHashes;
+	{
+		FScopeLock lock(&EntriesCS);
+		Entries.GetKeys(sourceHashes);
+	}
+
+	// Counts are taken once, and become baseline of next save only if file is written and counters are not reset meanwhile
+
+	struct FTakenCounts
+	{
+		TArray<uint64> Counts;
+
+		uint32 ResetGeneration = 0;
+	};
+
+	TMap<FIoHash, FTakenCounts> takenCounts;
+	takenCounts.Reserve(sourceHashes.Num());
+
+	for (const FIoHash& sourceHash : sourceHashes)
+	{
+		FInputSequenceHitCountersRecord record;
+
+		{
+			FScopeLock lock(&EntriesCS);
+
+			const FEntry& entry = Entries[sourceHash];
+
+			GetRecord(sourceHash, record);
+
+			FTakenCounts& taken = takenCounts.Add(sourceHash);
+			taken.Counts = record.Counts;
+			taken.ResetGeneration = entry.ResetGeneration;
+
+			// Only counts made since last save are added, so saving twice does not count them twice. Baseline is of the same reset generation, so counts never go below it
+
+			if (entry.SavedCounts.Num() == record.Counts.Num())
+			{
+				for (int32 i = 0; i < record.Counts.Num(); i++) record.Counts[i] -= entry.SavedCounts[i];
+			}
+		}
+
+		FInputSequenceHitCountersRecord& savedRecord = records.FindOrAdd(sourceHash);
+
+		// Same source hash means same states, so counts are added state by state
+
+		if (savedRecord.Counts.Num() != record.Counts.Num())
+		{
+			savedRecord = MoveTemp(record);
+			continue;
+		}
+
+		for (int32 i = 0; i < record.Counts.Num(); i++) savedRecord.Counts[i] += record.Counts[i];
+
+		savedRecord.AssetName = record.AssetName;
+	}
+
+	if (!SaveToFile(filePath, records)) return false;
+
+	FScopeLock lock(&EntriesCS);
+
+	for (TPair<FIoHash, FTakenCounts>& taken : takenCounts)
+	{
+		FEntry& entry = Entries[taken.Key];
+
+		if (entry.ResetGeneration == taken.Value.ResetGeneration) entry.SavedCounts = MoveTemp(taken.Value.Counts);
+	}
+
+	return true;
+}
+
+bool FInputSequenceHitCounters::LoadFromFile(const FString& filePath, TMap<FIoHash, FInputSequenceHitCountersRecord>& outRecords)
+{
+	outRecords.Reset();
+
+	TArray<uint8> data;
+	if (!FFileHelper::LoadFileToArray(data, *filePath)) return false;
+
+	FMemoryReader reader(data);
+
+	uint32 magic = 0;
+	uint32 version = 0;
+	int32 numRecords = 0;
+	reader << magic << version << numRecords;
+
+	if (reader.IsError() || magic != InputSequenceHitCounters::Magic || version != InputSequenceHitCounters::Version || numRecords < 0) return false;
+
+	for (int32 i = 0; i < numRecords && !reader.IsError(); i++)
+	{
+		FIoHash sourceHash;
+		reader << sourceHash;
+
+		FInputSequenceHitCountersRecord& record = outRecords.Add(sourceHash);
+		reader << record.AssetName;
+		reader << record.Counts;
+
+		if (record.Counts.Num() % InputSequenceCore::FHitCounters::NumEvents != 0) return false;
+	}
+
+	return !reader.IsError();
+}
+
+bool FInputSequenceHitCounters::SaveToFile(const FString& filePath, const TMap<FIoHash, FInputSequenceHitCountersRecord>& records)
+{
+	TArray<uint8> data;
+	FMemoryWriter writer(data);
+
+	uint32 magic = InputSequenceHitCounters::Magic;
+	uint32 version = InputSequenceHitCounters::Version;
+	int32 numRecords = records.Num();
+	writer << magic << version << numRecords;
+
+	for (const TPair<FIoHash, FInputSequenceHitCountersRecord>& record : records)
+	{
+		FIoHash sourceHash = record.Key;
+		FString assetName = record.Value.AssetName;
+		TArray<uint64> counts = record.Value.Counts;
+
+		writer << sourceHash << assetName << counts;
+	}
+
+	return FFileHelper::SaveArrayToFile(data, *filePath);
+}
+
+#endif
\ No newline at end of file
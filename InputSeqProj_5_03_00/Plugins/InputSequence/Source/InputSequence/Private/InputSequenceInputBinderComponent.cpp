@@ -0,0 +1,96 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceInputBinderComponent.h"
+#include "EnhancedInputComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+UInputSequenceInputBinderComponent::UInputSequenceInputBinderComponent(const FObjectInitializer& objInit) :Super(objInit)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bTickEvenWhenPaused = true;
+}
+
+void UInputSequenceInputBinderComponent::BindInput(UEnhancedInputComponent* inputComponent)
+{
+	Binding.Bind(inputComponent, Instances);
+}
+
+void UInputSequenceInputBinderComponent::UnbindInput()
+{
+	Binding.Unbind();
+}
+
+void UInputSequenceInputBinderComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	for (UInputSequenceAsset* asset : InputSequenceAssets)
+	{
+		Instances.Add(asset ? DuplicateObject<UInputSequenceAsset>(asset, this) : nullptr);
+	}
+
+	AActor* owner = GetOwner();
+
+	if (APawn* pawn = Cast<APawn>(owner)) pawn->ReceiveRestartedDelegate.AddDynamic(this, &UInputSequenceInputBinderComponent::OnPawnRestarted);
+
+	UpdateTickPrerequisite();
+
+	if (UEnhancedInputComponent* inputComponent = Cast<UEnhancedInputComponent>(owner ? owner->InputComponent : nullptr))
+	{
+		BindInput(inputComponent);
+	}
+}
+
+void UInputSequenceInputBinderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (APawn* pawn = Cast<APawn>(GetOwner())) pawn->ReceiveRestartedDelegate.RemoveDynamic(this, &UInputSequenceInputBinderComponent::OnPawnRestarted);
+
+	UnbindInput();
+	Instances.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInputSequenceInputBinderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	Binding.Step(Instances, DeltaTime, GetWorld() && GetWorld()->IsPaused(), GetOwner(), CallingContext);
+}
+
+void UInputSequenceInputBinderComponent::OnPawnRestarted(APawn* pawn)
+{
+	// Restart of locally controlled pawn creates new input component, previous one is destroyed with its bindings
+
+	UpdateTickPrerequisite();
+
+	if (UEnhancedInputComponent* inputComponent = Cast<UEnhancedInputComponent>(pawn ? pawn->InputComponent : nullptr))
+	{
+		if (inputComponent != Binding.GetInputComponent()) BindInput(inputComponent);
+	}
+	else
+	{
+		UnbindInput();
+	}
+}
+
+void UInputSequenceInputBinderComponent::UpdateTickPrerequisite()
+{
+	AActor* owner = GetOwner();
+
+	APlayerController* playerController = Cast<APlayerController>(owner);
+	if (!playerController)
+	{
+		if (APawn* pawn = Cast<APawn>(owner)) playerController = Cast<APlayerController>(pawn->GetController());
+	}
+
+	if (playerController == PrerequisiteController.Get()) return;
+
+	if (APlayerController* prevController = PrerequisiteController.Get()) RemoveTickPrerequisiteActor(prevController);
+
+	if (playerController) AddTickPrerequisiteActor(playerController);
+
+	PrerequisiteController = playerController;
+}
\ No newline at end of file
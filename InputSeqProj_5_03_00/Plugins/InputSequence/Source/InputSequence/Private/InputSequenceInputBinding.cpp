@@ -0,0 +1,137 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceInputBinding.h"
+#include "EnhancedInputComponent.h"
+#include "InputAction.h"
+
+void FInputSequenceInputBinding::Bind(UEnhancedInputComponent* inputComponent, const TArray<TObjectPtr<UInputSequenceAsset>>& assets)
+{
+	Unbind();
+
+	BoundAssets.SetNum(assets.Num());
+
+	if (!inputComponent) return;
+
+	BoundInputComponent = inputComponent;
+
+	for (int32 assetIndex = 0; assetIndex < assets.Num(); assetIndex++)
+	{
+		if (!assets[assetIndex]) continue;
+
+		const FInputSequenceCompiledData& compiledData = assets[assetIndex]->GetCompiledData();
+
+		for (int32 nameIndex = 0; nameIndex < compiledData.NumNames(); nameIndex++)
+		{
+			const UInputAction* inputAction = Cast<UInputAction>(compiledData.GetNameInputAction(nameIndex));
+
+			if (!inputAction) continue;
+
+			const uint32 nameId = nameIndex;
+
+			if (inputAction->ValueType == EInputActionValueType::Boolean)
+			{
+				auto addActionInput = [this, assetIndex, nameId](InputSequenceCore::EInputEvent inputEvent) { BoundAssets[assetIndex].ActionInputs.Add({ nameId, inputEvent }); };
+
+				BindingHandles.Add(inputComponent->BindActionValueLambda(inputAction, ETriggerEvent::Started, [addActionInput](const FInputActionValue&) { addActionInput(InputSequenceCore::EInputEvent::Pressed); }).GetHandle());
+				BindingHandles.Add(inputComponent->BindActionValueLambda(inputAction, ETriggerEvent::Completed, [addActionInput](const FInputActionValue&) { addActionInput(InputSequenceCore::EInputEvent::Released); }).GetHandle());
+				BindingHandles.Add(inputComponent->BindActionValueLambda(inputAction, ETriggerEvent::Canceled, [addActionInput](const FInputActionValue&) { addActionInput(InputSequenceCore::EInputEvent::Released); }).GetHandle());
+			}
+			else
+			{
+				// Axis1D fills X only, Axis2D and Axis3D fill components their regions are matched against
+
+				FBoundAsset& boundAsset = BoundAssets[assetIndex];
+
+				const int32 axisIndex = boundAsset.AxisInputs.Add({ nameId, 0 });
+				boundAsset.NumBoundAxes = boundAsset.AxisInputs.Num();
+
+				auto setAxisValue = [this, assetIndex, axisIndex](const FVector& axisValue)
+				{
+					InputSequenceCore::FAxisInput& axisInput = BoundAssets[assetIndex].AxisInputs[axisIndex];
+					axisInput.Value = axisValue.X;
+					axisInput.ValueY = axisValue.Y;
+					axisInput.ValueZ = axisValue.Z;
+				};
+
+				BindingHandles.Add(inputComponent->BindActionValueLambda(inputAction, ETriggerEvent::Triggered, [setAxisValue](const FInputActionValue& value) { setAxisValue(value.Get<FVector>()); }).GetHandle());
+				BindingHandles.Add(inputComponent->BindActionValueLambda(inputAction, ETriggerEvent::Completed, [setAxisValue](const FInputActionValue&) { setAxisValue(FVector::ZeroVector); }).GetHandle());
+				BindingHandles.Add(inputComponent->BindActionValueLambda(inputAction, ETriggerEvent::Canceled, [setAxisValue](const FInputActionValue&) { setAxisValue(FVector::ZeroVector); }).GetHandle());
+			}
+		}
+	}
+}
+
+void FInputSequenceInputBinding::Unbind()
+{
+	if (UEnhancedInputComponent* inputComponent = BoundInputComponent.Get())
+	{
+		for (uint32 bindingHandle : BindingHandles)
+		{
+			inputComponent->RemoveBindingByHandle(bindingHandle);
+		}
+	}
+
+	BoundInputComponent.Reset();
+	BindingHandles.Empty();
+	BoundAssets.Empty();
+}
+
+void FInputSequenceInputBinding::AddActionInput(const TArray<TObjectPtr<UInputSequenceAsset>>& assets, const FName& actionName, EInputEvent inputEvent)
+{
+	BoundAssets.SetNum(assets.Num());
+
+	for (int32 assetIndex = 0; assetIndex < assets.Num(); assetIndex++)
+	{
+		if (assets[assetIndex]) BoundAssets[assetIndex].ActionInputs.Add({ assets[assetIndex]->GetNameId(actionName), (InputSequenceCore::EInputEvent)inputEvent });
+	}
+}
+
+void FInputSequenceInputBinding::AddAxisInput(const TArray<TObjectPtr<UInputSequenceAsset>>& assets, const FName& axisName, float axisValue)
+{
+	BoundAssets.SetNum(assets.Num());
+
+	for (int32 assetIndex = 0; assetIndex < assets.Num(); assetIndex++)
+	{
+		if (assets[assetIndex]) BoundAssets[assetIndex].AxisInputs.Add({ assets[assetIndex]->GetNameId(axisName), axisValue });
+	}
+}
+
+void FInputSequenceInputBinding::ConsumeInput(const TArray<TObjectPtr<UInputSequenceAsset>>& assets, int32 assetIndex, TArray<InputSequenceCore::FActionInput>& outActionInputs, TArray<InputSequenceCore::FAxisInput>& outAxisInputs)
+{
+	BoundAssets.SetNum(assets.Num());
+
+	FBoundAsset& boundAsset = BoundAssets[assetIndex];
+
+	outActionInputs = boundAsset.ActionInputs;
+	outAxisInputs = boundAsset.AxisInputs;
+
+	boundAsset.ActionInputs.Reset();
+	boundAsset.AxisInputs.SetNum(boundAsset.NumBoundAxes, false);
+}
+
+void FInputSequenceInputBinding::Step(const TArray<TObjectPtr<UInputSequenceAsset>>& assets, float DeltaTime, bool bGamePaused, UObject* callingObject, const FString& callingContext)
+{
+	BoundAssets.SetNum(assets.Num());
+
+	for (int32 assetIndex = 0; assetIndex < assets.Num(); assetIndex++)
+	{
+		UInputSequenceAsset* asset = assets[assetIndex];
+
+		if (!asset) continue;
+
+		FBoundAsset& boundAsset = BoundAssets[assetIndex];
+
+		EventCalls.Reset();
+		ResetSources.Reset();
+
+		asset->OnNativeInput(DeltaTime, bGamePaused, boundAsset.ActionInputs, boundAsset.AxisInputs, EventCalls, ResetSources);
+
+		boundAsset.ActionInputs.Reset();
+		boundAsset.AxisInputs.SetNum(boundAsset.NumBoundAxes, false);
+
+		for (const FInputSequenceEventCall& eventCall : EventCalls)
+		{
+			UInputSequenceEvent::OnExecuteByClass(eventCall.EventClass, eventCall.Index, callingObject, callingContext, eventCall.Object, eventCall.Context, ResetSources);
+		}
+	}
+}
\ No newline at end of file
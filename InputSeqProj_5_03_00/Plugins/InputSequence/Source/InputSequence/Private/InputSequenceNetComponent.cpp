@@ -0,0 +1,301 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceNetComponent.h"
+#include "InputSequence.h"
+#include "InputSequenceTrace.h"
+#include "EnhancedInputComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+UInputSequenceNetComponent::UInputSequenceNetComponent(const FObjectInitializer& objInit) :Super(objInit)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bTickEvenWhenPaused = true;
+
+	SetIsReplicatedByDefault(true);
+}
+
+void UInputSequenceNetComponent::RegisterInputActionEvent(FName inputActionName, EInputEvent inputEvent)
+{
+	Binding.AddActionInput(Instances, inputActionName, inputEvent);
+}
+
+void UInputSequenceNetComponent::RegisterInputAxisEvent(FName inputAxisName, float axisValue)
+{
+	Binding.AddAxisInput(Instances, inputAxisName, axisValue);
+}
+
+void UInputSequenceNetComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ResetInstances();
+
+	// Input is processed in tick of Player Controller, so sequences are stepped after it within the same frame
+
+	if (AActor* owner = GetOwner()) AddTickPrerequisiteActor(owner);
+}
+
+void UInputSequenceNetComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Binding.Unbind();
+	Instances.Empty();
+	Codecs.Empty();
+	SentFrames.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInputSequenceNetComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Server evaluates input of remote players only when their frames arrive
+
+	if (!IsInputOwner()) return;
+
+	AActor* owner = GetOwner();
+
+	// Player Controller gets its Input Component after BeginPlay of its components, and may replace it later
+
+	UEnhancedInputComponent* inputComponent = Cast<UEnhancedInputComponent>(owner->InputComponent);
+	if (inputComponent != Binding.GetInputComponent()) Binding.Bind(inputComponent, Instances);
+
+	const bool bGamePaused = GetWorld() && GetWorld()->IsPaused();
+	const bool bHasAuthority = owner->HasAuthority();
+
+	// Local evaluation runs on quantized input, the same server gets, so both come to the same states
+
+	FrameWriter.Reset();
+	FrameWriter.Write(bIsKeyframePending ? 1 : 0, 1);
+
+	float deltaTime = DeltaTime;
+	InputSequenceCore::FInputStreamCodec::WriteDeltaTime(FrameWriter, deltaTime);
+	FrameWriter.Write(bGamePaused ? 1 : 0, 1);
+
+	for (int32 assetIndex = 0; assetIndex < Instances.Num(); assetIndex++)
+	{
+		UInputSequenceAsset* instance = Instances[assetIndex];
+
+		if (!instance) continue;
+
+		const InputSequenceCore::FGraphView graph = instance->GetCompiledData().GetView();
+
+		Binding.ConsumeInput(Instances, assetIndex, RawActionInputs, RawAxisInputs);
+
+		Codecs[assetIndex].Write(graph, RawActionInputs.GetData(), RawActionInputs.Num(), RawAxisInputs.GetData(), RawAxisInputs.Num(), FrameWriter, ActionInputs, AxisInputs);
+
+		EvaluateInstance(assetIndex, deltaTime, bGamePaused);
+
+		TConstArrayView<uint16> passedStates = instance->GetPassedStates();
+
+		Codecs[assetIndex].WritePassedStates(graph, passedStates.GetData(), passedStates.Num(), FrameWriter);
+
+		if (bHasAuthority)
+		{
+			for (uint16 stateIndex : passedStates)
+			{
+				OnStateConfirmed.Broadcast(instance, stateIndex);
+			}
+		}
+	}
+
+	if (!bHasAuthority)
+	{
+		// Frame goes with previous ones, so lost packet is recovered by next one instead of being resent
+
+		if (SentFrames.Num() > RedundantFrames) SentFrames.RemoveAt(0, SentFrames.Num() - RedundantFrames, false);
+
+		FInputSequenceNetFrame& frame = SentFrames.AddDefaulted_GetRef();
+		frame.Sequence = NextSequence++;
+		frame.Data = TArray<uint8>(FrameWriter.GetData().data(), (int32)FrameWriter.GetData().size());
+
+		ServerInputFrames(SentFrames);
+
+		for (const FInputSequenceNetFrame& sentFrame : SentFrames)
+		{
+			INC_DWORD_STAT_BY(STAT_InputSequence_StreamBytes, sentFrame.Data.Num());
+		}
+	}
+
+	bIsKeyframePending = false;
+}
+
+void UInputSequenceNetComponent::ServerInputFrames_Implementation(const TArray<FInputSequenceNetFrame>& frames)
+{
+	INPUTSEQUENCE_SCOPE_CYCLE_COUNTER(STAT_InputSequence_InputStream);
+
+	for (const FInputSequenceNetFrame& frame : frames)
+	{
+		// Redundant copy of frame that is already applied, or frame made before last keyframe
+
+		if ((int32)(frame.Sequence - LastAppliedSequence) <= 0) continue;
+
+		InputSequenceCore::FBitReader reader(frame.Data.GetData(), frame.Data.Num());
+
+		uint32 isKeyframe;
+		if (!reader.Read(isKeyframe, 1)) isKeyframe = 0;
+
+		if (isKeyframe)
+		{
+			// Instances and codecs are fresh until first frame is applied
+
+			if (LastAppliedSequence != 0) ResetInstances();
+
+			StreamStartTime = GetWorld()->GetUnpausedTimeSeconds();
+			StreamTime = 0;
+
+			bIsStreamBroken = false;
+		}
+		else if (bIsStreamBroken || frame.Sequence != LastAppliedSequence + 1)
+		{
+			// Axes are delta coded, so stream can't be followed over missed frames until keyframe
+
+			bIsStreamBroken = true;
+			continue;
+		}
+
+		LastAppliedSequence = frame.Sequence;
+
+		if (!ApplyFrame(reader))
+		{
+			bIsStreamBroken = true;
+		}
+		else if (isKeyframe)
+		{
+			// Request time is kept if keyframe fails too, so stream made for other assets is resynced only once per timeout
+			ResyncRequestTime = -1;
+		}
+	}
+
+	if (bIsStreamBroken) RequestResync();
+}
+
+bool UInputSequenceNetComponent::ApplyFrame(InputSequenceCore::FBitReader& reader)
+{
+	float deltaTime;
+	uint32 isGamePaused;
+
+	if (!InputSequenceCore::FInputStreamCodec::ReadDeltaTime(reader, deltaTime) || !reader.Read(isGamePaused, 1)) return false;
+
+	// Delta times of client can't add up past time passed on server, otherwise states waiting for time (e.g. charge) would pass at once.
+	// Lag of client up to slack is kept for frames delayed by network, older lag is dropped so it can't be saved up for later
+
+	const double serverTime = GetWorld()->GetUnpausedTimeSeconds() - StreamStartTime;
+
+	StreamTime = FMath::Max(StreamTime, serverTime - ClientTimeSlack) + deltaTime;
+
+	if (StreamTime > serverTime + ClientTimeSlack) return false;
+
+	// Pause is not taken from client, so it can't hold reset timers of its states
+
+	const bool bGamePaused = GetWorld()->IsPaused();
+
+	for (int32 assetIndex = 0; assetIndex < Instances.Num(); assetIndex++)
+	{
+		UInputSequenceAsset* instance = Instances[assetIndex];
+
+		if (!instance) continue;
+
+		const InputSequenceCore::FGraphView graph = instance->GetCompiledData().GetView();
+
+		if (!Codecs[assetIndex].Read(graph, reader, ActionInputs, AxisInputs)) return false;
+
+		EvaluateInstance(assetIndex, deltaTime, bGamePaused);
+
+		if (!Codecs[assetIndex].ReadPassedStates(graph, reader, ClaimedStates)) return false;
+
+		TConstArrayView<uint16> passedStates = instance->GetPassedStates();
+
+		for (uint16 stateIndex : ClaimedStates)
+		{
+			if (passedStates.Contains(stateIndex))
+			{
+				OnStateConfirmed.Broadcast(instance, stateIndex);
+			}
+			else
+			{
+				INC_DWORD_STAT(STAT_InputSequence_RejectedStates);
+
+				OnStateRejected.Broadcast(instance, stateIndex);
+				ClientStateRejected(assetIndex, stateIndex);
+			}
+		}
+	}
+
+	return true;
+}
+
+void UInputSequenceNetComponent::RequestResync()
+{
+	const double time = FPlatformTime::Seconds();
+
+	if (ResyncRequestTime >= 0 && time - ResyncRequestTime < ResyncTimeout) return;
+
+	if (ResyncRequestTime < 0 && LastAppliedSequence != 0)
+	{
+		UE_LOG(LogInputSequence, Warning, TEXT("Input Sequence stream of %s lost frames, is malformed or runs ahead of server time, its input is ignored until keyframe"), *GetPathNameSafe(GetOwner()));
+	}
+
+	ResyncRequestTime = time;
+
+	ClientResync();
+}
+
+void UInputSequenceNetComponent::ClientResync_Implementation()
+{
+	if (!IsInputOwner()) return;
+
+	ResetInstances();
+
+	Binding.Bind(Binding.GetInputComponent(), Instances);
+
+	// Frames already sent continue old stream, server skips them anyway
+
+	SentFrames.Reset();
+
+	bIsKeyframePending = true;
+}
+
+void UInputSequenceNetComponent::ClientStateRejected_Implementation(int32 assetIndex, int32 stateIndex)
+{
+	if (Instances.IsValidIndex(assetIndex)) OnStateRejected.Broadcast(Instances[assetIndex], stateIndex);
+}
+
+void UInputSequenceNetComponent::ResetInstances()
+{
+	Instances.Reset();
+
+	for (UInputSequenceAsset* asset : InputSequenceAssets)
+	{
+		Instances.Add(asset ? DuplicateObject<UInputSequenceAsset>(asset, this) : nullptr);
+	}
+
+	Codecs.SetNum(Instances.Num());
+
+	for (int32 assetIndex = 0; assetIndex < Instances.Num(); assetIndex++)
+	{
+		if (Instances[assetIndex]) Codecs[assetIndex].Reset(Instances[assetIndex]->GetCompiledData().GetView());
+	}
+}
+
+bool UInputSequenceNetComponent::IsInputOwner() const
+{
+	const APlayerController* playerController = Cast<APlayerController>(GetOwner());
+	return playerController && playerController->IsLocalController();
+}
+
+void UInputSequenceNetComponent::EvaluateInstance(int32 assetIndex, float deltaTime, bool bGamePaused)
+{
+	UInputSequenceAsset* instance = Instances[assetIndex];
+
+	EventCalls.Reset();
+	ResetSources.Reset();
+
+	instance->OnNativeInput(deltaTime, bGamePaused, MakeArrayView(ActionInputs.data(), (int32)ActionInputs.size()), MakeArrayView(AxisInputs.data(), (int32)AxisInputs.size()), EventCalls, ResetSources);
+
+	for (const FInputSequenceEventCall& eventCall : EventCalls)
+	{
+		UInputSequenceEvent::OnExecuteByClass(eventCall.EventClass, eventCall.Index, GetOwner(), CallingContext, eventCall.Object, eventCall.Context, ResetSources);
+	}
+}
\ No newline at end of file
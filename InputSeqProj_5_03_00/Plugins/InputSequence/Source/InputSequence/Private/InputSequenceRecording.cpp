@@ -0,0 +1,397 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceRecording.h"
+#include "InputSequence.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Misc/FileHelper.h"
+
+namespace InputSequenceRecording
+{
+	constexpr uint32 Magic = 0x43525349; // "ISRC"
+
+	/* 2: axis values are 3D, each component is written only when changed */
+	constexpr uint64 Version = 2;
+
+	constexpr uint64 Version_1DAxes = 1;
+
+	enum ERecordTag : uint8
+	{
+		Tag_Frame = 0,
+		Tag_IdleFrames = 1,
+		Tag_Reset = 2,
+
+		Tag_Mask = 0x3
+	};
+
+	enum EFrameFlags : uint8
+	{
+		Frame_GamePaused = 1 << 2,
+		Frame_DeltaTimeChanged = 1 << 3,
+		Frame_ActionEvents = 1 << 4,
+		Frame_AxisEvents = 1 << 5
+	};
+
+	constexpr int32 InputEventBits = 3;
+
+	/* Axis values are 3D, mask with one bit per changed component is written next to name index of axis */
+	constexpr int32 NumAxisComponents = 3;
+}
+
+FInputSequenceRecordingWriter::FInputSequenceRecordingWriter(const FString& assetPath)
+	: NumStrings(0)
+	, LastDeltaTime(0)
+	, bLastGamePaused(false)
+	, NumIdleFrames(0)
+	, NumFrames(0)
+{
+	Data.Reserve(64 * 1024);
+
+	WriteVarInt(InputSequenceRecording::Magic);
+	WriteVarInt(InputSequenceRecording::Version);
+	WriteRawString(assetPath);
+}
+
+void FInputSequenceRecordingWriter::RecordFrame(float deltaTime, bool bGamePaused, const TMap<FName, TEnumAsByte<EInputEvent>>& actionEvents, const TMap<FName, FVector3f>& axisEvents)
+{
+	using namespace InputSequenceRecording;
+
+	NumFrames++;
+
+	if (actionEvents.Num() == 0 && deltaTime == LastDeltaTime && bGamePaused == bLastGamePaused && axisEvents.OrderIndependentCompareEqual(LastAxisEvents))
+	{
+		NumIdleFrames++;
+		return;
+	}
+
+	FlushIdleFrames();
+
+	uint8 tag = Tag_Frame;
+	if (bGamePaused) tag |= Frame_GamePaused;
+	if (deltaTime != LastDeltaTime) tag |= Frame_DeltaTimeChanged;
+	if (actionEvents.Num() > 0) tag |= Frame_ActionEvents;
+	if (axisEvents.Num() > 0) tag |= Frame_AxisEvents;
+
+	Data.Add(tag);
+
+	if (deltaTime != LastDeltaTime) WriteFloat(deltaTime);
+
+	if (actionEvents.Num() > 0)
+	{
+		WriteVarInt(actionEvents.Num());
+
+		for (const TPair<FName, TEnumAsByte<EInputEvent>>& actionEvent : actionEvents)
+		{
+			bool bIsNew = false;
+			const uint32 nameIndex = GetNameIndex(actionEvent.Key, bIsNew);
+
+			WriteVarInt(((uint64)nameIndex << InputEventBits) | (uint64)actionEvent.Value.GetValue());
+			if (bIsNew) WriteRawString(actionEvent.Key.ToString());
+		}
+	}
+
+	if (axisEvents.Num() > 0)
+	{
+		WriteVarInt(axisEvents.Num());
+
+		for (const TPair<FName, FVector3f>& axisEvent : axisEvents)
+		{
+			bool bIsNew = false;
+			const uint32 nameIndex = GetNameIndex(axisEvent.Key, bIsNew);
+
+			// Components start from zero, so Y and Z of 1D axes are never written
+
+			const FVector3f* lastAxisValuePtr = LastAxisValues.Find(nameIndex);
+			const FVector3f lastAxisValue = lastAxisValuePtr ? *lastAxisValuePtr : FVector3f::ZeroVector;
+
+			uint8 changedComponents = 0;
+			for (int32 component = 0; component < NumAxisComponents; component++)
+			{
+				if (axisEvent.Value[component] != lastAxisValue[component]) changedComponents |= 1 << component;
+			}
+
+			WriteVarInt(((uint64)nameIndex << NumAxisComponents) | changedComponents);
+			if (bIsNew) WriteRawString(axisEvent.Key.ToString());
+
+			for (int32 component = 0; component < NumAxisComponents; component++)
+			{
+				if (changedComponents & (1 << component)) WriteFloat(axisEvent.Value[component]);
+			}
+
+			LastAxisValues.Add(nameIndex, axisEvent.Value);
+		}
+	}
+
+	LastDeltaTime = deltaTime;
+	bLastGamePaused = bGamePaused;
+	LastAxisEvents = axisEvents;
+}
+
+void FInputSequenceRecordingWriter::RecordReset(const UObject* sourceObject, const FString& sourceContext)
+{
+	FlushIdleFrames();
+
+	Data.Add(InputSequenceRecording::Tag_Reset);
+
+	const FString sourcePath = sourceObject ? sourceObject->GetPathName() : FString();
+
+	for (const FString* string : { &sourcePath, &sourceContext })
+	{
+		bool bIsNew = false;
+		WriteVarInt(GetStringIndex(*string, bIsNew));
+		if (bIsNew) WriteRawString(*string);
+	}
+}
+
+bool FInputSequenceRecordingWriter::SaveToFile(const FString& filePath)
+{
+	FlushIdleFrames();
+
+	return FFileHelper::SaveArrayToFile(Data, *filePath);
+}
+
+void FInputSequenceRecordingWriter::FlushIdleFrames()
+{
+	if (NumIdleFrames > 0)
+	{
+		Data.Add(InputSequenceRecording::Tag_IdleFrames);
+		WriteVarInt(NumIdleFrames);
+
+		NumIdleFrames = 0;
+	}
+}
+
+void FInputSequenceRecordingWriter::WriteVarInt(uint64 value)
+{
+	do
+	{
+		uint8 byte = value & 0x7F;
+		value >>= 7;
+
+		Data.Add(value ? (byte | 0x80) : byte);
+	}
+	while (value);
+}
+
+void FInputSequenceRecordingWriter::WriteFloat(float value)
+{
+	const uint32 bits = INTEL_ORDER32(*reinterpret_cast<const uint32*>(&value));
+	Data.Append(reinterpret_cast<const uint8*>(&bits), sizeof(bits));
+}
+
+void FInputSequenceRecordingWriter::WriteRawString(const FString& string)
+{
+	FTCHARToUTF8 utf8String(*string, string.Len());
+
+	WriteVarInt(utf8String.Length());
+	Data.Append(reinterpret_cast<const uint8*>(utf8String.Get()), utf8String.Length());
+}
+
+uint32 FInputSequenceRecordingWriter::GetStringIndex(const FString& string, bool& bIsNew)
+{
+	if (const uint32* index = StringIndice.Find(string))
+	{
+		bIsNew = false;
+		return *index;
+	}
+
+	bIsNew = true;
+	return StringIndice.Add(string, NumStrings++);
+}
+
+uint32 FInputSequenceRecordingWriter::GetNameIndex(const FName& name, bool& bIsNew)
+{
+	if (const uint32* index = NameIndice.Find(name))
+	{
+		bIsNew = false;
+		return *index;
+	}
+
+	return NameIndice.Add(name, GetStringIndex(name.ToString(), bIsNew));
+}
+
+
+
+FInputSequenceRecordingReader::FInputSequenceRecordingReader()
+	: Offset(0)
+	, NumIdleFrames(0)
+	, Version(0)
+	, bIsError(false)
+{}
+
+bool FInputSequenceRecordingReader::LoadFromFile(const FString& filePath)
+{
+	*this = FInputSequenceRecordingReader();
+
+	uint64 magic = 0;
+
+	bIsError = !FFileHelper::LoadFileToArray(Data, *filePath)
+		|| !ReadVarInt(magic) || magic != InputSequenceRecording::Magic
+		|| !ReadVarInt(Version) || Version < InputSequenceRecording::Version_1DAxes || Version > InputSequenceRecording::Version
+		|| !ReadRawString(AssetPath);
+
+	if (bIsError) UE_LOG(LogInputSequence, Error, TEXT("%s is not Input Sequence recording or has unsupported version"), *filePath);
+
+	return !bIsError;
+}
+
+FInputSequenceRecordingReader::ERecord FInputSequenceRecordingReader::ReadNext(FInputSequenceRecordedFrame& outFrame, FInputSequenceRecordedReset& outReset)
+{
+	using namespace InputSequenceRecording;
+
+	if (NumIdleFrames > 0)
+	{
+		NumIdleFrames--;
+
+		outFrame = LastFrame;
+		outFrame.ActionEvents.Reset();
+
+		return ERecord::Frame;
+	}
+
+	if (bIsError || Offset >= Data.Num()) return ERecord::End;
+
+	const uint8 tag = Data[Offset++];
+
+	switch (tag & Tag_Mask)
+	{
+	case Tag_Frame:
+	{
+		FInputSequenceRecordedFrame& frame = LastFrame;
+		frame.bGamePaused = (tag & Frame_GamePaused) != 0;
+		frame.ActionEvents.Reset();
+
+		if (tag & Frame_DeltaTimeChanged) bIsError |= !ReadFloat(frame.DeltaTime);
+
+		if (tag & Frame_ActionEvents)
+		{
+			uint64 numActionEvents = 0;
+			bIsError |= !ReadVarInt(numActionEvents);
+
+			for (uint64 i = 0; i < numActionEvents && !bIsError; i++)
+			{
+				uint64 value = 0;
+				bIsError |= !ReadVarInt(value) || !ReadStringIndex((uint32)(value >> InputEventBits));
+
+				if (!bIsError) frame.ActionEvents.Add(Names[value >> InputEventBits], (EInputEvent)(value & ((1 << InputEventBits) - 1)));
+			}
+		}
+
+		frame.AxisEvents.Reset();
+
+		if (tag & Frame_AxisEvents)
+		{
+			uint64 numAxisEvents = 0;
+			bIsError |= !ReadVarInt(numAxisEvents);
+
+			// Recordings of first version have only X, written as a whole when changed
+
+			const int32 componentBits = Version == Version_1DAxes ? 1 : NumAxisComponents;
+
+			for (uint64 i = 0; i < numAxisEvents && !bIsError; i++)
+			{
+				uint64 value = 0;
+				bIsError |= !ReadVarInt(value) || !ReadStringIndex((uint32)(value >> componentBits));
+
+				const uint32 nameIndex = (uint32)(value >> componentBits);
+
+				if (!bIsError && Version == Version_1DAxes && !(value & 1) && !LastAxisValues.Contains(nameIndex)) bIsError = true; // Unchanged value that was never written
+
+				FVector3f& axisValue = LastAxisValues.FindOrAdd(nameIndex, FVector3f::ZeroVector);
+
+				for (int32 component = 0; component < componentBits && !bIsError; component++)
+				{
+					if (value & (1ull << component)) bIsError |= !ReadFloat(axisValue[component]);
+				}
+
+				if (!bIsError) frame.AxisEvents.Add(Names[nameIndex], axisValue);
+			}
+		}
+
+		outFrame = frame;
+		break;
+	}
+	case Tag_IdleFrames:
+	{
+		bIsError |= !ReadVarInt(NumIdleFrames) || NumIdleFrames == 0;
+		return bIsError ? ERecord::End : ReadNext(outFrame, outReset);
+	}
+	case Tag_Reset:
+	{
+		uint64 pathIndex = 0;
+		uint64 contextIndex = 0;
+		bIsError |= !ReadVarInt(pathIndex) || !ReadStringIndex((uint32)pathIndex) || !ReadVarInt(contextIndex) || !ReadStringIndex((uint32)contextIndex);
+
+		if (!bIsError)
+		{
+			outReset.SourcePath = Strings[pathIndex];
+			outReset.SourceContext = Strings[contextIndex];
+		}
+
+		return bIsError ? ERecord::End : ERecord::Reset;
+	}
+	default:
+		bIsError = true;
+	}
+
+	if (bIsError) UE_LOG(LogInputSequence, Error, TEXT("Input Sequence recording is corrupted at offset %lld"), Offset);
+
+	return bIsError ? ERecord::End : ERecord::Frame;
+}
+
+bool FInputSequenceRecordingReader::ReadVarInt(uint64& outValue)
+{
+	outValue = 0;
+
+	for (int32 shift = 0; shift < 64 && Offset < Data.Num(); shift += 7)
+	{
+		const uint8 byte = Data[Offset++];
+		outValue |= (uint64)(byte & 0x7F) << shift;
+
+		if (!(byte & 0x80)) return true;
+	}
+
+	return false;
+}
+
+bool FInputSequenceRecordingReader::ReadFloat(float& outValue)
+{
+	if (Offset + (int64)sizeof(uint32) > Data.Num()) return false;
+
+	uint32 bits;
+	FMemory::Memcpy(&bits, Data.GetData() + Offset, sizeof(bits));
+	Offset += sizeof(bits);
+
+	bits = INTEL_ORDER32(bits);
+	FMemory::Memcpy(&outValue, &bits, sizeof(bits));
+
+	return true;
+}
+
+bool FInputSequenceRecordingReader::ReadRawString(FString& outString)
+{
+	uint64 length = 0;
+	if (!ReadVarInt(length) || Offset + (int64)length > Data.Num()) return false;
+
+	FUTF8ToTCHAR tcharString(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Offset), (int32)length);
+	outString = FString(tcharString.Length(), tcharString.Get());
+
+	Offset += length;
+
+	return true;
+}
+
+bool FInputSequenceRecordingReader::ReadStringIndex(uint32 index)
+{
+	if (index < (uint32)Strings.Num()) return true;
+
+	// Strings are defined in place of their first reference
+
+	if (index != Strings.Num()) return false;
+
+	FString& string = Strings.AddDefaulted_GetRef();
+	if (!ReadRawString(string)) return false;
+
+	Names.Add(FName(*string));
+
+	return true;
+}
\ No newline at end of file
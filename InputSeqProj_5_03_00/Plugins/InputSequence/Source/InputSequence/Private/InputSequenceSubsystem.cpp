@@ -0,0 +1,80 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceSubsystem.h"
+#include "EnhancedInputComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+void UInputSequenceSubsystem::Deinitialize()
+{
+	Binding.Unbind();
+	Instances.Empty();
+
+	Super::Deinitialize();
+}
+
+UInputSequenceAsset* UInputSequenceSubsystem::RegisterAsset(UInputSequenceAsset* asset)
+{
+	if (!asset) return nullptr;
+
+	UInputSequenceAsset* instance = DuplicateObject<UInputSequenceAsset>(asset, this);
+	Instances.Add(instance);
+
+	bIsBindingDirty = true;
+
+	return instance;
+}
+
+void UInputSequenceSubsystem::UnregisterAsset(UInputSequenceAsset* instance)
+{
+	if (Instances.Remove(instance) > 0) bIsBindingDirty = true;
+}
+
+void UInputSequenceSubsystem::RegisterInputActionEvent(FName inputActionName, EInputEvent inputEvent)
+{
+	if (bIsBindingDirty) Binding.Bind(GetPlayerInputComponent(), Instances);
+
+	bIsBindingDirty = false;
+
+	Binding.AddActionInput(Instances, inputActionName, inputEvent);
+}
+
+void UInputSequenceSubsystem::RegisterInputAxisEvent(FName inputAxisName, float axisValue)
+{
+	if (bIsBindingDirty) Binding.Bind(GetPlayerInputComponent(), Instances);
+
+	bIsBindingDirty = false;
+
+	Binding.AddAxisInput(Instances, inputAxisName, axisValue);
+}
+
+void UInputSequenceSubsystem::Tick(float DeltaTime)
+{
+	UEnhancedInputComponent* inputComponent = GetPlayerInputComponent();
+
+	// Player Controller may get its Input Component or be replaced after assets are registered
+
+	if (bIsBindingDirty || inputComponent != Binding.GetInputComponent()) Binding.Bind(inputComponent, Instances);
+
+	bIsBindingDirty = false;
+
+	const UWorld* world = GetTickableGameObjectWorld();
+	const ULocalPlayer* localPlayer = GetLocalPlayer();
+
+	Binding.Step(Instances, DeltaTime, world && world->IsPaused(), localPlayer ? localPlayer->GetPlayerController(world) : nullptr, FString());
+}
+
+UWorld* UInputSequenceSubsystem::GetTickableGameObjectWorld() const
+{
+	const ULocalPlayer* localPlayer = GetLocalPlayer();
+	return localPlayer ? localPlayer->GetWorld() : nullptr;
+}
+
+UEnhancedInputComponent* UInputSequenceSubsystem::GetPlayerInputComponent() const
+{
+	const ULocalPlayer* localPlayer = GetLocalPlayer();
+	const APlayerController* playerController = localPlayer ? localPlayer->GetPlayerController(localPlayer->GetWorld()) : nullptr;
+
+	return playerController ? Cast<UEnhancedInputComponent>(playerController->InputComponent) : nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceTrace.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+
+DEFINE_STAT(STAT_InputSequence_OnInput);
+DEFINE_STAT(STAT_InputSequence_Matching);
+DEFINE_STAT(STAT_InputSequence_MakeTransition);
+DEFINE_STAT(STAT_InputSequence_ProcessResetSources);
+DEFINE_STAT(STAT_InputSequence_EventDispatch);
+DEFINE_STAT(STAT_InputSequence_InputStream);
+
+DEFINE_STAT(STAT_InputSequence_ActiveStates);
+DEFINE_STAT(STAT_InputSequence_Transitions);
+DEFINE_STAT(STAT_InputSequence_Resets);
+DEFINE_STAT(STAT_InputSequence_EventCalls);
+DEFINE_STAT(STAT_InputSequence_AxisZoneChanges);
+DEFINE_STAT(STAT_InputSequence_StreamBytes);
+DEFINE_STAT(STAT_InputSequence_RejectedStates);
+
+#if INPUTSEQUENCE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(InputSequenceChannel);
+
+UE_TRACE_EVENT_BEGIN(InputSequence, Asset, NoSync | Important)
+	UE_TRACE_EVENT_FIELD(uint32, AssetId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Path)
+	UE_TRACE_EVENT_FIELD(uint8[], SourceHash)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(InputSequence, State)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, AssetId)
+	UE_TRACE_EVENT_FIELD(uint64, SourceHash)
+	UE_TRACE_EVENT_FIELD(int32, StateIndex)
+	UE_TRACE_EVENT_FIELD(uint8, Event)
+UE_TRACE_EVENT_END()
+
+void TraceInputSequenceState(const UObject* asset, const FIoHash& sourceHash, int32 stateIndex, EInputSequenceTraceEvent traceEvent)
+{
+	uint32 assetId = 0;
+
+	// Asset goes once per session and again whenever it is recompiled, events refer to it by id.
+	// Objects are keyed with their serial numbers, so asset reusing unique id of collected one gets its own id
+
+	{
+		struct FTracedAsset
+		{
+			uint32 Id = 0;
+			FIoHash SourceHash;
+		};
+
+		static FCriticalSection tracedAssetsCS;
+		static TMap<FObjectKey, FTracedAsset> tracedAssets;
+
+		FScopeLock Lock(&tracedAssetsCS);
+
+		FTracedAsset* tracedAsset = tracedAssets.Find(FObjectKey(asset));
+
+		if (!tracedAsset || tracedAsset->SourceHash != sourceHash)
+		{
+			if (!tracedAsset)
+			{
+				const uint32 newId = tracedAssets.Num() + 1;
+
+				tracedAsset = &tracedAssets.Add(FObjectKey(asset));
+				tracedAsset->Id = newId;
+			}
+
+			tracedAsset->SourceHash = sourceHash;
+
+			const FString path = asset->GetPathName();
+
+			UE_TRACE_LOG(InputSequence, Asset, InputSequenceChannel)
+				<< Asset.AssetId(tracedAsset->Id)
+				<< Asset.Path(*path, path.Len())
+				<< Asset.SourceHash(sourceHash.GetBytes(), sizeof(FIoHash::ByteArray));
+		}
+
+		assetId = tracedAsset->Id;
+	}
+
+	// Leading bytes of source hash are enough to tell graph versions of one asset apart
+
+	uint64 shortSourceHash = 0;
+	FMemory::Memcpy(&shortSourceHash, sourceHash.GetBytes(), sizeof(shortSourceHash));
+
+	UE_TRACE_LOG(InputSequence, State, InputSequenceChannel)
+		<< State.Cycle(FPlatformTime::Cycles64())
+		<< State.AssetId(assetId)
+		<< State.SourceHash(shortSourceHash)
+		<< State.StateIndex(stateIndex)
+		<< State.Event((uint8)traceEvent);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "IO/IoHash.h"
+
+DECLARE_STATS_GROUP(TEXT("InputSequence"), STATGROUP_InputSequence, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnInput"), STAT_InputSequence_OnInput, STATGROUP_InputSequence, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Matching"), STAT_InputSequence_Matching, STATGROUP_InputSequence, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("MakeTransition"), STAT_InputSequence_MakeTransition, STATGROUP_InputSequence, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ProcessResetSources"), STAT_InputSequence_ProcessResetSources, STATGROUP_InputSequence, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Event Dispatch"), STAT_InputSequence_EventDispatch, STATGROUP_InputSequence, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Input Stream"), STAT_InputSequence_InputStream, STATGROUP_InputSequence, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active States"), STAT_InputSequence_ActiveStates, STATGROUP_InputSequence, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Transitions"), STAT_InputSequence_Transitions, STATGROUP_InputSequence, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Resets"), STAT_InputSequence_Resets, STATGROUP_InputSequence, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Event Calls"), STAT_InputSequence_EventCalls, STATGROUP_InputSequence, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Axis Zone Changes"), STAT_InputSequence_AxisZoneChanges, STATGROUP_InputSequence, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Input Stream Bytes"), STAT_InputSequence_StreamBytes, STATGROUP_InputSequence, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rejected States"), STAT_InputSequence_RejectedStates, STATGROUP_InputSequence, );
+
+/* Cycle counter for stat InputSequence and CPU scope for Insights with the same name */
+#define INPUTSEQUENCE_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat); TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+
+#define INPUTSEQUENCE_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if INPUTSEQUENCE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(InputSequenceChannel);
+
+enum class EInputSequenceTraceEvent : uint8
+{
+	Enter,
+	Pass,
+	Reset
+};
+
+void TraceInputSequenceState(const UObject* asset, const FIoHash& sourceHash, int32 stateIndex, EInputSequenceTraceEvent traceEvent);
+
+/* Logs state event into InputSequence trace channel, enable it with -trace=cpu,inputsequence. Source hash of compiled data and state index identify graph node the state is compiled from */
+#define TRACE_INPUTSEQUENCE_STATE(Asset, SourceHash, StateIndex, Event) if (UE_TRACE_CHANNELEXPR_IS_ENABLED(InputSequenceChannel)) TraceInputSequenceState(Asset, SourceHash, StateIndex, EInputSequenceTraceEvent::Event)
+
+#else
+
+#define TRACE_INPUTSEQUENCE_STATE(Asset, SourceHash, StateIndex, Event)
+
+#endif
\ No newline at end of file
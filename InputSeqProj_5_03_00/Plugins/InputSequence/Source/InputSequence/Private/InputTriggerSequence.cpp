@@ -0,0 +1,137 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputTriggerSequence.h"
+#include "EnhancedPlayerInput.h"
+#include "InputAction.h"
+#include "GameFramework/PlayerController.h"
+
+void UInputTriggerSequence::InitInstance(const UEnhancedPlayerInput* PlayerInput)
+{
+	Instance = DuplicateObject<UInputSequenceAsset>(InputSequenceAsset, this);
+
+	NameSources.Reset();
+	ButtonActionSources.Reset();
+	TerminalStates.Reset();
+
+	const FInputSequenceCompiledData& compiledData = Instance->GetCompiledData();
+
+	// Key mappings are resolved once, rebinding keys of classic input during play is not picked up
+
+	for (int32 nameIndex = 0; nameIndex < compiledData.NumNames(); nameIndex++)
+	{
+		FNameSource nameSource;
+		nameSource.NameId = nameIndex;
+		nameSource.InputAction = Cast<UInputAction>(compiledData.GetNameInputAction(nameIndex));
+
+		if (!nameSource.InputAction)
+		{
+			for (const FInputActionKeyMapping& actionMapping : PlayerInput->GetKeysForAction(compiledData.GetName(nameIndex))) nameSource.ActionKeys.Add(actionMapping.Key);
+			for (const FInputAxisKeyMapping& axisMapping : PlayerInput->GetKeysForAxis(compiledData.GetName(nameIndex))) nameSource.AxisKeys.Add(TPair<FKey, float>(axisMapping.Key, axisMapping.Scale));
+		}
+
+		if (nameSource.InputAction && nameSource.InputAction->ValueType == EInputActionValueType::Boolean) ButtonActionSources.Add(nameSource.InputAction, NameSources.Num());
+
+		if (nameSource.InputAction || nameSource.ActionKeys.Num() > 0 || nameSource.AxisKeys.Num() > 0) NameSources.Add(MoveTemp(nameSource));
+	}
+
+	ButtonKeys.SetNum(NameSources.Num());
+
+	for (int32 stateIndex = 0; stateIndex < compiledData.NumStates(); stateIndex++)
+	{
+		if (compiledData.GetContext(compiledData.GetState(stateIndex).StateContextIndex) == TerminalStateContext) TerminalStates.Add(stateIndex);
+	}
+}
+
+ETriggerState UInputTriggerSequence::UpdateState_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue ModifiedValue, float DeltaTime)
+{
+	if (!InputSequenceAsset || !PlayerInput) return ETriggerState::None;
+
+	if (!Instance || Instance->GetOuter() != this) InitInstance(PlayerInput);
+
+	ActionInputs.Reset();
+	AxisInputs.Reset();
+
+	// Instance data of other actions may not be updated yet in this frame, button actions are read from their keys instead
+
+	if (ButtonActionSources.Num() > 0)
+	{
+		for (FButtonKeys& buttonKeys : ButtonKeys) buttonKeys = FButtonKeys();
+
+		for (const FEnhancedActionKeyMapping& mapping : PlayerInput->GetEnhancedActionMappings())
+		{
+			const int32* nameSourceIndex = ButtonActionSources.Find(mapping.Action.Get());
+
+			if (!nameSourceIndex) continue;
+
+			FButtonKeys& buttonKeys = ButtonKeys[*nameSourceIndex];
+			if (PlayerInput->IsPressed(mapping.Key)) buttonKeys.NumDown++;
+			if (PlayerInput->WasJustPressed(mapping.Key)) buttonKeys.NumJustPressed++;
+			if (PlayerInput->WasJustReleased(mapping.Key)) buttonKeys.NumJustReleased++;
+		}
+	}
+
+	for (int32 nameSourceIndex = 0; nameSourceIndex < NameSources.Num(); nameSourceIndex++)
+	{
+		const FNameSource& nameSource = NameSources[nameSourceIndex];
+
+		if (nameSource.InputAction)
+		{
+			if (nameSource.InputAction->ValueType == EInputActionValueType::Boolean)
+			{
+				// Action is pressed by first of its keys and released by last one
+
+				const FButtonKeys& buttonKeys = ButtonKeys[nameSourceIndex];
+				if (buttonKeys.NumJustPressed > 0 && buttonKeys.NumDown == buttonKeys.NumJustPressed) ActionInputs.Add({ nameSource.NameId, InputSequenceCore::EInputEvent::Pressed });
+				if (buttonKeys.NumJustReleased > 0 && buttonKeys.NumDown == 0) ActionInputs.Add({ nameSource.NameId, InputSequenceCore::EInputEvent::Released });
+			}
+			else if (const FInputActionInstance* actionInstance = PlayerInput->FindActionInstanceData(nameSource.InputAction))
+			{
+				const ETriggerEvent triggerEvent = actionInstance->GetTriggerEvent();
+				const bool bIsActuated = triggerEvent == ETriggerEvent::Triggered || triggerEvent == ETriggerEvent::Ongoing || triggerEvent == ETriggerEvent::Started;
+				const FVector axisValue = bIsActuated ? actionInstance->GetValue().Get<FVector>() : FVector::ZeroVector;
+				AxisInputs.Add({ nameSource.NameId, (float)axisValue.X, (float)axisValue.Y, (float)axisValue.Z });
+			}
+		}
+		else
+		{
+			for (const FKey& actionKey : nameSource.ActionKeys)
+			{
+				if (PlayerInput->WasJustPressed(actionKey)) { ActionInputs.Add({ nameSource.NameId, InputSequenceCore::EInputEvent::Pressed }); break; }
+				if (PlayerInput->WasJustReleased(actionKey)) { ActionInputs.Add({ nameSource.NameId, InputSequenceCore::EInputEvent::Released }); break; }
+			}
+
+			if (nameSource.AxisKeys.Num() > 0)
+			{
+				float axisValue = 0;
+
+				for (const TPair<FKey, float>& axisKey : nameSource.AxisKeys) axisValue += PlayerInput->GetKeyValue(axisKey.Key) * axisKey.Value;
+
+				AxisInputs.Add({ nameSource.NameId, axisValue });
+			}
+		}
+	}
+
+	EventCalls.Reset();
+	ResetSources.Reset();
+
+	APlayerController* playerController = PlayerInput->GetOuterAPlayerController();
+
+	Instance->OnNativeInput(DeltaTime, playerController && playerController->IsPaused(), ActionInputs, AxisInputs, EventCalls, ResetSources);
+
+	for (const FInputSequenceEventCall& eventCall : EventCalls)
+	{
+		UInputSequenceEvent::OnExecuteByClass(eventCall.EventClass, eventCall.Index, playerController, CallingContext, eventCall.Object, eventCall.Context, ResetSources);
+	}
+
+	for (uint16 passedState : Instance->GetPassedStates())
+	{
+		if (TerminalStates.Contains(passedState)) return ETriggerState::Triggered;
+	}
+
+	return ETriggerState::None;
+}
+
+FString UInputTriggerSequence::GetDebugState() const
+{
+	return Instance ? FString::Printf(TEXT("Sequence:%s Active:%d"), *InputSequenceAsset->GetName(), Instance->GetNumActiveStates()) : FString();
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include "Modules/ModuleManager.h"
 
+INPUTSEQUENCE_API DECLARE_LOG_CATEGORY_EXTERN(LogInputSequence, Log, All);
+
 class FInputSequenceModule : public IModuleInterface
 {
 public:
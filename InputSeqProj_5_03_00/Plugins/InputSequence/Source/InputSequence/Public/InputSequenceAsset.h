@@ -4,10 +4,55 @@
 
 #include "UObject/Object.h"
 #include "Templates/SubclassOf.h"
+#include "InputSequenceCompiledData.h"
 #include "InputSequenceAsset.generated.h"
 
 enum EInputEvent;
 class UEdGraph;
+class FInputSequenceRecordingWriter;
+
+/* Same values as InputSequenceCore::ERegionShape */
+UENUM()
+enum class EInputSequenceAxisRegionShape : uint8
+{
+	None = 0 UMETA(Hidden),
+	Box,
+	Sphere,
+	Cone,
+};
+
+/* Editor representation of region of 2D or 3D axis, compiled into InputSequenceCore::FCompactRegion */
+USTRUCT()
+struct INPUTSEQUENCE_API FInputSequenceAxisRegion
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	FInputSequenceAxisRegion() : Shape(EInputSequenceAxisRegionShape::Box), NumDimensions(3), A(0.5, -0.5, -1), B(1, 0.5, 1) {}
+
+	/* Pin default string of region */
+	FString ToString() const;
+
+	bool InitFromString(const FString& sourceString);
+
+	InputSequenceCore::FCompactRegion ToCompact() const;
+
+	UPROPERTY()
+		EInputSequenceAxisRegionShape Shape;
+
+	/* 2 or 3, Z of 2D regions is ignored */
+	UPROPERTY()
+		uint8 NumDimensions;
+
+	/* Box: min corner, Sphere: center, Cone: direction */
+	UPROPERTY()
+		FVector A;
+
+	/* Box: max corner, Sphere: X is radius, Cone: X is half angle in degrees, Y and Z are min and max length (max of zero is unbounded) */
+	UPROPERTY()
+		FVector B;
+};
 
 USTRUCT()
 struct INPUTSEQUENCE_API FInputActionState
@@ -17,41 +62,32 @@ struct INPUTSEQUENCE_API FInputActionState
 public:
 
 	FInputActionState(TArray<EInputEvent> inputEvents = {}, float x = 0, float y = 0, float z = INDEX_NONE, const FString subNameAString = "", const FString subNameBString = "")
-		: InputEvents(inputEvents), Index(INDEX_NONE), X(x), Y(y), Z(z), SubNameA(subNameAString.IsEmpty() ? NAME_None : FName(subNameAString)), SubNameB(subNameBString.IsEmpty() ? NAME_None : FName(subNameBString)) {}
+		: InputEvents(inputEvents), X(x), Y(y), Z(z), SubNameA(subNameAString.IsEmpty() ? NAME_None : FName(subNameAString)), SubNameB(subNameBString.IsEmpty() ? NAME_None : FName(subNameBString)), bIsRegionAxis(false) {}
 
-	bool IsOpen_Action() const { return !InputEvents.IsValidIndex(Index + 1); }
+	FInputActionState(const FInputSequenceAxisRegion& region)
+		: X(0), Y(0), Z(INDEX_NONE), SubNameA(NAME_None), SubNameB(NAME_None), bIsRegionAxis(true), Region(region) {}
 
-	bool ConsumeInput_Action(const EInputEvent inputEvent)
-	{
-		if (InputEvents.IsValidIndex(Index + 1) && InputEvents[Index + 1] == inputEvent) { Index++; return true; }
-		return false;
-	}
+	/* Gesture path over one 2D axis, or over pair of 1D axes if sub names are given */
+	FInputActionState(const TArray<FInputSequenceAxisRegion>& gestureSteps, float maxDuration, const FString subNameAString = "", const FString subNameBString = "")
+		: X(maxDuration), Y(0), Z(subNameAString.IsEmpty() ? INDEX_NONE : 0), SubNameA(subNameAString.IsEmpty() ? NAME_None : FName(subNameAString)), SubNameB(subNameBString.IsEmpty() ? NAME_None : FName(subNameBString)), bIsRegionAxis(false), GestureSteps(gestureSteps) {}
 
-	bool IsOpen_Axis() const { return Index >= 0; }
+	bool Is2DAxis() const { return Z >= 0; }
 
-	bool ConsumeInput_Axis(float axisValue)
-	{
-		if (X <= axisValue && axisValue <= Y) { Index++; return true; }
-		return false;
-	}
+	bool IsRegionAxis() const { return bIsRegionAxis; }
 
-	bool Is2DAxis() const { return Z >= 0; }
+	const FInputSequenceAxisRegion& GetRegion() const { return Region; }
 
-	bool ConsumeInput_2DAxis(float axisValueA, float axisValueB)
-	{
-		if (axisValueA * axisValueA + axisValueB * axisValueB <= Z * Z) return false;
+	bool IsGesture() const { return GestureSteps.Num() > 0; }
 
-		float axisAngleRad = FMath::Atan(axisValueB / axisValueA);		
-		if (axisValueA < 0) axisAngleRad += PI;
+	const TArray<FInputSequenceAxisRegion>& GetGestureSteps() const { return GestureSteps; }
 
-		while (axisAngleRad < X) axisAngleRad += TWO_PI;
+	const TArray<TEnumAsByte<EInputEvent>>& GetInputEvents() const { return InputEvents; }
 
-		if (X <= axisAngleRad && axisAngleRad <= Y) { Index++; return true; }
+	float GetX() const { return X; }
 
-		return false;
-	}
+	float GetY() const { return Y; }
 
-	void Reset() { Index = INDEX_NONE; }
+	float GetZ() const { return Z; }
 
 	const FName& GetSubNameA() const { return SubNameA; }
 
@@ -62,8 +98,6 @@ protected:
 	UPROPERTY()
 		TArray<TEnumAsByte<EInputEvent>> InputEvents;
 
-	int32 Index;
-
 	UPROPERTY()
 		float X;
 	UPROPERTY()
@@ -74,8 +108,15 @@ protected:
 		FName SubNameA;
 	UPROPERTY()
 		FName SubNameB;
+	UPROPERTY()
+		bool bIsRegionAxis;
+	UPROPERTY()
+		FInputSequenceAxisRegion Region;
+	UPROPERTY()
+		TArray<FInputSequenceAxisRegion> GestureSteps;
 };
 
+/* Editor representation of compiled state, it is packed into FInputSequenceCompiledData for runtime */
 USTRUCT()
 struct INPUTSEQUENCE_API FInputSequenceState
 {
@@ -91,17 +132,7 @@ public:
 
 	bool IsEmpty() const { return InputActions.Num() == 0; }
 
-	bool IsOpen() const;
-
-	bool ConsumeInput(const TMap<FName, TEnumAsByte<EInputEvent>> inputActionEvents, const TSet<FName>& pressedActions, const TMap<FName, float>& inputAxisEvents);
-
-	void Reset()
-	{
-		AccumulatedTime = 0;
-		for (TPair<FName, FInputActionState>& inputActionEntry : InputActions) inputActionEntry.Value.Reset();
-	}
-
-	float AccumulatedTime;
+	SIZE_T GetAllocatedSize() const;
 
 	UPROPERTY()
 		TMap<FName, FInputActionState> InputActions;
@@ -125,10 +156,16 @@ public:
 	UPROPERTY()
 		FString StateContext;
 
+	/* Enhanced Input Actions of InputActions entries that come from Enhanced Input */
+	UPROPERTY()
+		TMap<FName, TObjectPtr<UObject>> InputActionObjects;
+
 	UPROPERTY()
 		uint8 IsInputNode : 1;
 	UPROPERTY()
 		uint8 IsAxisNode : 1;
+	UPROPERTY()
+		uint8 IsGestureNode : 1;
 
 	UPROPERTY()
 		uint8 canBePassedAfterTime : 1;
@@ -203,16 +240,7 @@ class INPUTSEQUENCE_API UInputSequenceEvent : public UObject
 public:
 
 	UFUNCTION(BlueprintCallable, Category = "Input Sequence Event")
-		static void OnExecuteByClass(const TSubclassOf<UInputSequenceEvent>& eventClass, int32 index, UObject* callingObject, const FString& callingContext, UObject* stateObject, const FString& stateContext, const TArray<FInputSequenceResetSource>& resetSources)
-	{
-		if (eventClass)
-		{
-			if (UInputSequenceEvent* eventObject = eventClass->GetDefaultObject<UInputSequenceEvent>())
-			{
-				eventObject->NativeOnExecute(index, callingObject, callingContext, stateObject, stateContext, resetSources);
-			}
-		}
-	}
+		static void OnExecuteByClass(const TSubclassOf<UInputSequenceEvent>& eventClass, int32 index, UObject* callingObject, const FString& callingContext, UObject* stateObject, const FString& stateContext, const TArray<FInputSequenceResetSource>& resetSources);
 
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCosmetic, Category = "Input Sequence Event")
 		void OnExecute(int32 index, UObject* callingObject, const FString& callingContext, UObject* stateObject, const FString& stateContext, const TArray<FInputSequenceResetSource>& resetSources);
@@ -223,6 +251,16 @@ public:
 	}
 };
 
+class UInputSequenceAsset;
+
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FInputSequenceStateEventDelegate, UInputSequenceAsset*, uint16, InputSequenceCore::EStateEvent);
+
+#if WITH_EDITOR
+
+DECLARE_DELEGATE_OneParam(FInputSequenceCompileDelegate, UInputSequenceAsset*);
+
+#endif
+
 UCLASS(BlueprintType)
 class INPUTSEQUENCE_API UInputSequenceAsset : public UObject
 {
@@ -233,25 +271,84 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Input Sequence Asset")
 		void OnInput(const float DeltaTime, const bool bGamePaused, const TMap<FName, TEnumAsByte<EInputEvent>>& inputActionEvents, const TMap<FName, float>& inputAxisEvents, TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources);
 
+	/* Same as OnInput, but input comes as ids of compiled names (see GetCompiledData), so no name lookups are made */
+	void OnNativeInput(float DeltaTime, bool bGamePaused, TConstArrayView<InputSequenceCore::FActionInput> actionInputs, TConstArrayView<InputSequenceCore::FAxisInput> axisInputs, TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources);
+
+	/* Id of action or axis name for OnNativeInput: index in compiled names, or id past them for names compiled data does not know */
+	uint32 GetNameId(const FName& name);
+
 	UFUNCTION(BlueprintCallable, Category = "Input Sequence Asset")
 		void RequestReset(UObject* sourceObject, const FString& sourceContext);
 
 	UFUNCTION(BlueprintCallable, Category = "Input Sequence Asset")
 		void ClearInputStates();
 
-protected:
+	/* Starts recording of everything fed to this asset, previous recording is discarded */
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Asset")
+		void StartRecording();
+
+	/* Stops recording and saves it to file, returns false if recording was not started or file can't be written */
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Asset")
+		bool StopRecording(const FString& filePath);
+
+	bool IsRecording() const { return Recorder.IsValid(); }
+
+	virtual void PostLoad() override;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	void GetMemoryReport(FInputSequenceMemoryReport& outReport) const;
+
+	const FInputSequenceCompiledData& GetCompiledData() const { return CompiledData; }
+
+	int32 GetNumActiveStates() const { return (int32)Instance.GetNumActiveStates(); }
+
+	/* Called for every state entered, passed or reset during OnInput */
+	FInputSequenceStateEventDelegate& OnNativeStateEvent() { return NativeStateEvent; }
+
+	/* Indices of compiled states passed during last OnInput */
+	TConstArrayView<uint16> GetPassedStates() const { return MakeArrayView(Instance.GetPassedStates().data(), (int32)Instance.GetPassedStates().size()); }
+
+	/* Indices of compiled states active now, in order of activation */
+	TConstArrayView<uint16> GetActiveStates() const { return MakeArrayView(Instance.GetActiveStates().data(), (int32)Instance.GetActiveStates().size()); }
+
+	/* Time of active state and time it is waited for: until it can be passed or until it is reset. Returns false if state is not timed or not active */
+	bool GetStateTimer(int32 stateIndex, float& outTime, float& outTimeLimit) const;
+
+	/* Attaches debugger ring that evaluator writes state events into, nullptr detaches it. Ring must outlive attachment */
+	void SetDebugRing(InputSequenceCore::FDebugRing* debugRing) { Instance.SetDebugRing(debugRing); }
 
-	void MakeTransition(int32 fromIndex, const TSet<int32>& nextIndice, TArray<FInputSequenceEventCall>& outEventCalls);
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
 
-	void RequestResetWithNode(int32 nodeIndex, FInputSequenceState& state);
+	/* Attaches hit counters of compiled data while FInputSequenceHitCounters is started, detaches them otherwise */
+	void UpdateHitCounters();
 
-	void EnterNode(int32 nodeIndex, TArray<FInputSequenceEventCall>& outEventCalls);
+#endif
+
+#if WITH_EDITOR
+
+	virtual void BeginCacheForCookedPlatformData(const ITargetPlatform* TargetPlatform) override;
+
+	/* Packs editor States into compiled data used at runtime */
+	void RebuildCompiledData();
+
+	void SetCompiledData(const FInputSequenceCompiledData& compiledData);
+
+	/* Recompiles asset if compiled data is missing, made by other compiler version or made from other graph */
+	void CompileIfOutdated();
+
+	/* Compiles asset from its graph, bound by editor module. If not bound, compiled data is rebuilt from saved States */
+	static FInputSequenceCompileDelegate CompileDelegate;
+
+#endif
+
+protected:
 
-	void PassNode(int32 nodeIndex, TArray<FInputSequenceEventCall>& outEventCalls);
+	void EvaluateInput(float DeltaTime, bool bGamePaused, TConstArrayView<InputSequenceCore::FActionInput> actionInputs, TConstArrayView<InputSequenceCore::FAxisInput> axisInputs, TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources);
 
-	void ProcessResetSources(TArray<FInputSequenceEventCall>& outEventCalls, TArray<FInputSequenceResetSource>& outResetSources);
+	void ResetRuntimeStates();
 
-	void ProcessResetSources(bool& bResetAll, TSet<int32>& nodeSources, TSet<int32>& resetFLParents, TSet<int32>& checkFLParents, TArray<FInputSequenceResetSource>& outResetSources);
+	static void OnStateEvent(void* userData, uint16 stateIndex, InputSequenceCore::EStateEvent stateEvent);
 
 public:
 
@@ -260,19 +357,33 @@ public:
 	UPROPERTY()
 		UEdGraph* EdGraph;
 
-#endif
-
 	UPROPERTY()
 		TArray<FInputSequenceState> States;
 
+#endif
+
 protected:
 
+	UPROPERTY()
+		FInputSequenceCompiledData CompiledData;
+
+	InputSequenceCore::FInstance Instance;
+
+	TMap<FName, uint32> NameIds;
+
+	/* Per frame buffers passed to and from core evaluator, kept to reuse allocations */
+	std::vector<InputSequenceCore::FActionInput> ActionInputs;
+	std::vector<InputSequenceCore::FAxisInput> AxisInputs;
+	std::vector<InputSequenceCore::FEventCall> CoreEventCalls;
+	std::vector<InputSequenceCore::FResetSource> CoreResetSources;
+
 	mutable FCriticalSection resetSourcesCS;
 
-	TSet<int32> ActiveIndice;
+	TSharedPtr<FInputSequenceRecordingWriter> Recorder;
 
-	TSet<FName> PressedActions;
+	FInputSequenceStateEventDelegate NativeStateEvent;
 
+	/* External reset requests since last OnInput, core evaluator refers to them by index */
 	UPROPERTY()
 		TArray<FInputSequenceResetSource> ResetSources;
 
@@ -295,4 +406,12 @@ protected:
 	/* If true, active states will continue to tick even if Game is paused (Input Sequence Asset is ticking by OnInput method call) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Sequence Asset", meta = (DisplayPriority = 11))
 		uint8 bTickStatesWhenGamePaused : 1;
+
+	/* If true, axis values are quantized into zones that axis ranges of asset distinguish, only zone changes are evaluated and last zone is held while axis is not fed (axes of 2D pairs are not filtered) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Sequence Asset", meta = (DisplayPriority = 20))
+		uint8 bFilterAxisInput : 1;
+
+	/* Distance axis value must move past bounds of its current zone before zone is changed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Sequence Asset", meta = (DisplayPriority = 21, UIMin = 0, Min = 0, UIMax = 1, EditCondition = bFilterAxisInput, EditConditionHides))
+		float AxisHysteresis;
 };
\ No newline at end of file
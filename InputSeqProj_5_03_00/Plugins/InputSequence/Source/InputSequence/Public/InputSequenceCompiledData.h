@@ -0,0 +1,179 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "UObject/Object.h"
+#include "Templates/SubclassOf.h"
+#include "IO/IoHash.h"
+#include "InputSequenceCore.h"
+#include "InputSequenceCompiledData.generated.h"
+
+class UInputSequenceEvent;
+struct FInputSequenceState;
+
+/* Compact structs live in engine independent core, these are their engine side names */
+
+using EInputSequenceStateFlags = InputSequenceCore::EStateFlags;
+using FInputSequenceCompactAction = InputSequenceCore::FCompactAction;
+using FInputSequenceCompactState = InputSequenceCore::FCompactState;
+using FInputSequenceCompactEventList = InputSequenceCore::FCompactEventList;
+using FInputSequenceCompiledHeader = InputSequenceCore::FCompiledHeader;
+using FInputSequenceCompactRegion = InputSequenceCore::FCompactRegion;
+
+struct INPUTSEQUENCE_API FInputSequenceCustomVersion
+{
+	enum Type
+	{
+		BeforeCustomVersionWasAdded = 0,
+
+		// Compiled data is serialized as raw blob instead of tagged properties
+		CompiledDataBlob,
+
+		// Compiled data is stamped with compiler version and hash of States it was built from
+		CompilerVersionAndSourceHash,
+
+		// Compiled names keep Enhanced Input Actions they were made from
+		NameInputActions,
+
+		// Editor graph keeps hash it was last compiled from
+		CompiledGraphHash,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	const static FGuid GUID;
+
+private:
+	FInputSequenceCustomVersion() {}
+};
+
+struct FInputSequenceMemoryReport
+{
+	int32 NumStates = 0;
+
+	int32 NumActions = 0;
+
+	/* Bytes used by editor States array (not present in cooked builds) */
+	SIZE_T SourceBytes = 0;
+
+	/* Bytes used by compiled blob and its tables */
+	SIZE_T CompiledBytes = 0;
+
+	/* Bytes used by per-state runtime data of asset */
+	SIZE_T RuntimeBytes = 0;
+};
+
+USTRUCT()
+struct INPUTSEQUENCE_API FInputSequenceCompiledData
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	static constexpr uint32 Magic = InputSequenceCore::Magic;
+
+	static constexpr uint32 BlobVersion = InputSequenceCore::BlobVersion;
+
+	/* Version of graph compiler, bump on any change of how graph is compiled into States or how States are packed */
+	static constexpr uint32 CompilerVersion = 4;
+
+	bool IsValid() const { return GetView().IsValid(); }
+
+	bool IsUpToDate() const { return IsValid() && CompiledWithVersion == CompilerVersion; }
+
+	bool IsUpToDate(const FIoHash& sourceHash) const { return IsUpToDate() && SourceHash == sourceHash; }
+
+	const FIoHash& GetSourceHash() const { return SourceHash; }
+
+	/* View of blob evaluated by InputSequenceCore::FInstance, valid until compiled data is changed */
+	InputSequenceCore::FGraphView GetView() const { return InputSequenceCore::FGraphView(Blob.GetData(), Blob.Num()); }
+
+	int32 NumNames() const { return GetView().NumNames(); }
+
+	int32 NumStates() const { return GetView().NumStates(); }
+
+	int32 NumActions() const { return GetView().NumActions(); }
+
+	bool IsValidStateIndex(int32 index) const { return GetView().IsValidStateIndex(index); }
+
+	const FInputSequenceCompactState& GetState(int32 index) const { return GetView().GetState(index); }
+
+	const FInputSequenceCompactAction* GetActions(const FInputSequenceCompactState& state) const { return GetView().GetActions(state); }
+
+	TConstArrayView<uint16> GetNextIndice(const FInputSequenceCompactState& state) const { return ToArrayView(GetView().GetNextIndice(state)); }
+
+	TConstArrayView<uint16> GetPressedActions(const FInputSequenceCompactState& state) const { return ToArrayView(GetView().GetPressedActions(state)); }
+
+	TConstArrayView<uint16> GetEventList(uint16 eventListIndex) const { return ToArrayView(GetView().GetEventList(eventListIndex)); }
+
+	const FInputSequenceCompactRegion& GetRegion(uint16 regionIndex) const { return GetView().GetRegion(regionIndex); }
+
+	const FName& GetName(uint16 index) const { return Names[index]; }
+
+	const FString& GetContext(uint16 index) const { return Contexts[index]; }
+
+	UObject* GetObject(uint16 index) const { return index == FInputSequenceCompactState::IndexNone ? nullptr : Objects[index].Get(); }
+
+	TSubclassOf<UInputSequenceEvent> GetEventClass(uint16 index) const { return EventClasses[index]; }
+
+	/* Enhanced Input Action of compiled name, nullptr for names of classic input */
+	UObject* GetNameInputAction(uint16 index) const { return InputActions.IsValidIndex(index) ? InputActions[index].Get() : nullptr; }
+
+	SIZE_T GetAllocatedSize() const;
+
+	bool Serialize(FArchive& Ar);
+
+	void Reset();
+
+#if WITH_EDITOR
+
+	bool Build(const TArray<FInputSequenceState>& states);
+
+	/* Deterministic hash of everything in States that affects compiled data */
+	static FIoHash HashSource(const TArray<FInputSequenceState>& states);
+
+#endif
+
+protected:
+
+	static TConstArrayView<uint16> ToArrayView(InputSequenceCore::TSpan<uint16_t> span) { return MakeArrayView(span.Data, (int32)span.Size); }
+
+	/* Checks that all sections and indices of loaded blob are in bounds, so evaluation never reads outside of it */
+	bool ValidateBlob() const;
+
+	/* Header, states, actions, event lists and index pool laid out in one allocation */
+	UPROPERTY()
+		TArray<uint8> Blob;
+
+	UPROPERTY()
+		TArray<FName> Names;
+
+	/* String table for State contexts, index 0 is always empty string */
+	UPROPERTY()
+		TArray<FString> Contexts;
+
+	UPROPERTY()
+		TArray<TObjectPtr<UObject>> Objects;
+
+	UPROPERTY()
+		TArray<TSubclassOf<UInputSequenceEvent>> EventClasses;
+
+	/* Parallel to Names, empty if no names come from Enhanced Input */
+	UPROPERTY()
+		TArray<TObjectPtr<UObject>> InputActions;
+
+	UPROPERTY()
+		uint32 CompiledWithVersion = 0;
+
+	FIoHash SourceHash;
+};
+
+template<>
+struct TStructOpsTypeTraits<FInputSequenceCompiledData> : public TStructOpsTypeTraitsBase2<FInputSequenceCompiledData>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
+};
\ No newline at end of file
@@ -0,0 +1,674 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+// Engine independent part of Input Sequence: compiled graph data model and its evaluator.
+// Uses only standard C++17, so it can be built and profiled outside of engine. UInputSequenceAsset wraps it.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Per state hit counters, set by build rules of module to be compiled out of shipping builds
+#ifndef INPUTSEQUENCE_WITH_HIT_COUNTERS
+#define INPUTSEQUENCE_WITH_HIT_COUNTERS 1
+#endif
+
+namespace InputSequenceCore
+{
+	enum class EStateFlags : uint8_t
+	{
+		None = 0,
+		InputNode = 1 << 0,
+		AxisNode = 1 << 1,
+		CanBePassedAfterTime = 1 << 2,
+		OverridingResetAfterTime = 1 << 3,
+		ResetAfterTime = 1 << 4,
+		OverridingRequirePreciseMatch = 1 << 5,
+		RequirePreciseMatch = 1 << 6,
+		GestureNode = 1 << 7,
+	};
+
+	inline constexpr EStateFlags operator|(EStateFlags lhs, EStateFlags rhs) { return (EStateFlags)((uint8_t)lhs | (uint8_t)rhs); }
+
+	inline constexpr EStateFlags operator&(EStateFlags lhs, EStateFlags rhs) { return (EStateFlags)((uint8_t)lhs & (uint8_t)rhs); }
+
+	inline EStateFlags& operator|=(EStateFlags& lhs, EStateFlags rhs) { return lhs = lhs | rhs; }
+
+	/* Same values as EInputEvent of engine */
+	enum class EInputEvent : uint8_t
+	{
+		Pressed = 0,
+		Released = 1,
+		Repeat = 2,
+		DoubleClick = 3,
+		Axis = 4,
+	};
+
+	enum class EStateEvent : uint8_t
+	{
+		Enter,
+		Pass,
+		Reset
+	};
+
+	/* Shape of compiled region of 2D or 3D axis */
+	enum class ERegionShape : uint8_t
+	{
+		None = 0,
+		Box,
+		Sphere,
+		Cone,
+	};
+
+	/*
+	* Region of 2D or 3D axis value, stored in its own 16 byte aligned section of blob as two float4 and tested in place with scalar math.
+	* Box: A is min corner, B is max corner. Sphere: A is center, A[3] is radius. Cone: A is unit direction, A[3] is cosine of half angle, B[0] and B[1] are min and max length.
+	* 2D regions are compiled with zero Z, values of 2D axes come with zero Z as well
+	*/
+	struct alignas(16) FCompactRegion
+	{
+		bool Contains(ERegionShape shape, float x, float y, float z) const;
+
+		float A[4];
+		float B[4];
+	};
+
+	/* Compiled Input Action of some state, stored in place inside of compiled blob */
+	struct FCompactAction
+	{
+		/* 2D sector of two 1D axes (SubNameA and SubNameB) */
+		bool Is2DAxis() const { return Z >= 0; }
+
+		/* Region of one 2D or 3D axis (NameIndex). Actions of gesture nodes are regions too, one per step of their path */
+		bool IsRegionAxis() const { return RegionShape != ERegionShape::None; }
+
+		bool IsOpen_Gesture(uint8_t progress) const { return progress >= NumRegions; }
+
+		bool IsOpen_Action(uint8_t progress) const { return progress >= NumInputEvents; }
+
+		bool IsOpen_Axis(uint8_t progress) const { return progress > 0; }
+
+		bool ConsumeInput_Action(uint8_t& progress, uint8_t inputEvent) const;
+
+		bool ConsumeInput_Axis(uint8_t& progress, float axisValue) const;
+
+		bool ConsumeInput_2DAxis(uint8_t& progress, float axisValueA, float axisValueB) const;
+
+		bool ConsumeInput_Region(uint8_t& progress, const FCompactRegion& region, float axisValueX, float axisValueY, float axisValueZ) const;
+
+		float X;
+		float Y;
+		float Z;
+
+		uint16_t NameIndex;
+		uint16_t SubNameAIndex;
+		uint16_t SubNameBIndex;
+
+		uint16_t RegionIndex;
+
+		uint8_t NumInputEvents;
+		uint8_t InputEvents[3];
+
+		ERegionShape RegionShape;
+
+		/* Consecutive regions from RegionIndex, 1 for region axis or number of steps for gesture */
+		uint8_t NumRegions;
+	};
+
+	/* Compiled state, stored in place inside of compiled blob. Variable sized parts are offsets into shared pools of the same blob */
+	struct FCompactState
+	{
+		static constexpr uint16_t IndexNone = 0xFFFF;
+
+		bool IsStartNode() const { return FirstLayerParentIndex == IndexNone; }
+
+		bool IsFirstLayer() const { return FirstLayerParentIndex == 0; }
+
+		bool IsEmpty() const { return NumActions == 0; }
+
+		int32_t GetFirstLayerParentIndex() const { return FirstLayerParentIndex == IndexNone ? -1 : FirstLayerParentIndex; }
+
+		bool HasFlag(EStateFlags flag) const { return (Flags & flag) != EStateFlags::None; }
+
+		bool IsInputNode() const { return HasFlag(EStateFlags::InputNode); }
+
+		bool IsAxisNode() const { return HasFlag(EStateFlags::AxisNode); }
+
+		bool IsGestureNode() const { return HasFlag(EStateFlags::GestureNode); }
+
+		float TimeParam;
+
+		uint32_t FirstAction;
+		uint32_t FirstNext;
+		uint32_t FirstPressed;
+
+		uint16_t NumNext;
+		uint16_t FirstLayerParentIndex;
+		uint16_t DepthIndex;
+
+		uint16_t EnterEventList;
+		uint16_t PassEventList;
+		uint16_t ResetEventList;
+
+		uint16_t StateObjectIndex;
+		uint16_t StateContextIndex;
+
+		uint8_t NumActions;
+		uint8_t NumPressed;
+
+		EStateFlags Flags;
+
+		uint8_t Padding;
+	};
+
+	/* Pooled list of Event Classes. Identical lists of different states share one entry */
+	struct FCompactEventList
+	{
+		uint32_t FirstEvent;
+		uint32_t NumEvents;
+	};
+
+	/* Blob is position independent: all sections are addressed by offsets from its start, so it can be used in place wherever it is loaded or mapped */
+	struct FCompiledHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+
+		uint32_t NumNames;
+
+		uint32_t NumStates;
+		uint32_t StatesOffset;
+
+		uint32_t NumActions;
+		uint32_t ActionsOffset;
+
+		uint32_t NumEventLists;
+		uint32_t EventListsOffset;
+
+		uint32_t NumIndices;
+		uint32_t IndicesOffset;
+
+		uint32_t NumRegions;
+		uint32_t RegionsOffset;
+	};
+
+	static_assert(sizeof(FCompactAction) == 28, "FCompactAction is expected to be packed into 28 bytes");
+	static_assert(sizeof(FCompactRegion) == 32 && alignof(FCompactRegion) == 16, "FCompactRegion is expected to be two aligned float4");
+	static_assert(sizeof(FCompactState) == 36, "FCompactState is expected to be packed into 36 bytes");
+
+	constexpr uint32_t Magic = 0x51534E49; // "INSQ"
+
+	/* Layout version of blob sections, bump on any change of compact structs */
+	constexpr uint32_t BlobVersion = 4;
+
+	template<typename T>
+	struct TSpan
+	{
+		const T* begin() const { return Data; }
+
+		const T* end() const { return Data + Size; }
+
+		const T& operator[](size_t index) const { return Data[index]; }
+
+		size_t Num() const { return Size; }
+
+		const T* Data;
+		size_t Size;
+	};
+
+	/* Read only view of compiled blob, does not own memory */
+	class FGraphView
+	{
+	public:
+
+		FGraphView() : Data(nullptr), Size(0) {}
+
+		FGraphView(const uint8_t* data, size_t size) : Data(data), Size(size) {}
+
+		bool IsValid() const { return Size >= sizeof(FCompiledHeader) && GetHeader().Magic == Magic && GetHeader().Version == BlobVersion; }
+
+		/* Checks that all sections and indices are in bounds of blob and of tables it refers to */
+		bool Validate(size_t numNames, size_t numObjects, size_t numContexts, size_t numEventClasses) const;
+
+		int32_t NumNames() const { return IsValid() ? (int32_t)GetHeader().NumNames : 0; }
+
+		int32_t NumStates() const { return IsValid() ? (int32_t)GetHeader().NumStates : 0; }
+
+		int32_t NumActions() const { return IsValid() ? (int32_t)GetHeader().NumActions : 0; }
+
+		bool IsValidStateIndex(int32_t index) const { return 0 <= index && index < NumStates(); }
+
+		const FCompactState& GetState(int32_t index) const { return GetSection<FCompactState>(GetHeader().StatesOffset)[index]; }
+
+		const FCompactAction* GetActions(const FCompactState& state) const { return GetSection<FCompactAction>(GetHeader().ActionsOffset) + state.FirstAction; }
+
+		TSpan<uint16_t> GetNextIndice(const FCompactState& state) const { return { GetSection<uint16_t>(GetHeader().IndicesOffset) + state.FirstNext, state.NumNext }; }
+
+		TSpan<uint16_t> GetPressedActions(const FCompactState& state) const { return { GetSection<uint16_t>(GetHeader().IndicesOffset) + state.FirstPressed, state.NumPressed }; }
+
+		TSpan<uint16_t> GetEventList(uint16_t eventListIndex) const;
+
+		const FCompactRegion& GetRegion(uint16_t regionIndex) const { return GetSection<FCompactRegion>(GetHeader().RegionsOffset)[regionIndex]; }
+
+		const FCompiledHeader& GetHeader() const { return *reinterpret_cast<const FCompiledHeader*>(Data); }
+
+	protected:
+
+		template<typename T>
+		const T* GetSection(uint32_t offset) const { return reinterpret_cast<const T*>(Data + offset); }
+
+		const uint8_t* Data;
+
+		size_t Size;
+	};
+
+	struct FActionInput
+	{
+		/* Name index of compiled graph, any index past its names is an action that graph does not know */
+		uint32_t NameId;
+
+		EInputEvent Event;
+	};
+
+	struct FAxisInput
+	{
+		uint32_t NameId;
+
+		float Value;
+
+		/* Other components of 2D and 3D axes, 1D axes leave them zero */
+		float ValueY = 0;
+		float ValueZ = 0;
+	};
+
+	struct FEventCall
+	{
+		uint16_t StateIndex;
+
+		uint16_t EventClassIndex;
+	};
+
+	struct FResetSource
+	{
+		/* State that requested reset, -1 for external request */
+		int32_t SourceIndex = -1;
+
+		/* Caller defined id of external request */
+		uint32_t ExternalId = 0;
+	};
+
+	struct FSettings
+	{
+		float ResetAfterTime = 0.2f;
+
+		bool bRequirePreciseMatch = false;
+
+		bool bIsResetAfterTime = false;
+
+		bool bStepFromStatesWhenGamePaused = false;
+
+		bool bTickStatesWhenGamePaused = false;
+
+		/*
+		* Axis values are quantized into zones that compiled 1D axis ranges distinguish. Filtered axis has input only on frames its zone changes,
+		* 1D ranges are matched against held value of its last zone instead, which stays until instance is reset or filter is toggled
+		*/
+		bool bFilterAxisInput = false;
+
+		/* Distance axis value must move past bounds of its current zone before zone is changed */
+		float AxisHysteresis = 0;
+	};
+
+	/* Counters of last OnInput call */
+	struct FFrameStats
+	{
+		uint32_t Transitions = 0;
+
+		uint32_t Resets = 0;
+
+		uint32_t EventCalls = 0;
+
+		uint32_t AxisZoneChanges = 0;
+	};
+
+	struct FDebugRecord
+	{
+		/* Counter of OnInput calls that record was written in */
+		uint32_t Frame;
+
+		uint16_t StateIndex;
+
+		EStateEvent Event;
+	};
+
+	/* Fixed size ring of state events for debuggers. One writer (evaluator) and one reader that polls at its own rate, without locks.
+	Writer never waits: records reader did not get to in time are overwritten, and reader detects and drops them */
+	class FDebugRing
+	{
+	public:
+
+		static constexpr uint32_t Capacity = 1024;
+
+		void BeginFrame() { Frame.store(Frame.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+		void Write(uint16_t stateIndex, EStateEvent stateEvent);
+
+		/* Appends records written since readIndex and advances it. Returns number of records that were overwritten before they could be read */
+		uint64_t Read(uint64_t& readIndex, std::vector<FDebugRecord>& outRecords) const;
+
+		uint32_t GetFrame() const { return Frame.load(std::memory_order_relaxed); }
+
+	protected:
+
+		/* Record packed as Frame | StateIndex << 32 | Event << 48, so slots can be read while they are written */
+		std::atomic<uint64_t> Records[Capacity] = {};
+
+		/* Records are reserved before slot is written and committed after, reader trusts slots that were not reserved again while it copied them */
+		std::atomic<uint64_t> ReservedIndex{ 0 };
+		std::atomic<uint64_t> CommittedIndex{ 0 };
+
+		std::atomic<uint32_t> Frame{ 0 };
+	};
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+
+	/* Counts of state events per state of one compiled graph, shared by all instances evaluating it. Instances may run on different threads,
+	so event is counted with one relaxed increment: counts are exact once instances are done, reader polling them may be a few events behind */
+	class FHitCounters
+	{
+	public:
+
+		static constexpr size_t NumEvents = 3;
+
+		explicit FHitCounters(size_t numStates);
+
+		size_t GetNumStates() const { return NumStates; }
+
+		void Add(uint16_t stateIndex, EStateEvent stateEvent)
+		{
+			if (stateIndex < NumStates) Counters[stateIndex * NumEvents + (size_t)stateEvent].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		uint64_t Get(size_t stateIndex, EStateEvent stateEvent) const;
+
+		/* Adds counts made elsewhere, e.g. loaded from file */
+		void Append(size_t stateIndex, EStateEvent stateEvent, uint64_t count);
+
+		void Reset();
+
+	protected:
+
+		size_t NumStates;
+
+		std::unique_ptr<std::atomic<uint64_t>[]> Counters;
+	};
+
+#endif
+
+	/* Runtime state of one sequence over some compiled graph. Not thread safe */
+	class FInstance
+	{
+	public:
+
+		typedef void (*FStateEventCallback)(void* userData, uint16_t stateIndex, EStateEvent stateEvent);
+
+		/* Drops all runtime state, must be called when graph is changed */
+		void Reset(const FGraphView& graph);
+
+		void OnInput(const FGraphView& graph, const FSettings& settings, float deltaTime, bool bGamePaused, const FActionInput* actionInputs, size_t numActionInputs, const FAxisInput* axisInputs, size_t numAxisInputs, std::vector<FEventCall>& outEventCalls, std::vector<FResetSource>& outResetSources);
+
+		void RequestReset(uint32_t externalId);
+
+		void ClearPressedActions();
+
+		size_t GetNumActiveStates() const { return ActiveStates.size(); }
+
+		const std::vector<uint16_t>& GetActiveStates() const { return ActiveStates; }
+
+		/* States passed during last OnInput call, in order of passing */
+		const std::vector<uint16_t>& GetPassedStates() const { return PassedStates; }
+
+		const FFrameStats& GetFrameStats() const { return FrameStats; }
+
+		size_t GetAllocatedSize() const;
+
+		void SetStateEventCallback(FStateEventCallback callback, void* userData) { StateEventCallback = callback; StateEventUserData = userData; }
+
+		/* Ring is not owned, nullptr detaches debugger. Detached instance pays only for null checks */
+		void SetDebugRing(FDebugRing* ring) { DebugRing = ring; }
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+
+		/* Counters are not owned and must be made for the same graph, nullptr stops counting */
+		void SetHitCounters(FHitCounters* hitCounters) { HitCounters = hitCounters; }
+
+#endif
+
+		/* Time since last successful step of state */
+		float GetStateTime(int32_t stateIndex) const { return 0 <= stateIndex && stateIndex < (int32_t)StateTimes.size() ? StateTimes[stateIndex] : 0; }
+
+		bool IsStateActive(int32_t stateIndex) const { return 0 <= stateIndex && stateIndex < (int32_t)IsActiveFlags.size() && IsActive(stateIndex); }
+
+	protected:
+
+		void SetFrameInput(const FActionInput* actionInputs, size_t numActionInputs, const FAxisInput* axisInputs, size_t numAxisInputs, bool bSet);
+
+		void BuildAxisZones(const FGraphView& graph);
+
+		void ClearAxisZones();
+
+		bool IsFilteredAxis(uint32_t nameId) const { return AxisBoundaryOffsets[nameId + 1] > AxisBoundaryOffsets[nameId]; }
+
+		/* Returns true if zone of axis is changed, input of axis in current frame and its held value are set then */
+		bool UpdateAxisZone(uint32_t nameId, float axisValue);
+
+		bool IsActive(int32_t stateIndex) const { return IsActiveFlags[stateIndex] != 0; }
+
+		void AddActive(int32_t stateIndex);
+
+		void RemoveActive(int32_t stateIndex);
+
+		bool IsPressed(uint32_t nameId) const { return nameId < IsPressedFlags.size() && IsPressedFlags[nameId] != 0; }
+
+		void ResetState(int32_t stateIndex, const FCompactState& state);
+
+		bool IsStateOpen(const FGraphView& graph, const FCompactState& state) const;
+
+		bool HasInputAction(const FGraphView& graph, const FCompactState& state, uint32_t nameId) const;
+
+		bool HasPressedAction(const FGraphView& graph, const FCompactState& state, uint32_t nameId) const;
+
+		bool ConsumeInput(const FGraphView& graph, int32_t stateIndex, const FCompactState& state);
+
+		/* Advances path of gesture action by one stick sample, returns true if next step of path is reached */
+		bool ConsumeInput_Gesture(const FGraphView& graph, uint32_t actionIndex, const FCompactAction& action, uint8_t& progress);
+
+		void AddEventCalls(const FGraphView& graph, uint16_t eventListIndex, int32_t stateIndex, std::vector<FEventCall>& outEventCalls);
+
+		void MakeTransition(const FGraphView& graph, int32_t fromIndex, TSpan<uint16_t> nextIndice, std::vector<FEventCall>& outEventCalls);
+
+		void RequestResetWithNode(int32_t nodeIndex, const FCompactState& state);
+
+		void EnterNode(const FGraphView& graph, int32_t nodeIndex, std::vector<FEventCall>& outEventCalls);
+
+		void PassNode(const FGraphView& graph, int32_t nodeIndex, std::vector<FEventCall>& outEventCalls);
+
+		void ProcessResetSources(const FGraphView& graph, std::vector<FEventCall>& outEventCalls, std::vector<FResetSource>& outResetSources);
+
+		void NotifyStateEvent(int32_t stateIndex, EStateEvent stateEvent) const
+		{
+			if (StateEventCallback) StateEventCallback(StateEventUserData, (uint16_t)stateIndex, stateEvent);
+			if (DebugRing) DebugRing->Write((uint16_t)stateIndex, stateEvent);
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+			if (HitCounters) HitCounters->Add((uint16_t)stateIndex, stateEvent);
+#endif
+		}
+
+		/* Time since last successful step, per compiled state */
+		std::vector<float> StateTimes;
+
+		/* Count of consumed input events, per compiled action */
+		std::vector<uint8_t> ActionProgress;
+
+		/* Per action, time since first step of gesture path was reached. Only gesture actions use it */
+		std::vector<float> GestureTimes;
+
+		/* Active states in order of activation, with flags per compiled state for lookups */
+		std::vector<uint16_t> ActiveStates;
+		std::vector<uint8_t> IsActiveFlags;
+
+		std::vector<uint32_t> PressedActions;
+		std::vector<uint8_t> IsPressedFlags;
+
+		std::vector<FResetSource> ResetSources;
+
+		std::vector<uint16_t> PassedStates;
+
+		/* Input of current frame, per compiled name */
+		std::vector<uint8_t> FrameActionEvents;
+		std::vector<float> FrameAxisValues;
+		std::vector<float> FrameAxisValuesY;
+		std::vector<float> FrameAxisValuesZ;
+		std::vector<uint8_t> HasFrameAxisValues;
+
+		/* Value of last zone per filtered axis, read by 1D ranges on every frame. Frame input of filtered axis is set only when its zone changes */
+		std::vector<float> AxisHeldValues;
+		std::vector<uint8_t> HasAxisHeldValues;
+
+		/* Sorted range bounds per compiled name, empty for names that are not filtered (used by 2D sectors, by regions or not by axes at all) */
+		std::vector<uint32_t> AxisBoundaryOffsets;
+		std::vector<float> AxisBoundaries;
+
+		/* Current zone per compiled name, -1 if unknown. Zone 2 * i is interval below bound i, zone 2 * i + 1 is bound i itself */
+		std::vector<int32_t> AxisZones;
+
+		bool bIsAxisFilterActive = false;
+
+		float AxisHysteresis = 0;
+
+		float FrameDeltaTime = 0;
+
+		/* Scratch buffers reused between frames */
+		std::vector<uint16_t> PrevActiveStates;
+		std::vector<int32_t> NodeSources;
+		std::vector<int32_t> ResetFLParents;
+		std::vector<int32_t> CheckFLParents;
+		std::vector<uint16_t> TransitionIndice;
+
+		FFrameStats FrameStats;
+
+		FStateEventCallback StateEventCallback = nullptr;
+
+		void* StateEventUserData = nullptr;
+
+		FDebugRing* DebugRing = nullptr;
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+		FHitCounters* HitCounters = nullptr;
+#endif
+	};
+
+	/* Bits of input stream, written in order from lowest bit of first byte */
+	class FBitWriter
+	{
+	public:
+
+		void Reset() { Data.clear(); NumBits = 0; }
+
+		void Write(uint32_t value, uint32_t numBits);
+
+		const std::vector<uint8_t>& GetData() const { return Data; }
+
+		size_t GetNumBits() const { return NumBits; }
+
+	protected:
+
+		std::vector<uint8_t> Data;
+
+		size_t NumBits = 0;
+	};
+
+	class FBitReader
+	{
+	public:
+
+		FBitReader(const uint8_t* data, size_t numBytes) : Data(data), NumBits(numBytes * 8) {}
+
+		/* Returns false if stream is exhausted, reader stays in error state then */
+		bool Read(uint32_t& outValue, uint32_t numBits);
+
+		bool IsError() const { return bIsError; }
+
+	protected:
+
+		const uint8_t* Data;
+
+		size_t NumBits;
+
+		size_t Offset = 0;
+
+		bool bIsError = false;
+	};
+
+	/*
+	* Input of one instance, quantized and bit-packed per frame, so it can be sent every frame and replayed by other side exactly.
+	* Actions are written as name index and event, events that are not action events (e.g. Axis) are dropped. Axes are written only as much as compiled graph distinguishes them: zone of 1D ranges, or fixed point components for 2D sectors and regions.
+	* Axis values are written only when changed, so both sides must process every frame in order. Writing side must evaluate quantized input it gets back, not original one
+	*/
+	class FInputStreamCodec
+	{
+	public:
+
+		void Reset(const FGraphView& graph);
+
+		void Write(const FGraphView& graph, const FActionInput* actionInputs, size_t numActionInputs, const FAxisInput* axisInputs, size_t numAxisInputs, FBitWriter& writer, std::vector<FActionInput>& outActionInputs, std::vector<FAxisInput>& outAxisInputs);
+
+		bool Read(const FGraphView& graph, FBitReader& reader, std::vector<FActionInput>& outActionInputs, std::vector<FAxisInput>& outAxisInputs);
+
+		void WritePassedStates(const FGraphView& graph, const uint16_t* stateIndice, size_t numStateIndice, FBitWriter& writer) const;
+
+		bool ReadPassedStates(const FGraphView& graph, FBitReader& reader, std::vector<uint16_t>& outStateIndice) const;
+
+		/* Delta time is sent with 0.1 ms precision, value is replaced by quantized one */
+		static void WriteDeltaTime(FBitWriter& writer, float& inOutDeltaTime);
+
+		static bool ReadDeltaTime(FBitReader& reader, float& outDeltaTime);
+
+	protected:
+
+		struct FStreamAxis
+		{
+			uint32_t NameId;
+
+			uint32_t FirstBound;
+			uint32_t NumBounds;
+
+			/* Zero for 1D ranges written as zone, otherwise number of fixed point components */
+			uint32_t NumComponents;
+
+			/* Last written zone or components, -1 before first write */
+			int32_t LastCodes[3];
+		};
+
+		void ApplyCodes(const FStreamAxis& streamAxis, const int32_t* codes, std::vector<FAxisInput>& outAxisInputs) const;
+
+		uint32_t NumNames = 0;
+
+		uint32_t NameBits = 0;
+
+		std::vector<FStreamAxis> Axes;
+
+		/* Per compiled name, index of axis in Axes or -1 */
+		std::vector<int32_t> AxisSlots;
+
+		std::vector<uint32_t> AxisBoundaryOffsets;
+		std::vector<float> AxisBoundaries;
+
+		/* Scratch buffer, last axis input of frame per entry of Axes */
+		std::vector<int32_t> FrameAxisInputs;
+	};
+}
\ No newline at end of file
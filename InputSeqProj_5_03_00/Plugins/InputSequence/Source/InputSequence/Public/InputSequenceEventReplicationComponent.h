@@ -0,0 +1,93 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "InputSequenceAsset.h"
+#include "InputSequenceEventReplicationComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class EInputSequenceReplicatedEvent : uint8
+{
+	Enter,
+	Pass,
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FInputSequenceReplicatedEventDelegate, UInputSequenceAsset*, asset, int32, stateIndex, EInputSequenceReplicatedEvent, stateEvent, int32, frameOffset);
+
+/*
+* Replicates entered and passed states of Input Sequence instances evaluated on server to simulated proxies of owner, for VFX and animation.
+* Records made between net updates of owner are sent as one bit-packed batch of asset index, state index, kind and frame offset. Receivers expand them into Event Calls with the same assets, so no classes, objects or strings are sent
+*/
+UCLASS(ClassGroup = Input, meta = (BlueprintSpawnableComponent))
+class INPUTSEQUENCE_API UInputSequenceEventReplicationComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/* Server only. State events of instance are replicated as events of asset at given index */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Input Sequence Event Replication")
+		void ReplicateInstance(int32 assetIndex, UInputSequenceAsset* instance);
+
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Input Sequence Event Replication")
+		void StopReplicatingInstance(UInputSequenceAsset* instance);
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/* Simulated proxies only. Called for every received record after Event Calls of its state are executed, frame offset is counted in server frames from first record of batch */
+	UPROPERTY(BlueprintAssignable, Category = "Input Sequence Event Replication")
+		FInputSequenceReplicatedEventDelegate OnReplicatedStateEvent;
+
+protected:
+
+	UFUNCTION(NetMulticast, Unreliable)
+		void MulticastStateEvents(const TArray<uint8>& batchData);
+
+	void OnInstanceStateEvent(UInputSequenceAsset* instance, uint16 stateIndex, InputSequenceCore::EStateEvent stateEvent, int32 assetIndex);
+
+	void FlushRecords();
+
+	/* Same assets must be set on server and on clients, records refer to their compiled states by index */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input Sequence Event Replication")
+		TArray<TObjectPtr<UInputSequenceAsset>> InputSequenceAssets;
+
+	/* If true, receivers execute Event Calls of replicated states with owner as calling object */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Sequence Event Replication")
+		bool bExecuteEvents;
+
+	/* Calling context passed to executed events */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Sequence Event Replication")
+		FString CallingContext;
+
+	struct FRecord
+	{
+		int32 AssetIndex;
+
+		uint16 StateIndex;
+
+		EInputSequenceReplicatedEvent Kind;
+
+		uint64 Frame;
+	};
+
+	struct FReplicatedInstance
+	{
+		TWeakObjectPtr<UInputSequenceAsset> Instance;
+
+		FDelegateHandle Handle;
+	};
+
+	/* Records since last net update of owner */
+	TArray<FRecord> Records;
+
+	TArray<FReplicatedInstance> ReplicatedInstances;
+
+	double LastFlushTime;
+
+	InputSequenceCore::FBitWriter BatchWriter;
+
+	TArray<FInputSequenceEventCall> EventCalls;
+};
\ No newline at end of file
@@ -0,0 +1,83 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "InputSequenceCore.h"
+
+struct FInputSequenceCompiledData;
+
+#if INPUTSEQUENCE_WITH_HIT_COUNTERS
+
+/* Hit counts of one compiled graph, as they are saved to file */
+struct FInputSequenceHitCountersRecord
+{
+	FString AssetName;
+
+	/* Enter, Pass and Reset counts per compiled state, in order of InputSequenceCore::EStateEvent */
+	TArray<uint64> Counts;
+
+	int32 NumStates() const { return Counts.Num() / InputSequenceCore::FHitCounters::NumEvents; }
+
+	uint64 Get(int32 stateIndex, InputSequenceCore::EStateEvent stateEvent) const { return Counts[stateIndex * InputSequenceCore::FHitCounters::NumEvents + (int32)stateEvent]; }
+};
+
+/*
+ * Collects hit counts of every evaluated Input Sequence Asset while started, see InputSequence.HitCounters console command.
+ * Counters are kept per source hash of compiled data, so all runtime instances of asset (every player, every Play In Editor client) count into the same counters,
+ * and saved counts stay tied to graph version they were made with.
+ */
+class INPUTSEQUENCE_API FInputSequenceHitCounters
+{
+public:
+
+	static FInputSequenceHitCounters& Get();
+
+	/* Attaches counters to every loaded asset, assets that are loaded or recompiled later attach themselves */
+	void Start();
+
+	/* Detaches counters from assets, counts are kept */
+	void Stop();
+
+	bool IsStarted() const { return bIsStarted; }
+
+	/* Zeroes all counts, counters stay attached. Counts saved so far stay in file */
+	void Reset();
+
+	/* Counters of compiled data, made on first request. Counters are never freed, so instances may keep pointer to them */
+	InputSequenceCore::FHitCounters* FindOrAdd(const FInputSequenceCompiledData& compiledData, const FString& assetName);
+
+	/* Copies counts made so far for compiled data with source hash, returns false if there are none */
+	bool GetRecord(const FIoHash& sourceHash, FInputSequenceHitCountersRecord& outRecord) const;
+
+	/* Adds counts made since last save to counts already saved in file, so one file accumulates counts of many play sessions and saves */
+	bool Save(const FString& filePath);
+
+	static bool LoadFromFile(const FString& filePath, TMap<FIoHash, FInputSequenceHitCountersRecord>& outRecords);
+
+	static bool SaveToFile(const FString& filePath, const TMap<FIoHash, FInputSequenceHitCountersRecord>& records);
+
+protected:
+
+	struct FEntry
+	{
+		FString AssetName;
+
+		TUniquePtr<InputSequenceCore::FHitCounters> Counters;
+
+		/* Counts as of last successful save, in layout of FInputSequenceHitCountersRecord. Empty if never saved since last reset */
+		TArray<uint64> SavedCounts;
+
+		/* Incremented by every reset, saved counts taken before reset are not made baseline */
+		uint32 ResetGeneration = 0;
+	};
+
+	TMap<FIoHash, FEntry> Entries;
+
+	mutable FCriticalSection EntriesCS;
+
+	bool bIsStarted = false;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "InputSequenceInputBinding.h"
+#include "InputSequenceInputBinderComponent.generated.h"
+
+class UEnhancedInputComponent;
+class APawn;
+class APlayerController;
+
+/*
+* Feeds Input Sequence Assets from Enhanced Input without Blueprint glue. Input Actions of compiled names are bound once, so callbacks write ids straight into per-asset input buffers.
+* Input component of pawn is recreated on every restart, component rebinds to it when owning pawn is restarted. Owners that build input component on their own can call BindInput from SetupPlayerInputComponent
+*/
+UCLASS(ClassGroup = Input, meta = (BlueprintSpawnableComponent))
+class INPUTSEQUENCE_API UInputSequenceInputBinderComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/* Binds Input Actions of all assets to given component, previous bindings are removed. Called on BeginPlay if owner already has Enhanced Input Component, and on every restart of owning pawn */
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Input Binder")
+		void BindInput(UEnhancedInputComponent* inputComponent);
+
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Input Binder")
+		void UnbindInput();
+
+	/* Instance of asset at given index, evaluated by this component */
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Input Binder")
+		UInputSequenceAsset* GetInstance(int32 assetIndex) const { return Instances.IsValidIndex(assetIndex) ? Instances[assetIndex] : nullptr; }
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+
+	/* Assets are copied on BeginPlay, so shared assets are never stepped by several owners */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input Sequence Input Binder")
+		TArray<TObjectPtr<UInputSequenceAsset>> InputSequenceAssets;
+
+	/* Calling context passed to executed events, calling object is owner of component */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Sequence Input Binder")
+		FString CallingContext;
+
+	UFUNCTION()
+		void OnPawnRestarted(APawn* pawn);
+
+	/* Input is processed in tick of Player Controller, so sequences are stepped after it within the same frame */
+	void UpdateTickPrerequisite();
+
+	/* Own copies of assets, so every owner has its own runtime state */
+	UPROPERTY(Transient)
+		TArray<TObjectPtr<UInputSequenceAsset>> Instances;
+
+	TWeakObjectPtr<APlayerController> PrerequisiteController;
+
+	FInputSequenceInputBinding Binding;
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "InputSequenceAsset.h"
+
+class UEnhancedInputComponent;
+
+/* Per-asset input buffers of a set of Input Sequence Assets. Enhanced Input Actions of compiled names are bound once and write ids straight into buffers, classic input is added by name */
+class INPUTSEQUENCE_API FInputSequenceInputBinding
+{
+public:
+
+	~FInputSequenceInputBinding() { Unbind(); }
+
+	/* Binds Input Actions of all assets to given component, previous bindings are removed. Must be called again if assets are changed */
+	void Bind(UEnhancedInputComponent* inputComponent, const TArray<TObjectPtr<UInputSequenceAsset>>& assets);
+
+	void Unbind();
+
+	UEnhancedInputComponent* GetInputComponent() const { return BoundInputComponent.Get(); }
+
+	void AddActionInput(const TArray<TObjectPtr<UInputSequenceAsset>>& assets, const FName& actionName, EInputEvent inputEvent);
+
+	void AddAxisInput(const TArray<TObjectPtr<UInputSequenceAsset>>& assets, const FName& axisName, float axisValue);
+
+	/* Moves input collected for one asset since last call into given arrays, for callers that step assets on their own */
+	void ConsumeInput(const TArray<TObjectPtr<UInputSequenceAsset>>& assets, int32 assetIndex, TArray<InputSequenceCore::FActionInput>& outActionInputs, TArray<InputSequenceCore::FAxisInput>& outAxisInputs);
+
+	/* Steps all assets with input collected since last call and executes their events */
+	void Step(const TArray<TObjectPtr<UInputSequenceAsset>>& assets, float DeltaTime, bool bGamePaused, UObject* callingObject, const FString& callingContext);
+
+protected:
+
+	struct FBoundAsset
+	{
+		/* Action events of current frame */
+		TArray<InputSequenceCore::FActionInput> ActionInputs;
+
+		/* Last values of bound axes, fed every frame as classic axis bindings do. Classic axes of current frame are appended past NumBoundAxes */
+		TArray<InputSequenceCore::FAxisInput> AxisInputs;
+
+		int32 NumBoundAxes = 0;
+	};
+
+	TWeakObjectPtr<UEnhancedInputComponent> BoundInputComponent;
+
+	TArray<uint32> BindingHandles;
+
+	/* Parallel to assets */
+	TArray<FBoundAsset> BoundAssets;
+
+	TArray<FInputSequenceEventCall> EventCalls;
+
+	TArray<FInputSequenceResetSource> ResetSources;
+};
\ No newline at end of file
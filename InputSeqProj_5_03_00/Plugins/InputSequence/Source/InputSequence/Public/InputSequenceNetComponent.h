@@ -0,0 +1,149 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "InputSequenceInputBinding.h"
+#include "InputSequenceNetComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FInputSequenceNetStateDelegate, UInputSequenceAsset*, asset, int32, stateIndex);
+
+/* One frame of input stream: keyframe flag, delta time, pause flag, then input and passed states of every asset in order */
+USTRUCT()
+struct FInputSequenceNetFrame
+{
+	GENERATED_BODY()
+
+	/* Increments by one every frame, starting from 1 */
+	UPROPERTY()
+		uint32 Sequence = 0;
+
+	UPROPERTY()
+		TArray<uint8> Data;
+};
+
+/*
+* Server authoritative Input Sequences of player. Owning client quantizes its input into compact stream (see InputSequenceCore::FInputStreamCodec), evaluates it locally and sends it every frame with states it passed.
+* Server evaluates the same stream over its own instances of the same assets, so passed states are confirmed or rejected without trusting client. Delta times of client are capped by time passed on server and pause state is server's own. Must be added to Player Controller
+* Frames are sent unreliably together with a few previous ones. If server misses more frames than that or gets malformed one, it asks client to resync: both sides reset instances and codecs, and client starts over from keyframe
+*/
+UCLASS(ClassGroup = Input, meta = (BlueprintSpawnableComponent))
+class INPUTSEQUENCE_API UInputSequenceNetComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/* Classic input, name based. Enhanced Input Actions of assets are bound natively */
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Net")
+		void RegisterInputActionEvent(FName inputActionName, EInputEvent inputEvent);
+
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Net")
+		void RegisterInputAxisEvent(FName inputAxisName, float axisValue);
+
+	/* Instance of asset at given index, evaluated by this component */
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Net")
+		UInputSequenceAsset* GetInstance(int32 assetIndex) const { return Instances.IsValidIndex(assetIndex) ? Instances[assetIndex] : nullptr; }
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/* Server only. State passed by client is passed by server evaluation as well */
+	UPROPERTY(BlueprintAssignable, Category = "Input Sequence Net")
+		FInputSequenceNetStateDelegate OnStateConfirmed;
+
+	/* Server and owning client. State passed by client is not passed by server evaluation */
+	UPROPERTY(BlueprintAssignable, Category = "Input Sequence Net")
+		FInputSequenceNetStateDelegate OnStateRejected;
+
+protected:
+
+	/* Last frames of input stream, oldest first. Frames server already applied are skipped */
+	UFUNCTION(Server, Unreliable)
+		void ServerInputFrames(const TArray<FInputSequenceNetFrame>& frames);
+
+	UFUNCTION(Client, Reliable)
+		void ClientStateRejected(int32 assetIndex, int32 stateIndex);
+
+	/* Server lost track of stream, next frame client sends must be keyframe */
+	UFUNCTION(Client, Reliable)
+		void ClientResync();
+
+	bool IsInputOwner() const;
+
+	/* Fresh copies of assets and codecs, the state both sides start from at keyframe */
+	void ResetInstances();
+
+	/* Server only. Returns false if frame is malformed, made for other assets or steps instances past time of server */
+	bool ApplyFrame(InputSequenceCore::FBitReader& reader);
+
+	/* Server only. Repeated after ResyncTimeout if keyframe does not come */
+	void RequestResync();
+
+	void EvaluateInstance(int32 assetIndex, float deltaTime, bool bGamePaused);
+
+	/* Same assets must be set on server and on client, stream refers to their compiled names and states by index */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input Sequence Net")
+		TArray<TObjectPtr<UInputSequenceAsset>> InputSequenceAssets;
+
+	/* Calling context passed to executed events, calling object is owner of component */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Sequence Net")
+		FString CallingContext;
+
+	/* Previous frames sent along with every frame, so server gets over that many lost packets in a row without resync */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input Sequence Net", meta = (ClampMin = "0", ClampMax = "16"))
+		int32 RedundantFrames = 3;
+
+	/* Seconds server waits for keyframe before it asks client to resync again */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input Sequence Net", meta = (ClampMin = "0.1"))
+		float ResyncTimeout = 1.f;
+
+	/* Seconds delta times sent by client may sum up ahead of time passed on server, or lag behind it before lag is dropped. Frames past it break stream */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input Sequence Net", meta = (ClampMin = "0"))
+		float ClientTimeSlack = 0.25f;
+
+	/* Own copies of assets, so every player has its own runtime state */
+	UPROPERTY()
+		TArray<TObjectPtr<UInputSequenceAsset>> Instances;
+
+	FInputSequenceInputBinding Binding;
+
+	/* Parallel to instances */
+	TArray<InputSequenceCore::FInputStreamCodec> Codecs;
+
+	InputSequenceCore::FBitWriter FrameWriter;
+
+	/* Per frame buffers, kept to reuse allocations */
+	TArray<InputSequenceCore::FActionInput> RawActionInputs;
+	TArray<InputSequenceCore::FAxisInput> RawAxisInputs;
+	std::vector<InputSequenceCore::FActionInput> ActionInputs;
+	std::vector<InputSequenceCore::FAxisInput> AxisInputs;
+	std::vector<uint16> ClaimedStates;
+
+	TArray<FInputSequenceEventCall> EventCalls;
+
+	TArray<FInputSequenceResetSource> ResetSources;
+
+	/* Client only. Last sent frames, oldest first */
+	TArray<FInputSequenceNetFrame> SentFrames;
+
+	uint32 NextSequence = 1;
+
+	bool bIsKeyframePending = true;
+
+	/* Server only. Frames after it are applied only in order, or from keyframe if stream is broken */
+	uint32 LastAppliedSequence = 0;
+
+	/* Server only. Stream is followed only from keyframe, including the very first one */
+	bool bIsStreamBroken = true;
+
+	/* Server only. Unpaused world time of last keyframe and delta times applied since it */
+	double StreamStartTime = 0;
+	double StreamTime = 0;
+
+	/* Server only. Platform time of last resync request, negative if not requested since last keyframe */
+	double ResyncRequestTime = -1;
+};
\ No newline at end of file
@@ -0,0 +1,137 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum EInputEvent;
+
+/* One OnInput call of Input Sequence Asset, as it was recorded */
+struct FInputSequenceRecordedFrame
+{
+	float DeltaTime = 0;
+
+	bool bGamePaused = false;
+
+	TMap<FName, TEnumAsByte<EInputEvent>> ActionEvents;
+
+	/* Components past those axis has are zero */
+	TMap<FName, FVector3f> AxisEvents;
+};
+
+/* One RequestReset call of Input Sequence Asset, source object is kept by path */
+struct FInputSequenceRecordedReset
+{
+	FString SourcePath;
+
+	FString SourceContext;
+};
+
+/*
+ * Compact binary recording of everything fed to Input Sequence Asset.
+ * Strings are written once and referenced by varint index afterwards, delta time and each component of axis values are written only when changed,
+ * and runs of frames repeating previous one without action events are collapsed into single counter.
+ */
+class INPUTSEQUENCE_API FInputSequenceRecordingWriter
+{
+public:
+
+	FInputSequenceRecordingWriter(const FString& assetPath);
+
+	void RecordFrame(float deltaTime, bool bGamePaused, const TMap<FName, TEnumAsByte<EInputEvent>>& actionEvents, const TMap<FName, FVector3f>& axisEvents);
+
+	void RecordReset(const UObject* sourceObject, const FString& sourceContext);
+
+	bool SaveToFile(const FString& filePath);
+
+	int64 GetNumBytes() const { return Data.Num(); }
+
+	int64 GetNumFrames() const { return NumFrames; }
+
+protected:
+
+	void FlushIdleFrames();
+
+	void WriteVarInt(uint64 value);
+
+	void WriteFloat(float value);
+
+	void WriteRawString(const FString& string);
+
+	uint32 GetStringIndex(const FString& string, bool& bIsNew);
+
+	uint32 GetNameIndex(const FName& name, bool& bIsNew);
+
+	TArray<uint8> Data;
+
+	TMap<FString, uint32> StringIndice;
+
+	TMap<FName, uint32> NameIndice;
+
+	uint32 NumStrings;
+
+	TMap<uint32, FVector3f> LastAxisValues;
+
+	TMap<FName, FVector3f> LastAxisEvents;
+
+	float LastDeltaTime;
+
+	bool bLastGamePaused;
+
+	uint64 NumIdleFrames;
+
+	int64 NumFrames;
+};
+
+class INPUTSEQUENCE_API FInputSequenceRecordingReader
+{
+public:
+
+	enum class ERecord : uint8
+	{
+		Frame,
+		Reset,
+		End
+	};
+
+	FInputSequenceRecordingReader();
+
+	bool LoadFromFile(const FString& filePath);
+
+	const FString& GetAssetPath() const { return AssetPath; }
+
+	bool IsError() const { return bIsError; }
+
+	/* Reads next record, collapsed idle frames are returned one by one */
+	ERecord ReadNext(FInputSequenceRecordedFrame& outFrame, FInputSequenceRecordedReset& outReset);
+
+protected:
+
+	bool ReadVarInt(uint64& outValue);
+
+	bool ReadFloat(float& outValue);
+
+	bool ReadRawString(FString& outString);
+
+	bool ReadStringIndex(uint32 index);
+
+	TArray<uint8> Data;
+
+	int64 Offset;
+
+	FString AssetPath;
+
+	TArray<FString> Strings;
+
+	TArray<FName> Names;
+
+	TMap<uint32, FVector3f> LastAxisValues;
+
+	FInputSequenceRecordedFrame LastFrame;
+
+	uint64 Version;
+
+	uint64 NumIdleFrames;
+
+	bool bIsError;
+};
\ No newline at end of file
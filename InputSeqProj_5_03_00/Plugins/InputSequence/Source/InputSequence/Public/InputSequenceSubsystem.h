@@ -0,0 +1,58 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "Tickable.h"
+#include "InputSequenceInputBinding.h"
+#include "InputSequenceSubsystem.generated.h"
+
+class UEnhancedInputComponent;
+
+/* Owns Input Sequence instances of local player and steps them all in one pass per frame. Ticks after all actors, so input processed by player controller during the frame is already collected */
+UCLASS()
+class INPUTSEQUENCE_API UInputSequenceSubsystem : public ULocalPlayerSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/* Creates instance of asset owned by this subsystem, its input is collected and its events are executed with player controller as calling object */
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Subsystem")
+		UInputSequenceAsset* RegisterAsset(UInputSequenceAsset* asset);
+
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Subsystem")
+		void UnregisterAsset(UInputSequenceAsset* instance);
+
+	/* Classic input, name based. Enhanced Input Actions of registered assets are bound natively */
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Subsystem")
+		void RegisterInputActionEvent(FName inputActionName, EInputEvent inputEvent);
+
+	UFUNCTION(BlueprintCallable, Category = "Input Sequence Subsystem")
+		void RegisterInputAxisEvent(FName inputAxisName, float axisValue);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual ETickableTickType GetTickableTickType() const override { return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional; }
+
+	virtual bool IsTickable() const override { return Instances.Num() > 0; }
+
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UInputSequenceSubsystem, STATGROUP_Tickables); }
+
+protected:
+
+	UEnhancedInputComponent* GetPlayerInputComponent() const;
+
+	UPROPERTY()
+		TArray<TObjectPtr<UInputSequenceAsset>> Instances;
+
+	FInputSequenceInputBinding Binding;
+
+	bool bIsBindingDirty = false;
+};
\ No newline at end of file
@@ -0,0 +1,85 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "InputTriggers.h"
+#include "InputSequenceAsset.h"
+#include "InputTriggerSequence.generated.h"
+
+class UInputAction;
+
+/*
+* Evaluates Input Sequence Asset inside of Enhanced Input and fires its action when terminal state is passed. Input of sequence is read from key and action states of player input, so no events go through Blueprint.
+* Button Input Actions are read from raw state of their mapped keys, so they are always of current frame, but triggers and modifiers of those actions are not applied.
+* Axis Input Actions are read from their evaluated values, which are of current frame only if action is evaluated before action with this trigger: map them in context of higher priority or earlier in the same context
+* Events of states are executed as by other callers of asset, calling object is Player Controller of player input
+*/
+UCLASS(NotBlueprintable, meta = (DisplayName = "Input Sequence"))
+class INPUTSEQUENCE_API UInputTriggerSequence : public UInputTrigger
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trigger Settings")
+		TObjectPtr<UInputSequenceAsset> InputSequenceAsset;
+
+	/* Trigger fires on frame when any state with this context is passed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trigger Settings")
+		FString TerminalStateContext;
+
+	/* Calling context passed to executed events */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trigger Settings")
+		FString CallingContext;
+
+	virtual FString GetDebugState() const override;
+
+protected:
+
+	virtual ETriggerType GetTriggerType_Implementation() const override { return ETriggerType::Explicit; }
+
+	virtual ETriggerState UpdateState_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue ModifiedValue, float DeltaTime) override;
+
+	/* Instances asset for this trigger and resolves where input of each compiled name comes from */
+	void InitInstance(const UEnhancedPlayerInput* PlayerInput);
+
+	struct FNameSource
+	{
+		uint32 NameId = 0;
+
+		/* Enhanced Input Action of name, if any */
+		const UInputAction* InputAction = nullptr;
+
+		/* Classic action and axis mappings of name */
+		TArray<FKey> ActionKeys;
+		TArray<TPair<FKey, float>> AxisKeys;
+	};
+
+	UPROPERTY(Transient)
+		TObjectPtr<UInputSequenceAsset> Instance;
+
+	TArray<FNameSource> NameSources;
+
+	/* Index in NameSources per button Input Action, their keys are looked up in mappings of player input every frame as mappings change with contexts */
+	TMap<const UInputAction*, int32> ButtonActionSources;
+
+	struct FButtonKeys
+	{
+		int32 NumDown = 0;
+		int32 NumJustPressed = 0;
+		int32 NumJustReleased = 0;
+	};
+
+	/* Parallel to NameSources, scratch buffer of current frame */
+	TArray<FButtonKeys> ButtonKeys;
+
+	TArray<uint16> TerminalStates;
+
+	TArray<InputSequenceCore::FActionInput> ActionInputs;
+
+	TArray<InputSequenceCore::FAxisInput> AxisInputs;
+
+	TArray<FInputSequenceEventCall> EventCalls;
+
+	TArray<FInputSequenceResetSource> ResetSources;
+};
\ No newline at end of file
@@ -35,7 +35,8 @@ public class InputSequenceEditor : ModuleRules
 			new string[]
 			{
 				"CoreUObject", "InputSequence", "UnrealEd", "AssetTools", "SlateCore", "Slate", "EditorStyle", "Engine",
-				"GraphEditor", "KismetWidgets", "ApplicationCore", "InputCore", "AssetRegistry", "EnhancedInput"
+				"GraphEditor", "KismetWidgets", "ApplicationCore", "InputCore", "AssetRegistry", "EnhancedInput", "DerivedDataCache",
+				"DeveloperSettings", "DataValidation", "Json", "JsonUtilities", "DesktopPlatform"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
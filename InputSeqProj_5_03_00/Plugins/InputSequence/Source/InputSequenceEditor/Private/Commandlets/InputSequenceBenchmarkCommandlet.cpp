@@ -0,0 +1,412 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "Commandlets/InputSequenceBenchmarkCommandlet.h"
+#include "InputSequence.h"
+#include "InputSequenceAsset.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Misc/FileHelper.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+
+namespace InputSequenceBenchmark
+{
+	/* Forwards everything to wrapped allocator and counts game thread allocations made while installed */
+	class FCountingMalloc : public FMalloc
+	{
+	public:
+
+		FCountingMalloc(FMalloc* innerMalloc) : InnerMalloc(innerMalloc) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { Count_Internal(Count); return InnerMalloc->Malloc(Count, Alignment); }
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { Count_Internal(Count); return InnerMalloc->TryMalloc(Count, Alignment); }
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override { Count_Internal(Count); return InnerMalloc->Realloc(Original, Count, Alignment); }
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override { Count_Internal(Count); return InnerMalloc->TryRealloc(Original, Count, Alignment); }
+
+		virtual void Free(void* Original) override { InnerMalloc->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+
+		virtual void Trim(bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+
+		virtual void SetupTLSCachesOnCurrentThread() override { InnerMalloc->SetupTLSCachesOnCurrentThread(); }
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+
+		virtual void InitializeStatsMetadata() override { InnerMalloc->InitializeStatsMetadata(); }
+
+		virtual void UpdateStats() override { InnerMalloc->UpdateStats(); }
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& out_Stats) override { InnerMalloc->GetAllocatorStats(out_Stats); }
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { InnerMalloc->DumpAllocatorStats(Ar); }
+
+		virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+
+		virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+
+		virtual const TCHAR* GetDescriptiveName() override { return InnerMalloc->GetDescriptiveName(); }
+
+		uint64 NumAllocations = 0;
+
+		uint64 NumBytes = 0;
+
+	protected:
+
+		void Count_Internal(SIZE_T count)
+		{
+			if (IsInGameThread())
+			{
+				NumAllocations++;
+				NumBytes += count;
+			}
+		}
+
+		FMalloc* InnerMalloc;
+	};
+
+	struct FFrameInput
+	{
+		TMap<FName, TEnumAsByte<EInputEvent>> ActionEvents;
+
+		TMap<FName, float> AxisEvents;
+	};
+
+	struct FShape
+	{
+		FString Name;
+
+		TFunction<void(TArray<FInputSequenceState>&)> BuildStates;
+
+		TFunction<void(int32, FRandomStream&, FFrameInput&)> MakeFrameInput;
+	};
+
+	struct FResult
+	{
+		FString ShapeName;
+		int32 NumStates = 0;
+		int32 NumInstances = 0;
+		int32 NumFrames = 0;
+		double NsPerFrame = 0;
+		double NsPerInstanceFrame = 0;
+		double AllocationsPerFrame = 0;
+		double BytesPerFrame = 0;
+		int32 PeakActiveStates = 0;
+		int32 PeakActiveStatesTotal = 0;
+	};
+
+	int32 AddState(TArray<FInputSequenceState>& states, int32 parentIndex)
+	{
+		const int32 index = states.Emplace();
+
+		if (states.IsValidIndex(parentIndex))
+		{
+			FInputSequenceState& parent = states[parentIndex];
+			parent.NextIndice.Add(index);
+
+			states[index].DepthIndex = parent.DepthIndex + 1;
+			states[index].FirstLayerParentIndex = parent.FirstLayerParentIndex > 0 ? parent.FirstLayerParentIndex : parentIndex;
+		}
+
+		return index;
+	}
+
+	int32 AddPressState(TArray<FInputSequenceState>& states, int32 parentIndex, std::initializer_list<FName> actionNames)
+	{
+		const int32 index = AddState(states, parentIndex);
+
+		FInputSequenceState& state = states[index];
+		state.IsInputNode = 1;
+		state.TimeParam = 1;
+
+		for (const FName& actionName : actionNames) state.InputActions.Add(actionName, FInputActionState({ IE_Pressed, IE_Released }));
+
+		return index;
+	}
+
+	int32 Add2DAxisState(TArray<FInputSequenceState>& states, int32 parentIndex, float startAngleRad, float endAngleRad)
+	{
+		const int32 index = AddState(states, parentIndex);
+
+		FInputSequenceState& state = states[index];
+		state.IsInputNode = 1;
+		state.IsAxisNode = 1;
+		state.TimeParam = 1;
+
+		state.InputActions.Add("MoveX ^ MoveY", FInputActionState({}, startAngleRad, endAngleRad, 0.2f, "MoveX", "MoveY"));
+
+		return index;
+	}
+
+	FName GetIndexedName(const TCHAR* prefix, int32 index)
+	{
+		return FName(prefix, index + 1); // Number 0 means no number for FName
+	}
+
+	void AddPressAndRelease(int32 frameIndex, const FName& actionName, FFrameInput& outFrameInput)
+	{
+		outFrameInput.ActionEvents.Add(actionName, frameIndex % 2 == 0 ? IE_Pressed : IE_Released);
+	}
+
+	TArray<FShape> MakeShapes()
+	{
+		TArray<FShape> shapes;
+
+		// Single long chain, one active state stepping every other frame
+
+		shapes.Add({ TEXT("DeepChain"),
+			[](TArray<FInputSequenceState>& states)
+			{
+				int32 parentIndex = AddState(states, INDEX_NONE);
+				for (int32 depth = 0; depth < 256; depth++) parentIndex = AddPressState(states, parentIndex, { GetIndexedName(TEXT("Chain"), depth % 4) });
+			},
+			[](int32 frameIndex, FRandomStream& randomStream, FFrameInput& outFrameInput)
+			{
+				AddPressAndRelease(frameIndex, GetIndexedName(TEXT("Chain"), (frameIndex / 2) % 4), outFrameInput);
+			} });
+
+		// Many first layer states active all the time
+
+		shapes.Add({ TEXT("WideFirstLayer"),
+			[](TArray<FInputSequenceState>& states)
+			{
+				const int32 startIndex = AddState(states, INDEX_NONE);
+				for (int32 i = 0; i < 256; i++) AddPressState(states, AddPressState(states, startIndex, { GetIndexedName(TEXT("Wide"), i) }), { GetIndexedName(TEXT("Wide"), (i + 1) % 256) });
+			},
+			[](int32 frameIndex, FRandomStream& randomStream, FFrameInput& outFrameInput)
+			{
+				AddPressAndRelease(frameIndex, GetIndexedName(TEXT("Wide"), (frameIndex / 2) % 256), outFrameInput);
+			} });
+
+		// Stick rotation over many 2D axis sectors
+
+		shapes.Add({ TEXT("Axis2DSectors"),
+			[](TArray<FInputSequenceState>& states)
+			{
+				const int32 startIndex = AddState(states, INDEX_NONE);
+				const float sectorRad = TWO_PI / 64;
+
+				for (int32 i = 0; i < 64; i++)
+				{
+					const float startAngleRad = -HALF_PI + i * sectorRad;
+					const int32 firstIndex = Add2DAxisState(states, startIndex, startAngleRad, startAngleRad + sectorRad);
+					Add2DAxisState(states, firstIndex, startAngleRad + sectorRad, startAngleRad + 2 * sectorRad);
+				}
+			},
+			[](int32 frameIndex, FRandomStream& randomStream, FFrameInput& outFrameInput)
+			{
+				const float angleRad = frameIndex * 0.05f;
+				outFrameInput.AxisEvents.Add("MoveX", FMath::Cos(angleRad));
+				outFrameInput.AxisEvents.Add("MoveY", FMath::Sin(angleRad));
+			} });
+
+		// Chords with precise match, random input mostly resets them
+
+		shapes.Add({ TEXT("PreciseMatch"),
+			[](TArray<FInputSequenceState>& states)
+			{
+				const int32 startIndex = AddState(states, INDEX_NONE);
+
+				for (int32 i = 0; i < 64; i++)
+				{
+					int32 parentIndex = startIndex;
+
+					for (int32 depth = 0; depth < 4; depth++)
+					{
+						parentIndex = AddPressState(states, parentIndex, { GetIndexedName(TEXT("Precise"), (i + depth) % 8), GetIndexedName(TEXT("Precise"), (i + depth + 1) % 8) });
+						states[parentIndex].isOverridingRequirePreciseMatch = 1;
+						states[parentIndex].requirePreciseMatch = 1;
+					}
+				}
+			},
+			[](int32 frameIndex, FRandomStream& randomStream, FFrameInput& outFrameInput)
+			{
+				const int32 actionIndex = randomStream.RandRange(0, 7);
+				AddPressAndRelease(frameIndex, GetIndexedName(TEXT("Precise"), actionIndex), outFrameInput);
+				AddPressAndRelease(frameIndex, GetIndexedName(TEXT("Precise"), (actionIndex + 1) % 8), outFrameInput);
+			} });
+
+		return shapes;
+	}
+
+	FResult Run(const FShape& shape, UInputSequenceAsset* templateAsset, int32 numInstances, const TArray<FFrameInput>& frameInputs)
+	{
+		FResult result;
+		result.ShapeName = shape.Name;
+		result.NumStates = templateAsset->GetCompiledData().NumStates();
+		result.NumInstances = numInstances;
+		result.NumFrames = frameInputs.Num();
+
+		TArray<UInputSequenceAsset*> instances;
+
+		for (int32 i = 0; i < numInstances; i++)
+		{
+			UInputSequenceAsset* instance = NewObject<UInputSequenceAsset>(GetTransientPackage(), NAME_None, RF_Transient);
+			instance->AddToRoot();
+			instance->SetCompiledData(templateAsset->GetCompiledData());
+
+			instances.Add(instance);
+		}
+
+		const float deltaTime = 1 / 60.f;
+
+		TArray<FInputSequenceEventCall> eventCalls;
+		eventCalls.Reserve(1024);
+
+		TArray<FInputSequenceResetSource> resetSources;
+		resetSources.Reserve(1024);
+
+		// Warm up, so runtime arrays of instances and output arrays are allocated before measurement
+
+		for (int32 frameIndex = 0; frameIndex < FMath::Min(frameInputs.Num(), 60); frameIndex++)
+		{
+			for (UInputSequenceAsset* instance : instances)
+			{
+				eventCalls.Reset();
+				resetSources.Reset();
+				instance->OnInput(deltaTime, false, frameInputs[frameIndex].ActionEvents, frameInputs[frameIndex].AxisEvents, eventCalls, resetSources);
+			}
+		}
+
+		for (UInputSequenceAsset* instance : instances) instance->ClearInputStates();
+
+		FMalloc* innerMalloc = GMalloc;
+		FCountingMalloc countingMalloc(innerMalloc);
+
+		uint64 totalCycles = 0;
+
+		GMalloc = &countingMalloc;
+
+		for (const FFrameInput& frameInput : frameInputs)
+		{
+			const uint64 startCycles = FPlatformTime::Cycles64();
+
+			for (UInputSequenceAsset* instance : instances)
+			{
+				eventCalls.Reset();
+				resetSources.Reset();
+				instance->OnInput(deltaTime, false, frameInput.ActionEvents, frameInput.AxisEvents, eventCalls, resetSources);
+			}
+
+			totalCycles += FPlatformTime::Cycles64() - startCycles;
+
+			// Not timed, but allocations of container iteration are still counted, they are negligible
+
+			int32 activeStatesTotal = 0;
+
+			for (UInputSequenceAsset* instance : instances)
+			{
+				const int32 activeStates = instance->GetNumActiveStates();
+				result.PeakActiveStates = FMath::Max(result.PeakActiveStates, activeStates);
+				activeStatesTotal += activeStates;
+			}
+
+			result.PeakActiveStatesTotal = FMath::Max(result.PeakActiveStatesTotal, activeStatesTotal);
+		}
+
+		GMalloc = innerMalloc;
+
+		const double totalNs = FPlatformTime::ToSeconds64(totalCycles) * 1e9;
+
+		result.NsPerFrame = totalNs / FMath::Max(frameInputs.Num(), 1);
+		result.NsPerInstanceFrame = result.NsPerFrame / FMath::Max(numInstances, 1);
+		result.AllocationsPerFrame = (double)countingMalloc.NumAllocations / FMath::Max(frameInputs.Num(), 1);
+		result.BytesPerFrame = (double)countingMalloc.NumBytes / FMath::Max(frameInputs.Num(), 1);
+
+		for (UInputSequenceAsset* instance : instances) instance->RemoveFromRoot();
+
+		return result;
+	}
+}
+
+UInputSequenceBenchmarkCommandlet::UInputSequenceBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer) :Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UInputSequenceBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace InputSequenceBenchmark;
+
+	int32 numFrames = 600;
+	FParse::Value(*Params, TEXT("frames="), numFrames);
+	numFrames = FMath::Max(numFrames, 1);
+
+	TArray<int32> instanceCounts = { 1, 100, 10000 };
+
+	FString instancesString;
+	if (FParse::Value(*Params, TEXT("instances="), instancesString, false))
+	{
+		TArray<FString> instanceCountStrings;
+		instancesString.ParseIntoArray(instanceCountStrings, TEXT(","));
+
+		instanceCounts.Reset();
+		for (const FString& instanceCountString : instanceCountStrings) instanceCounts.Add(FMath::Max(FCString::Atoi(*instanceCountString), 1));
+	}
+
+	TArray<FString> shapeNames;
+
+	FString shapesString;
+	if (FParse::Value(*Params, TEXT("shapes="), shapesString, false)) shapesString.ParseIntoArray(shapeNames, TEXT(","));
+
+	FString csvPath;
+	FParse::Value(*Params, TEXT("csv="), csvPath);
+
+	TArray<FResult> results;
+
+	for (const FShape& shape : MakeShapes())
+	{
+		if (shapeNames.Num() > 0 && !shapeNames.Contains(shape.Name)) continue;
+
+		UInputSequenceAsset* templateAsset = NewObject<UInputSequenceAsset>(GetTransientPackage(), NAME_None, RF_Transient);
+		templateAsset->AddToRoot();
+
+		shape.BuildStates(templateAsset->States);
+		templateAsset->RebuildCompiledData();
+
+		FRandomStream randomStream(0x1234);
+
+		TArray<FFrameInput> frameInputs;
+		frameInputs.SetNum(numFrames);
+
+		for (int32 frameIndex = 0; frameIndex < numFrames; frameIndex++) shape.MakeFrameInput(frameIndex, randomStream, frameInputs[frameIndex]);
+
+		for (int32 instanceCount : instanceCounts)
+		{
+			const FResult& result = results.Add_GetRef(Run(shape, templateAsset, instanceCount, frameInputs));
+
+			UE_LOG(LogInputSequence, Display, TEXT("%-16s States=%-5d Instances=%-6d Frames=%-5d ns/frame=%-12.1f ns/instance-frame=%-9.1f allocs/frame=%-9.2f bytes/frame=%-10.1f peakActive=%-4d peakActiveTotal=%d"),
+				*result.ShapeName, result.NumStates, result.NumInstances, result.NumFrames, result.NsPerFrame, result.NsPerInstanceFrame, result.AllocationsPerFrame, result.BytesPerFrame, result.PeakActiveStates, result.PeakActiveStatesTotal);
+		}
+
+		templateAsset->RemoveFromRoot();
+
+		CollectGarbage(RF_NoFlags);
+	}
+
+	if (!csvPath.IsEmpty())
+	{
+		FString csv = TEXT("Shape,States,Instances,Frames,NsPerFrame,NsPerInstanceFrame,AllocationsPerFrame,BytesPerFrame,PeakActiveStates,PeakActiveStatesTotal\n");
+
+		for (const FResult& result : results)
+		{
+			csv += FString::Printf(TEXT("%s,%d,%d,%d,%.1f,%.1f,%.2f,%.1f,%d,%d\n"),
+				*result.ShapeName, result.NumStates, result.NumInstances, result.NumFrames, result.NsPerFrame, result.NsPerInstanceFrame, result.AllocationsPerFrame, result.BytesPerFrame, result.PeakActiveStates, result.PeakActiveStatesTotal);
+		}
+
+		if (!FFileHelper::SaveStringToFile(csv, *csvPath))
+		{
+			UE_LOG(LogInputSequence, Error, TEXT("Failed to write benchmark results to %s"), *csvPath);
+			return 1;
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "InputSequenceBenchmarkCommandlet.generated.h"
+
+/* Benchmarks evaluation of procedurally built Input Sequence Assets, usable headless in CI:
+ * UnrealEditor-Cmd <Project> -run=InputSequenceBenchmark -nullrhi [-frames=600] [-instances=1,100,10000] [-shapes=DeepChain,WideFirstLayer,Axis2DSectors,PreciseMatch] [-csv=<Path>]
+ */
+UCLASS()
+class UInputSequenceBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	virtual int32 Main(const FString& Params) override;
+};
\ No newline at end of file
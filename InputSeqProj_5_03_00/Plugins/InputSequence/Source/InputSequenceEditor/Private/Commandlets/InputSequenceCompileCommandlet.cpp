@@ -0,0 +1,203 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "Commandlets/InputSequenceCompileCommandlet.h"
+#include "InputSequence.h"
+#include "InputSequenceAsset.h"
+#include "InputSequenceAnalyzer.h"
+#include "InputSequenceCompiler.h"
+#include "Graph/InputSequenceGraph.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/SavePackage.h"
+
+namespace
+{
+	struct FCompileResult
+	{
+		TArray<FInputSequenceState> States;
+
+		/* Hash of graph States are compiled from, zero if asset has no graph */
+		FIoHash GraphHash;
+
+		/* Valid only if bIsOutdated */
+		FInputSequenceCompiledData CompiledData;
+
+		bool bIsOutdated = false;
+
+		bool bIsBuilt = false;
+
+		TArray<FString> Warnings;
+
+		FInputSequenceAnalysis Analysis;
+
+		double CompileTime = 0;
+	};
+}
+
+UInputSequenceCompileCommandlet::UInputSequenceCompileCommandlet(const FObjectInitializer& ObjectInitializer) :Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UInputSequenceCompileCommandlet::Main(const FString& Params)
+{
+	FString packagePath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("path="), packagePath);
+
+	const bool bForce = FParse::Param(*Params, TEXT("force"));
+	const bool bSave = !FParse::Param(*Params, TEXT("nosave"));
+
+	const double startTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	assetRegistry.SearchAllAssets(true);
+
+	FARFilter filter;
+	filter.PackagePaths.Add(FName(*packagePath));
+	filter.ClassPaths.Add(UInputSequenceAsset::StaticClass()->GetClassPathName());
+	filter.bRecursivePaths = true;
+	filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> assetDatas;
+	assetRegistry.GetAssets(filter, assetDatas);
+
+	// Loading is game thread only. Every package is fully loaded before compiling starts, so workers never resolve objects
+
+	TArray<UInputSequenceAsset*> assets;
+	assets.Reserve(assetDatas.Num());
+
+	int32 numFailed = 0;
+
+	for (const FAssetData& assetData : assetDatas)
+	{
+		if (UInputSequenceAsset* asset = Cast<UInputSequenceAsset>(assetData.GetAsset()))
+		{
+			assets.Add(asset);
+		}
+		else
+		{
+			UE_LOG(LogInputSequence, Error, TEXT("Failed to load %s"), *assetData.GetObjectPathString());
+			numFailed++;
+		}
+	}
+
+	const double loadTime = FPlatformTime::Seconds();
+
+	// Assets share nothing while compiled: every graph has its own cache of compiled nodes, and compiled data is built aside to be set on game thread
+
+	TArray<FCompileResult> results;
+	results.SetNum(assets.Num());
+
+	ParallelFor(assets.Num(), [&](int32 index)
+		{
+			UInputSequenceAsset* asset = assets[index];
+			FCompileResult& result = results[index];
+
+			const double compileStartTime = FPlatformTime::Seconds();
+
+			if (const UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(asset->EdGraph))
+			{
+				result.GraphHash = FInputSequenceCompiler::HashGraph(graph);
+
+				graph->CompileStates(result.States, nullptr, &result.Warnings);
+			}
+			else
+			{
+				// Nothing to compile from, saved States are checked against compiled data
+				result.States = asset->States;
+			}
+
+			result.bIsOutdated = bForce || !asset->GetCompiledData().IsUpToDate(FInputSequenceCompiledData::HashSource(result.States));
+
+			if (result.bIsOutdated) result.bIsBuilt = result.CompiledData.Build(result.States);
+
+			result.CompileTime = FPlatformTime::Seconds() - compileStartTime;
+
+			FInputSequenceAnalyzer::Analyze(result.States, result.Analysis);
+		});
+
+	const double compileTime = FPlatformTime::Seconds();
+
+	// Saving goes one package at a time on game thread
+
+	int32 numSaved = 0;
+	int32 numWarnings = 0;
+	int32 numErrors = 0;
+
+	TArray<FInputSequenceAnalysis::FMessage> messages;
+
+	for (int32 i = 0; i < assets.Num(); i++)
+	{
+		UInputSequenceAsset* asset = assets[i];
+		FCompileResult& result = results[i];
+
+		messages.Reset();
+		result.Analysis.GetMessages(messages);
+
+		UE_LOG(LogInputSequence, Display, TEXT("%s: %d states compiled in %.2f ms%s"), *asset->GetPathName(), result.States.Num(), result.CompileTime * 1000, result.bIsOutdated ? TEXT(", outdated") : TEXT(""));
+
+		for (const FString& warning : result.Warnings)
+		{
+			UE_LOG(LogInputSequence, Warning, TEXT("%s: %s"), *asset->GetPathName(), *warning);
+			numWarnings++;
+		}
+
+		for (const FInputSequenceAnalysis::FMessage& message : messages)
+		{
+			if (message.bIsError)
+			{
+				UE_LOG(LogInputSequence, Error, TEXT("%s: %s"), *asset->GetPathName(), *message.Text.ToString());
+				numErrors++;
+			}
+			else
+			{
+				UE_LOG(LogInputSequence, Warning, TEXT("%s: %s"), *asset->GetPathName(), *message.Text.ToString());
+				numWarnings++;
+			}
+		}
+
+		if (result.bIsOutdated && !result.bIsBuilt)
+		{
+			UE_LOG(LogInputSequence, Error, TEXT("%s: compiled data can not be built"), *asset->GetPathName());
+			numErrors++;
+			continue;
+		}
+
+		asset->States = MoveTemp(result.States);
+
+		// Graph hash matches compiled data now, so PreSave of asset does not compile it again
+
+		if (UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(asset->EdGraph)) graph->CompiledGraphHash = result.GraphHash;
+
+		if (!result.bIsOutdated) continue;
+
+		asset->SetCompiledData(result.CompiledData);
+
+		if (!bSave) continue;
+
+		UPackage* package = asset->GetPackage();
+
+		FSavePackageArgs saveArgs;
+		saveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+		if (UPackage::SavePackage(package, asset, *FPackageName::LongPackageNameToFilename(package->GetName(), FPackageName::GetAssetPackageExtension()), saveArgs))
+		{
+			numSaved++;
+		}
+		else
+		{
+			UE_LOG(LogInputSequence, Error, TEXT("Failed to save %s"), *package->GetName());
+			numFailed++;
+		}
+	}
+
+	UE_LOG(LogInputSequence, Display, TEXT("Compiled %d Input Sequence Assets under %s, %d saved, %d warnings, %d errors: loaded in %.2f s, compiled in %.2f s, saved in %.2f s"),
+		assets.Num(), *packagePath, numSaved, numWarnings, numErrors, loadTime - startTime, compileTime - loadTime, FPlatformTime::Seconds() - compileTime);
+
+	return numFailed > 0 || numErrors > 0 ? 1 : 0;
+}
\ No newline at end of file
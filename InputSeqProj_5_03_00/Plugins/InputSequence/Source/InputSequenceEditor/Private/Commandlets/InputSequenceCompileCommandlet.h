@@ -0,0 +1,21 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "InputSequenceCompileCommandlet.generated.h"
+
+/* Recompiles and validates every Input Sequence Asset under package path, usable headless in CI:
+ * UnrealEditor-Cmd <Project> -run=InputSequenceCompile [-path=/Game] [-force] [-nosave]
+ * Assets are loaded on game thread, compiled and analyzed in parallel, then saved one by one if their compiled data changed.
+ * Compile time, number of states, compile warnings and analysis messages are logged per asset. Fails if any asset has errors or can not be saved.
+ */
+UCLASS()
+class UInputSequenceCompileCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	virtual int32 Main(const FString& Params) override;
+};
\ No newline at end of file
@@ -0,0 +1,153 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "Commandlets/InputSequenceImportCommandlet.h"
+#include "InputSequence.h"
+#include "InputSequenceAsset.h"
+#include "InputSequenceGraphText.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/SavePackage.h"
+
+UInputSequenceImportCommandlet::UInputSequenceImportCommandlet(const FObjectInitializer& ObjectInitializer) :Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UInputSequenceImportCommandlet::Main(const FString& Params)
+{
+	FString directory;
+	FString packagePath;
+	if (!FParse::Value(*Params, TEXT("source="), directory) || !FParse::Value(*Params, TEXT("dest="), packagePath))
+	{
+		UE_LOG(LogInputSequence, Error, TEXT("Usage: -run=InputSequenceImport -source=<Directory> -dest=<PackagePath> [-export]"));
+		return 1;
+	}
+
+	return FParse::Param(*Params, TEXT("export")) ? Export(directory, packagePath) : Import(directory, packagePath);
+}
+
+int32 UInputSequenceImportCommandlet::Import(const FString& directory, const FString& packagePath)
+{
+	const double startTime = FPlatformTime::Seconds();
+
+	TArray<FString> fileNames;
+	IFileManager::Get().FindFiles(fileNames, *FPaths::Combine(directory, TEXT("*.jsonl")), true, false);
+
+	// Reading and parsing touch no UObjects, so files are processed in parallel
+
+	TArray<FInputSequenceGraphDocument> documents;
+	documents.SetNum(fileNames.Num());
+
+	TArray<FString> errors;
+	errors.SetNum(fileNames.Num());
+
+	ParallelFor(fileNames.Num(), [&](int32 index)
+		{
+			FString text;
+			if (!FFileHelper::LoadFileToString(text, *FPaths::Combine(directory, fileNames[index])))
+			{
+				errors[index] = TEXT("file can not be read");
+				return;
+			}
+
+			FInputSequenceGraphText::Parse(text, documents[index], errors[index]);
+		});
+
+	const double parseTime = FPlatformTime::Seconds();
+
+	int32 numFailed = 0;
+	int32 numNodes = 0;
+
+	for (int32 i = 0; i < fileNames.Num(); i++)
+	{
+		if (errors[i].IsEmpty())
+		{
+			const FString assetName = FPaths::GetBaseFilename(fileNames[i]);
+			const FString packageName = FPaths::Combine(packagePath, assetName);
+
+			UPackage* package = FPackageName::DoesPackageExist(packageName) ? LoadPackage(nullptr, *packageName, LOAD_None) : CreatePackage(*packageName);
+
+			UInputSequenceAsset* asset = package ? FindObject<UInputSequenceAsset>(package, *assetName) : nullptr;
+
+			if (package && !asset)
+			{
+				asset = NewObject<UInputSequenceAsset>(package, FName(*assetName), RF_Public | RF_Standalone);
+				FAssetRegistryModule::AssetCreated(asset);
+			}
+
+			if (!asset)
+			{
+				errors[i] = TEXT("asset can not be created");
+			}
+			else if (FInputSequenceGraphText::Import(asset, documents[i], errors[i]))
+			{
+				FSavePackageArgs saveArgs;
+				saveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+				if (UPackage::SavePackage(package, asset, *FPackageName::LongPackageNameToFilename(packageName, FPackageName::GetAssetPackageExtension()), saveArgs))
+				{
+					UE_LOG(LogInputSequence, Display, TEXT("Imported %s into %s: %d nodes, %d links"), *fileNames[i], *packageName, documents[i].Nodes.Num(), documents[i].Links.Num());
+
+					numNodes += documents[i].Nodes.Num();
+					continue;
+				}
+
+				errors[i] = TEXT("package can not be saved");
+			}
+		}
+
+		UE_LOG(LogInputSequence, Error, TEXT("Failed to import %s: %s"), *fileNames[i], *errors[i]);
+		numFailed++;
+	}
+
+	UE_LOG(LogInputSequence, Display, TEXT("Imported %d of %d files, %d nodes: parsed in %.2f s, built and saved in %.2f s"),
+		fileNames.Num() - numFailed, fileNames.Num(), numNodes, parseTime - startTime, FPlatformTime::Seconds() - parseTime);
+
+	return numFailed > 0 ? 1 : 0;
+}
+
+int32 UInputSequenceImportCommandlet::Export(const FString& directory, const FString& packagePath)
+{
+	IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	assetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> assets;
+	assetRegistry.GetAssetsByPath(FName(*packagePath), assets, true);
+
+	int32 numFailed = 0;
+	int32 numExported = 0;
+
+	for (const FAssetData& assetData : assets)
+	{
+		if (!assetData.IsInstanceOf(UInputSequenceAsset::StaticClass())) continue;
+
+		const UInputSequenceAsset* asset = Cast<UInputSequenceAsset>(assetData.GetAsset());
+
+		FString text;
+		FInputSequenceGraphText::Export(asset, text);
+
+		const FString filePath = FPaths::Combine(directory, assetData.AssetName.ToString() + TEXT(".jsonl"));
+
+		if (asset && FFileHelper::SaveStringToFile(text, *filePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogInputSequence, Display, TEXT("Exported %s into %s"), *assetData.GetObjectPathString(), *filePath);
+			numExported++;
+		}
+		else
+		{
+			UE_LOG(LogInputSequence, Error, TEXT("Failed to export %s"), *assetData.GetObjectPathString());
+			numFailed++;
+		}
+	}
+
+	UE_LOG(LogInputSequence, Display, TEXT("Exported %d Input Sequence Assets"), numExported);
+
+	return numFailed > 0 ? 1 : 0;
+}
\ No newline at end of file
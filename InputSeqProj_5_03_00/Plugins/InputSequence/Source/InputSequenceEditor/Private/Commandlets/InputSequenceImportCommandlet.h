@@ -0,0 +1,26 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "InputSequenceImportCommandlet.generated.h"
+
+/* Imports every *.jsonl file of directory (see FInputSequenceGraphText) into asset of the same name under package path, creating assets that do not exist:
+ * UnrealEditor-Cmd <Project> -run=InputSequenceImport -source=<Directory> -dest=<PackagePath> [-export]
+ * Files are read and parsed in parallel, assets are built and saved on game thread. With -export, assets under package path are written into directory instead.
+ */
+UCLASS()
+class UInputSequenceImportCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+
+	int32 Import(const FString& directory, const FString& packagePath);
+
+	int32 Export(const FString& directory, const FString& packagePath);
+};
\ No newline at end of file
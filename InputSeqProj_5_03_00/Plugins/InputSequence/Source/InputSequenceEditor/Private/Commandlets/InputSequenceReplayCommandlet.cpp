@@ -0,0 +1,118 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "Commandlets/InputSequenceReplayCommandlet.h"
+#include "InputSequence.h"
+#include "InputSequenceAsset.h"
+#include "InputSequenceRecording.h"
+#include "Misc/Parse.h"
+
+UInputSequenceReplayCommandlet::UInputSequenceReplayCommandlet(const FObjectInitializer& ObjectInitializer) :Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UInputSequenceReplayCommandlet::Main(const FString& Params)
+{
+	FString recordingPath;
+	if (!FParse::Value(*Params, TEXT("recording="), recordingPath))
+	{
+		UE_LOG(LogInputSequence, Error, TEXT("Usage: -run=InputSequenceReplay -recording=<Path> [-asset=<AssetPath>] [-quiet]"));
+		return 1;
+	}
+
+	FInputSequenceRecordingReader reader;
+	if (!reader.LoadFromFile(recordingPath)) return 1;
+
+	FString assetPath = reader.GetAssetPath();
+	FParse::Value(*Params, TEXT("asset="), assetPath);
+
+	const bool bQuiet = FParse::Param(*Params, TEXT("quiet"));
+
+	UInputSequenceAsset* asset = LoadObject<UInputSequenceAsset>(nullptr, *assetPath);
+	if (!asset)
+	{
+		UE_LOG(LogInputSequence, Error, TEXT("Failed to load Input Sequence Asset %s"), *assetPath);
+		return 1;
+	}
+
+	// Replay on a copy, so loaded asset keeps its runtime state
+
+	UInputSequenceAsset* instance = DuplicateObject<UInputSequenceAsset>(asset, GetTransientPackage());
+	instance->AddToRoot();
+
+	FInputSequenceRecordedFrame frame;
+	FInputSequenceRecordedReset reset;
+
+	TArray<InputSequenceCore::FActionInput> actionInputs;
+	TArray<InputSequenceCore::FAxisInput> axisInputs;
+
+	TArray<FInputSequenceEventCall> eventCalls;
+	TArray<FInputSequenceResetSource> resetSources;
+
+	int64 numFrames = 0;
+	int64 numResets = 0;
+	int64 numEventCalls = 0;
+	uint64 totalCycles = 0;
+
+	for (FInputSequenceRecordingReader::ERecord record = reader.ReadNext(frame, reset); record != FInputSequenceRecordingReader::ERecord::End; record = reader.ReadNext(frame, reset))
+	{
+		if (record == FInputSequenceRecordingReader::ERecord::Reset)
+		{
+			UObject* sourceObject = reset.SourcePath.IsEmpty() ? nullptr : FindObject<UObject>(nullptr, *reset.SourcePath);
+			instance->RequestReset(sourceObject, reset.SourceContext);
+
+			numResets++;
+
+			if (!bQuiet) UE_LOG(LogInputSequence, Display, TEXT("[%lld] RequestReset %s %s"), numFrames, *reset.SourcePath, *reset.SourceContext);
+
+			continue;
+		}
+
+		// Native input carries all components of 2D and 3D axes, names are resolved before timing starts
+
+		actionInputs.Reset();
+		axisInputs.Reset();
+
+		for (const TPair<FName, TEnumAsByte<EInputEvent>>& actionEvent : frame.ActionEvents)
+		{
+			actionInputs.Add({ instance->GetNameId(actionEvent.Key), (InputSequenceCore::EInputEvent)actionEvent.Value.GetValue() });
+		}
+
+		for (const TPair<FName, FVector3f>& axisEvent : frame.AxisEvents)
+		{
+			axisInputs.Add({ instance->GetNameId(axisEvent.Key), axisEvent.Value.X, axisEvent.Value.Y, axisEvent.Value.Z });
+		}
+
+		eventCalls.Reset();
+		resetSources.Reset();
+
+		const uint64 startCycles = FPlatformTime::Cycles64();
+
+		instance->OnNativeInput(frame.DeltaTime, frame.bGamePaused, actionInputs, axisInputs, eventCalls, resetSources);
+
+		totalCycles += FPlatformTime::Cycles64() - startCycles;
+
+		if (!bQuiet)
+		{
+			for (const FInputSequenceEventCall& eventCall : eventCalls)
+			{
+				UE_LOG(LogInputSequence, Display, TEXT("[%lld] %s State=%d Object=%s Context=%s"), numFrames, *GetNameSafe(eventCall.EventClass.Get()), eventCall.Index, *GetNameSafe(eventCall.Object), *eventCall.Context);
+			}
+		}
+
+		numEventCalls += eventCalls.Num();
+		numFrames++;
+	}
+
+	instance->RemoveFromRoot();
+
+	const double totalSeconds = FPlatformTime::ToSeconds64(totalCycles);
+
+	UE_LOG(LogInputSequence, Display, TEXT("Replayed %s against %s: %lld frames, %lld resets, %lld event calls, %.3f ms total, %.1f ns/frame"),
+		*recordingPath, *assetPath, numFrames, numResets, numEventCalls, totalSeconds * 1e3, numFrames > 0 ? totalSeconds * 1e9 / numFrames : 0.0);
+
+	return reader.IsError() ? 1 : 0;
+}
\ No newline at end of file
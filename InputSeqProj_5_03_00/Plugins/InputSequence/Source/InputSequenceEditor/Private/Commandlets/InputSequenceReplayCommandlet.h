@@ -0,0 +1,20 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "InputSequenceReplayCommandlet.generated.h"
+
+/* Replays recording made by InputSequence.Record against asset at maximum speed and prints Event calls and timing:
+ * UnrealEditor-Cmd <Project> -run=InputSequenceReplay -nullrhi -recording=<Path> [-asset=<AssetPath>] [-quiet]
+ * Asset defaults to the one recording was made from. With -quiet only summary is printed.
+ */
+UCLASS()
+class UInputSequenceReplayCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	virtual int32 Main(const FString& Params) override;
+};
\ No newline at end of file
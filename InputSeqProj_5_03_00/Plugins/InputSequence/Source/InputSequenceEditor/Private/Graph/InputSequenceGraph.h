@@ -3,8 +3,35 @@
 #pragma once
 
 #include "EdGraph/EdGraph.h"
+#include "Containers/Ticker.h"
+#include "InputSequenceAsset.h"
 #include "InputSequenceGraph.generated.h"
 
+/* Live state of node in debugged runtime instance, written by asset editor while debugger is attached */
+struct FInputSequenceDebugNodeState
+{
+	bool bIsActive = false;
+
+	/* Part of timer of active state that is elapsed, negative if state is not timed */
+	float TimerProgress = -1;
+
+	InputSequenceCore::EStateEvent LastEvent = InputSequenceCore::EStateEvent::Enter;
+
+	/* FPlatformTime::Seconds of last event */
+	double LastEventTime = 0;
+};
+
+/* Hit counts of node summed over states it is compiled into, written by asset editor while heatmap is shown */
+struct FInputSequenceHeatmapNodeState
+{
+	uint64 NumEnters = 0;
+	uint64 NumPasses = 0;
+	uint64 NumResets = 0;
+
+	/* Enters relative to the most entered node on log scale, so rarely entered nodes are still told apart */
+	float Heat = 0;
+};
+
 UCLASS()
 class UInputSequenceGraph : public UEdGraph
 {
@@ -12,5 +39,63 @@ class UInputSequenceGraph : public UEdGraph
 
 public:
 
+	virtual void Serialize(FArchive& Ar) override;
+
 	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+
+	using UEdGraph::NotifyGraphChanged;
+
+	virtual void NotifyGraphChanged(const FEdGraphEditAction& Action) override;
+
+	virtual void PostEditUndo() override;
+
+	virtual void BeginDestroy() override;
+
+	/* Walks graph from Start node and fills States in breadth-first order. Node gets one state per First Layer parent and set of pressed actions it is reached with, not one per path. Nodes that are not dirty reuse their cached compiled part. Graph node of every state and warnings of reached nodes can be collected as well */
+	void CompileStates(TArray<FInputSequenceState>& outStates, TArray<UEdGraphNode*>* outStateNodes = nullptr, TArray<FString>* outWarnings = nullptr) const;
+
+	/* Drops cached compiled part of node and schedules live compile of the asset */
+	void MarkNodeDirty(const UEdGraphNode* node);
+
+	void MarkAllNodesDirty();
+
+	/* Debug state of node, nullptr if debugger is not attached or node had no state events yet */
+	const FInputSequenceDebugNodeState* GetDebugNodeState(const FGuid& nodeGuid) const { return DebugNodeStates.Find(nodeGuid); }
+
+	/* Per node guid, empty while debugger is not attached */
+	TMap<FGuid, FInputSequenceDebugNodeState> DebugNodeStates;
+
+	/* Hit counts of node, nullptr if heatmap is not shown or node is not compiled into any state */
+	const FInputSequenceHeatmapNodeState* GetHeatmapNodeState(const FGuid& nodeGuid) const { return HeatmapNodeStates.Find(nodeGuid); }
+
+	/* Per node guid, empty while heatmap is not shown */
+	TMap<FGuid, FInputSequenceHeatmapNodeState> HeatmapNodeStates;
+
+	/* Hash of graph that States and compiled data of asset were last compiled from, see FInputSequenceCompiler::HashGraph */
+	FIoHash CompiledGraphHash;
+
+protected:
+
+	/* Part of state that depends on node only, shared by all states the node is compiled into */
+	struct FCompiledNode
+	{
+		FInputSequenceState State;
+
+		// Actions kept pressed for next states
+		TArray<FName> PressedActions;
+
+		// Actions released by the node
+		TArray<FName> ReleasedActions;
+
+		// Kept with cached part, so node that is not compiled again still reports them
+		TArray<FString> Warnings;
+	};
+
+	void CompileNode(UEdGraphNode* node, FCompiledNode& outCompiledNode) const;
+
+	void ScheduleLiveCompile();
+
+	mutable TMap<FGuid, FCompiledNode> CompiledNodes;
+
+	FTSTicker::FDelegateHandle LiveCompileHandle;
 };
\ No newline at end of file
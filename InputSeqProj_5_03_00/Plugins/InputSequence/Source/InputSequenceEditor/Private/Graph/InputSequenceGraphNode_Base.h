@@ -13,4 +13,20 @@ class UInputSequenceGraphNode_Base : public UEdGraphNode
 public:
 
 	virtual void AutowireNewNode(UEdGraphPin* FromPin) override;
+
+	// Any edit of node makes its compiled part stale
+
+	virtual bool Modify(bool bAlwaysMarkDirty = true) override;
+
+	virtual void PinDefaultValueChanged(UEdGraphPin* Pin) override;
+
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	virtual void PostEditUndo() override;
+
+protected:
+
+	void MarkCompileDirty();
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Graph/InputSequenceGraphNode_Axis.h"
+#include "InputSequenceGraphNode_Gesture.generated.h"
+
+struct FInputSequenceAxisRegion;
+
+/* Axis node that is passed when stick goes through its whole path of directions, each 2D axis pin is one stick */
+UCLASS()
+class UInputSequenceGraphNode_Gesture : public UInputSequenceGraphNode_Axis
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+
+	virtual FText GetTooltipText() const override;
+
+	/* Direction zones of path, compiled into 2D cones */
+	TArray<FInputSequenceAxisRegion> GetGestureSteps() const;
+
+	float GetMaxDuration() const { return MaxDuration; }
+
+protected:
+
+	/* Directions of path in degrees, counter-clockwise from +X (forward). Quarter-circle forward is -90, -45, 0, dragon punch is 0, -90, -45 */
+	UPROPERTY(EditAnywhere, Category = "Gesture node", meta = (DisplayPriority = 40))
+		TArray<float> Directions;
+
+	/* Max deviation of stick from each direction in degrees */
+	UPROPERTY(EditAnywhere, Category = "Gesture node", meta = (DisplayPriority = 41, UIMin = 1, Min = 1, UIMax = 90, Max = 180))
+		float Tolerance;
+
+	/* Stick values shorter than this are dead zone, they neither advance nor break path */
+	UPROPERTY(EditAnywhere, Category = "Gesture node", meta = (DisplayPriority = 42, UIMin = 0, Min = 0, UIMax = 1))
+		float MinMagnitude;
+
+	/* Time to go from first direction to last one */
+	UPROPERTY(EditAnywhere, Category = "Gesture node", meta = (DisplayPriority = 43, UIMin = 0.01, Min = 0.01, UIMax = 2))
+		float MaxDuration;
+};
\ No newline at end of file
@@ -40,6 +40,8 @@ public:
 
 	TMap<FName, TObjectPtr<UObject>>& GetPinsInputActions() { return PinsInputActions; }
 
+	const TMap<FName, TObjectPtr<UObject>>& GetPinsInputActions() const { return PinsInputActions; }
+
 protected:
 
 	UPROPERTY()
@@ -12,6 +12,7 @@
 #include "Graph/InputSequenceGraphNode_Release.h"
 #include "Graph/InputSequenceGraphNode_Start.h"
 #include "Graph/InputSequenceGraphNode_Axis.h"
+#include "Graph/InputSequenceGraphNode_Gesture.h"
 #include "Graph/SInputSequenceGraphNode_Dynamic.h"
 
 #include "KismetPins/SGraphPinExec.h"
@@ -19,11 +20,19 @@
 #include "Graph/SGraphPin_Action.h"
 #include "Graph/SGraphPin_Add.h"
 #include "Graph/SGraphPin_Axis.h"
+#include "Graph/SGraphPin_AxisRegion.h"
 #include "Graph/SGraphPin_HubAdd.h"
 #include "Graph/SGraphPin_HubExec.h"
 
 #include "InputSequenceAssetEditor.h"
+#include "InputSequence.h"
 #include "InputSequenceAsset.h"
+#include "InputSequenceCompiler.h"
+#include "InputSequenceAnalyzer.h"
+#include "InputSequenceInputActionIndex.h"
+#include "InputSequenceEditorCommands.h"
+#include "InputSequenceGraphLayout.h"
+#include "InputSequenceHitCounters.h"
 #include "GraphEditorActions.h"
 #include "HAL/PlatformApplicationMisc.h"
 #include "Framework/Commands/GenericCommands.h"
@@ -37,14 +46,28 @@
 #include "Widgets/Layout/SGridPanel.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Input/SNumericEntryBox.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SHyperlink.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Layout/SSeparator.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "UObject/ObjectSaveContext.h"
 #include "SGraphPanel.h"
+#include "Editor.h"
+#include "DesktopPlatformModule.h"
+#include "IDesktopPlatform.h"
 
-#include "AssetRegistry/AssetRegistryModule.h"
 #include "InputAction.h"
 
 const FString separator = " ^ ";
 
+// Seconds that debugged state events stay highlighted on nodes
+const float DebugFlashTime = 0.5f;
+
+// Seconds between reads of live hit counts for heatmap
+const float HeatmapTickInterval = 0.25f;
+
 template<class T>
 TSharedPtr<T> AddNewActionAs(FGraphContextMenuBuilder& ContextMenuBuilder, const FText& Category, const FText& MenuDesc, const FText& Tooltip, const int32 Grouping = 0)
 {
@@ -86,6 +109,20 @@ void AddPin(UEdGraphNode* node, FName category, FName pinName, const UEdGraphNod
 	}
 }
 
+/* Enhanced Input Axis2D pins compile into 2D regions, anything else into 3D */
+uint8 GetAxisRegionNumDimensions(const UEdGraphPin* pin)
+{
+	if (UInputSequenceGraphNode_Input* inputNode = Cast<UInputSequenceGraphNode_Input>(pin->GetOwningNode()))
+	{
+		if (const UInputAction* inputAction = Cast<UInputAction>(inputNode->GetPinsInputActions().FindRef(pin->PinName)))
+		{
+			return inputAction->ValueType == EInputActionValueType::Axis2D ? 2 : 3;
+		}
+	}
+
+	return 3;
+}
+
 class FInputSequenceConnectionDrawingPolicy : public FConnectionDrawingPolicy
 {
 public:
@@ -172,6 +209,8 @@ TSharedPtr<SGraphPin> FInputSequenceGraphPinFactory::CreatePin(UEdGraphPin* InPi
 
 		if (InPin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Axis) return SNew(SGraphPin_Axis, InPin);
 
+		if (InPin->PinType.PinCategory == UInputSequenceGraphSchema::PC_AxisRegion) return SNew(SGraphPin_AxisRegion, InPin);
+
 		if (InPin->PinType.PinCategory == UInputSequenceGraphSchema::PC_HubAdd) return SNew(SGraphPin_HubAdd, InPin);
 	}
 
@@ -223,197 +262,404 @@ void GetNextNodes(UEdGraphNode* node, TArray<UEdGraphNode*>& outNextNodes)
 	}
 }
 
+void UInputSequenceGraph::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	Ar.UsingCustomVersion(FInputSequenceCustomVersion::GUID);
+
+	if (Ar.CustomVer(FInputSequenceCustomVersion::GUID) >= FInputSequenceCustomVersion::CompiledGraphHash)
+	{
+		Ar << CompiledGraphHash;
+	}
+}
+
 void UInputSequenceGraph::PreSave(FObjectPreSaveContext SaveContext)
 {
 	Super::PreSave(SaveContext);
 
 	if (UInputSequenceAsset* inputSequenceAsset = GetTypedOuter<UInputSequenceAsset>())
 	{
-		inputSequenceAsset->States.Empty();
+		FInputSequenceCompiler::Compile(inputSequenceAsset, false);
+	}
+}
+
+void UInputSequenceGraph::CompileStates(TArray<FInputSequenceState>& outStates, TArray<UEdGraphNode*>* outStateNodes, TArray<FString>* outWarnings) const
+{
+	outStates.Empty();
+
+	if (outStateNodes) outStateNodes->Reset();
+
+	if (outWarnings) outWarnings->Reset();
 
-		struct FGuidCollection
+	if (Nodes.Num() > 0)
+	{
+		/* Node reached with the same First Layer parent and the same pressed actions behaves the same way whatever path it is reached by, so it is one state */
+		struct FStateKey
 		{
-			TArray<FGuid> Guids;
+			FGuid NodeGuid;
+			int32 FirstLayerParentIndex = INDEX_NONE;
+			TArray<FName> PressedActions;
+
+			FStateKey(const UEdGraphNode* node, const int32 firstLayerParentIndex, const TSet<FName>& pressedActions)
+				: NodeGuid(node->NodeGuid)
+				, FirstLayerParentIndex(firstLayerParentIndex)
+				, PressedActions(pressedActions.Array())
+			{
+				PressedActions.Sort(FNameFastLess());
+			}
+
+			bool operator==(const FStateKey& other) const { return NodeGuid == other.NodeGuid && FirstLayerParentIndex == other.FirstLayerParentIndex && PressedActions == other.PressedActions; }
+
+			friend uint32 GetTypeHash(const FStateKey& key)
+			{
+				uint32 hash = HashCombine(GetTypeHash(key.NodeGuid), GetTypeHash(key.FirstLayerParentIndex));
+				for (const FName& pressedAction : key.PressedActions) hash = HashCombine(hash, GetTypeHash(pressedAction));
+
+				return hash;
+			}
 		};
 
 		struct FNodesQueueEntry
 		{
 			UEdGraphNode* Node = nullptr;
-			int32 DepthIndex = 0;
-			int32 FirstLayerParentIndex = INDEX_NONE;
-			TSet<FName> PressedActions;
+			int32 StateIndex = INDEX_NONE;
 
-			FNodesQueueEntry(UEdGraphNode* const node = nullptr, const int depthIndex = 0, const int32 firstLayerParentIndex = INDEX_NONE, const TSet<FName>& pressedActions = {})
+			FNodesQueueEntry(UEdGraphNode* const node = nullptr, const int32 stateIndex = INDEX_NONE)
 				: Node(node)
-				, DepthIndex(depthIndex)
-				, FirstLayerParentIndex(firstLayerParentIndex)
-				, PressedActions(pressedActions)
+				, StateIndex(stateIndex)
 			{}
 		};
 
-		TArray<FGuidCollection> linkedNodesMapping;
+		TMap<FStateKey, int32> stateIndice;
+
+		// States are emplaced when first reached, so every other path to the same state just links to it
+
+		auto findOrAddState = [&](UEdGraphNode* node, const int32 depthIndex, const int32 firstLayerParentIndex, const TSet<FName>& pressedActions, TQueue<FNodesQueueEntry>& queue) -> int32
+		{
+			FStateKey stateKey(node, firstLayerParentIndex, pressedActions);
+
+			if (const int32* stateIndex = stateIndice.Find(stateKey)) return *stateIndex;
+
+			const int32 emplacedIndex = outStates.Emplace();
+
+			FInputSequenceState& state = outStates[emplacedIndex];
+			state.DepthIndex = depthIndex;
+			state.FirstLayerParentIndex = firstLayerParentIndex;
+			state.PressedActions = pressedActions;
+
+			if (outStateNodes) outStateNodes->Add(node);
 
-		TMap<FGuid, int> indexMapping;
+			stateIndice.Add(MoveTemp(stateKey), emplacedIndex);
+			queue.Enqueue(FNodesQueueEntry(node, emplacedIndex));
+
+			return emplacedIndex;
+		};
+
+		TSet<FGuid> visitedNodes;
 
 		TQueue<FNodesQueueEntry> graphNodesQueue;
-		graphNodesQueue.Enqueue(FNodesQueueEntry(Nodes[0], 0, INDEX_NONE));
+		findOrAddState(Nodes[0], 0, INDEX_NONE, {}, graphNodesQueue);
 
-		FNodesQueueEntry currentGraphNodeEntry(nullptr, INDEX_NONE);
+		FNodesQueueEntry currentGraphNodeEntry;
 		while (graphNodesQueue.Dequeue(currentGraphNodeEntry))
 		{
-			int32 emplacedIndex = inputSequenceAsset->States.Emplace();
-			indexMapping.Add(currentGraphNodeEntry.Node->NodeGuid, emplacedIndex);
+			const int32 emplacedIndex = currentGraphNodeEntry.StateIndex;
+
+			FInputSequenceState& state = outStates[emplacedIndex];
 
-			linkedNodesMapping.Emplace();
+			FCompiledNode* compiledNode = CompiledNodes.Find(currentGraphNodeEntry.Node->NodeGuid);
 
-			FInputSequenceState& state = inputSequenceAsset->States[emplacedIndex];
-			state.DepthIndex = currentGraphNodeEntry.DepthIndex;
-			state.FirstLayerParentIndex = currentGraphNodeEntry.FirstLayerParentIndex;
-			state.PressedActions = currentGraphNodeEntry.PressedActions;
+			if (!compiledNode)
+			{
+				compiledNode = &CompiledNodes.Add(currentGraphNodeEntry.Node->NodeGuid);
+				CompileNode(currentGraphNodeEntry.Node, *compiledNode);
+			}
+
+			bool bIsAlreadyVisited = false;
+			visitedNodes.Add(currentGraphNodeEntry.Node->NodeGuid, &bIsAlreadyVisited);
+
+			if (outWarnings && !bIsAlreadyVisited) outWarnings->Append(compiledNode->Warnings);
+
+			// Node part is shared by all states of node, path part is restored over it
+
+			const int32 depthIndex = state.DepthIndex;
+			const int32 firstLayerParentIndex = state.FirstLayerParentIndex;
+			TSet<FName> pressedActions = MoveTemp(state.PressedActions);
+
+			state = compiledNode->State;
+			state.DepthIndex = depthIndex;
+			state.FirstLayerParentIndex = firstLayerParentIndex;
+			state.PressedActions = pressedActions;
+
+			pressedActions.Append(compiledNode->PressedActions);
 
-			TSet<FName> pressedActions = currentGraphNodeEntry.PressedActions;
+			for (const FName& releasedAction : compiledNode->ReleasedActions)
+			{
+				state.PressedActions.Remove(releasedAction);
+				pressedActions.Remove(releasedAction);
+			}
+
+			TArray<UEdGraphNode*> linkedNodes;
+			GetNextNodes(currentGraphNodeEntry.Node, linkedNodes);
+
+			const int32 nextDepthIndex = depthIndex + 1;
+			const int32 nextFirstLayerParentIndex = firstLayerParentIndex > 0 ? firstLayerParentIndex : emplacedIndex;
 
-			if (UInputSequenceGraphNode_Input* inputNode = Cast<UInputSequenceGraphNode_Input>(currentGraphNodeEntry.Node))
+			// States array may grow below, so state is not referred to anymore
+
+			for (UEdGraphNode* linkedNode : linkedNodes)
 			{
-				state.IsInputNode = 1;
+				const int32 nextIndex = findOrAddState(linkedNode, nextDepthIndex, nextFirstLayerParentIndex, pressedActions, graphNodesQueue);
 
-				state.StateObject = inputNode->GetStateObject();
-				state.StateContext = inputNode->GetStateContext();
-				state.EnterEventClasses = inputNode->GetEnterEventClasses();
-				state.PassEventClasses = inputNode->GetPassEventClasses();
-				state.ResetEventClasses = inputNode->GetResetEventClasses();
+				outStates[emplacedIndex].NextIndice.Add(nextIndex);
+			}
+		}
+
+		// Nodes removed from graph or unreachable anymore are not kept
+
+		for (TMap<FGuid, FCompiledNode>::TIterator It(CompiledNodes); It; ++It)
+		{
+			if (!visitedNodes.Contains(It.Key())) It.RemoveCurrent();
+		}
+	}
+	else
+	{
+		CompiledNodes.Empty();
+	}
+}
+
+void UInputSequenceGraph::CompileNode(UEdGraphNode* node, FCompiledNode& outCompiledNode) const
+{
+	FInputSequenceState& state = outCompiledNode.State;
+
+	if (UInputSequenceGraphNode_Input* inputNode = Cast<UInputSequenceGraphNode_Input>(node))
+	{
+		state.IsInputNode = 1;
+
+		state.StateObject = inputNode->GetStateObject();
+		state.StateContext = inputNode->GetStateContext();
+		state.EnterEventClasses = inputNode->GetEnterEventClasses();
+		state.PassEventClasses = inputNode->GetPassEventClasses();
+		state.ResetEventClasses = inputNode->GetResetEventClasses();
 
-				state.isOverridingRequirePreciseMatch = inputNode->IsOverridingRequirePreciseMatch();
-				state.requirePreciseMatch = inputNode->RequirePreciseMatch();
+		state.isOverridingRequirePreciseMatch = inputNode->IsOverridingRequirePreciseMatch();
+		state.requirePreciseMatch = inputNode->RequirePreciseMatch();
 
-				state.isOverridingResetAfterTime = inputNode->IsOverridingResetAfterTime();
-				state.isResetAfterTime = inputNode->IsResetAfterTime();
+		state.isOverridingResetAfterTime = inputNode->IsOverridingResetAfterTime();
+		state.isResetAfterTime = inputNode->IsResetAfterTime();
 
-				state.TimeParam = inputNode->GetResetAfterTime();
+		state.TimeParam = inputNode->GetResetAfterTime();
 
-				if (UInputSequenceGraphNode_Press* pressNode = Cast<UInputSequenceGraphNode_Press>(currentGraphNodeEntry.Node))
+		if (UInputSequenceGraphNode_Press* pressNode = Cast<UInputSequenceGraphNode_Press>(node))
+		{
+			for (UEdGraphPin* pin : pressNode->Pins)
+			{
+				if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Action)
 				{
-					for (UEdGraphPin* pin : pressNode->Pins)
+					if (pin->LinkedTo.Num() == 0)
 					{
-						if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Action)
-						{
-							if (pin->LinkedTo.Num() == 0)
-							{
-								static FInputActionState waitForPressAndRelease({ IE_Pressed, IE_Released });
-								state.InputActions.Add(pin->PinName, waitForPressAndRelease);
-							}
-							else
-							{
-								static FInputActionState waitForPress({ IE_Pressed });
-								state.InputActions.Add(pin->PinName, waitForPress);
+						static FInputActionState waitForPressAndRelease({ IE_Pressed, IE_Released });
+						state.InputActions.Add(pin->PinName, waitForPressAndRelease);
+					}
+					else
+					{
+						static FInputActionState waitForPress({ IE_Pressed });
+						state.InputActions.Add(pin->PinName, waitForPress);
 
-								pressedActions.Add(pin->PinName);
-							}
-						}
+						outCompiledNode.PressedActions.Add(pin->PinName);
 					}
 				}
-				else if (UInputSequenceGraphNode_Release* releaseNode = Cast<UInputSequenceGraphNode_Release>(currentGraphNodeEntry.Node))
+			}
+		}
+		else if (UInputSequenceGraphNode_Release* releaseNode = Cast<UInputSequenceGraphNode_Release>(node))
+		{
+			for (UEdGraphPin* pin : releaseNode->Pins)
+			{
+				if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Action)
+				{
+					static FInputActionState waitForRelease({ IE_Released });
+					state.InputActions.Add(pin->PinName, waitForRelease);
+					outCompiledNode.ReleasedActions.Add(pin->PinName);
+				}
+			}
+
+			state.canBePassedAfterTime = releaseNode->CanBePassedAfterTime();
+			if (state.canBePassedAfterTime)
+			{
+				state.TimeParam = releaseNode->GetPassedAfterTime();
+			}
+		}
+		else if (UInputSequenceGraphNode_Gesture* gestureNode = Cast<UInputSequenceGraphNode_Gesture>(node))
+		{
+			state.IsAxisNode = 1;
+			state.IsGestureNode = 1;
+
+			const TArray<FInputSequenceAxisRegion> gestureSteps = gestureNode->GetGestureSteps();
+
+			if (gestureSteps.Num() > 0)
+			{
+				for (UEdGraphPin* pin : gestureNode->Pins)
 				{
-					for (UEdGraphPin* pin : releaseNode->Pins)
+					if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_2DAxis)
 					{
-						if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Action)
+						FString lhs;
+						FString rhs;
+						if (pin->PinName.ToString().Split(separator, &lhs, &rhs))
 						{
-							static FInputActionState waitForRelease({ IE_Released });
-							state.InputActions.Add(pin->PinName, waitForRelease);
-							state.PressedActions.Remove(pin->PinName);
-							
-							pressedActions.Remove(pin->PinName);
+							state.InputActions.Add(pin->PinName, FInputActionState(gestureSteps, gestureNode->GetMaxDuration(), lhs, rhs));
 						}
 					}
-
-					state.canBePassedAfterTime = releaseNode->CanBePassedAfterTime();
-					if (state.canBePassedAfterTime)
+					else if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_AxisRegion)
 					{
-						state.TimeParam = releaseNode->GetPassedAfterTime();
+						state.InputActions.Add(pin->PinName, FInputActionState(gestureSteps, gestureNode->GetMaxDuration()));
 					}
 				}
-				else if (UInputSequenceGraphNode_Axis* axisNode = Cast<UInputSequenceGraphNode_Axis>(currentGraphNodeEntry.Node))
-				{
-					state.IsAxisNode = 1;
-
-					for (UEdGraphPin* pin : axisNode->Pins)
-					{
-						if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Axis)
-						{
-							FString DefaultString = pin->GetDefaultAsString();
+			}
+		}
+		else if (UInputSequenceGraphNode_Axis* axisNode = Cast<UInputSequenceGraphNode_Axis>(node))
+		{
+			state.IsAxisNode = 1;
 
-							FVector2D Value;
-							Value.InitFromString(DefaultString);
+			for (UEdGraphPin* pin : axisNode->Pins)
+			{
+				if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Axis)
+				{
+					FString DefaultString = pin->GetDefaultAsString();
 
-							state.InputActions.Add(pin->PinName, FInputActionState({}, Value.X, Value.Y));
-						}
-						else if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_2DAxis)
-						{
-							FString DefaultString = pin->GetDefaultAsString();
+					FVector2D Value;
+					Value.InitFromString(DefaultString);
 
-							FVector Value;
-							Value.InitFromString(DefaultString);
+					state.InputActions.Add(pin->PinName, FInputActionState({}, Value.X, Value.Y));
+				}
+				else if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_2DAxis)
+				{
+					FString DefaultString = pin->GetDefaultAsString();
 
-							double xRad = FMath::DegreesToRadians(Value.X);
-							double yRad = FMath::DegreesToRadians(Value.Y);
+					FVector Value;
+					Value.InitFromString(DefaultString);
 
-							double startAngleRad = FMath::Min(xRad, yRad);
-							double endAngleRad = FMath::Max(xRad, yRad);
+					double xRad = FMath::DegreesToRadians(Value.X);
+					double yRad = FMath::DegreesToRadians(Value.Y);
 
-							// Full round
-							if (endAngleRad - startAngleRad > DOUBLE_TWO_PI)
-							{
-								startAngleRad = -DOUBLE_HALF_PI;
-								endAngleRad = DOUBLE_HALF_PI * 3;
-							}
-							else
-							{
-								while (startAngleRad < -DOUBLE_HALF_PI)
-								{
-									startAngleRad += DOUBLE_TWO_PI;
-									endAngleRad += DOUBLE_TWO_PI;
-								}
-							}
+					double startAngleRad = FMath::Min(xRad, yRad);
+					double endAngleRad = FMath::Max(xRad, yRad);
 
-							FString lhs;
-							FString rhs;
-							if (pin->PinName.ToString().Split(separator, &lhs, &rhs))
-							{
-								state.InputActions.Add(pin->PinName, FInputActionState({}, startAngleRad, endAngleRad, Value.Z, lhs, rhs));
-							}
+					// Full round
+					if (endAngleRad - startAngleRad > DOUBLE_TWO_PI)
+					{
+						startAngleRad = -DOUBLE_HALF_PI;
+						endAngleRad = DOUBLE_HALF_PI * 3;
+					}
+					else
+					{
+						while (startAngleRad < -DOUBLE_HALF_PI)
+						{
+							startAngleRad += DOUBLE_TWO_PI;
+							endAngleRad += DOUBLE_TWO_PI;
 						}
 					}
+
+					FString lhs;
+					FString rhs;
+					if (pin->PinName.ToString().Split(separator, &lhs, &rhs))
+					{
+						state.InputActions.Add(pin->PinName, FInputActionState({}, startAngleRad, endAngleRad, Value.Z, lhs, rhs));
+					}
 				}
-			}
-			else
-			{
-				UE_LOG(LogTemp, Warning, TEXT("!!!! %s"), *currentGraphNodeEntry.Node->GetClass()->GetName())
-			}
+				else if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_AxisRegion)
+				{
+					FInputSequenceAxisRegion region;
+					region.InitFromString(pin->GetDefaultAsString());
+					region.NumDimensions = GetAxisRegionNumDimensions(pin);
 
-			TArray<UEdGraphNode*> linkedNodes;
-			GetNextNodes(currentGraphNodeEntry.Node, linkedNodes);
+					state.InputActions.Add(pin->PinName, FInputActionState(region));
+				}
+			}
+		}
 
-			for (UEdGraphNode* linkedNode : linkedNodes)
+		for (const TPair<FName, TObjectPtr<UObject>>& pinInputAction : inputNode->GetPinsInputActions())
+		{
+			if (pinInputAction.Value && state.InputActions.Contains(pinInputAction.Key))
 			{
-				linkedNodesMapping[emplacedIndex].Guids.Add(linkedNode->NodeGuid);
-				graphNodesQueue.Enqueue(FNodesQueueEntry(linkedNode, currentGraphNodeEntry.DepthIndex + 1, currentGraphNodeEntry.FirstLayerParentIndex > 0 ? currentGraphNodeEntry.FirstLayerParentIndex : emplacedIndex, pressedActions));
+				state.InputActionObjects.Add(pinInputAction.Key, pinInputAction.Value);
 			}
 		}
+	}
+	else if (!node->IsA<UInputSequenceGraphNode_Start>() && !node->IsA<UInputSequenceGraphNode_GoToStart>())
+	{
+		// Start and Go To Start nodes are states without input, any other node is not known to compiler
 
-		for (size_t i = 0; i < inputSequenceAsset->States.Num(); i++)
-		{
-			if (linkedNodesMapping.IsValidIndex(i))
+		const FString warning = FString::Printf(TEXT("Node %s of unknown class %s is compiled into state without input"), *node->GetName(), *node->GetClass()->GetName());
+
+		UE_LOG(LogInputSequence, Warning, TEXT("%s: %s"), *GetPathName(), *warning);
+
+		outCompiledNode.Warnings.Add(warning);
+	}
+}
+
+void UInputSequenceGraph::MarkNodeDirty(const UEdGraphNode* node)
+{
+	if (node) CompiledNodes.Remove(node->NodeGuid);
+
+	ScheduleLiveCompile();
+}
+
+void UInputSequenceGraph::MarkAllNodesDirty()
+{
+	CompiledNodes.Empty();
+
+	ScheduleLiveCompile();
+}
+
+void UInputSequenceGraph::ScheduleLiveCompile()
+{
+	// Several edits of one frame (e.g. pasting or moving a selection) are compiled once
+
+	if (!LiveCompileHandle.IsValid())
+	{
+		LiveCompileHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float deltaTime)
 			{
-				for (FGuid& linkedGuid : linkedNodesMapping[i].Guids)
+				LiveCompileHandle.Reset();
+
+				if (UInputSequenceAsset* inputSequenceAsset = GetTypedOuter<UInputSequenceAsset>())
 				{
-					if (indexMapping.Contains(linkedGuid))
-					{
-						inputSequenceAsset->States[i].NextIndice.Add(indexMapping[linkedGuid]);
-					}
+					FInputSequenceCompiler::CompileLive(inputSequenceAsset);
 				}
-			}
-		}
+
+				return false;
+			}));
+	}
+}
+
+void UInputSequenceGraph::NotifyGraphChanged(const FEdGraphEditAction& Action)
+{
+	Super::NotifyGraphChanged(Action);
+
+	for (const UEdGraphNode* node : Action.Nodes)
+	{
+		if (node) CompiledNodes.Remove(node->NodeGuid);
+	}
+
+	ScheduleLiveCompile();
+}
+
+void UInputSequenceGraph::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	MarkAllNodesDirty();
+}
+
+void UInputSequenceGraph::BeginDestroy()
+{
+	if (LiveCompileHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(LiveCompileHandle);
+		LiveCompileHandle.Reset();
 	}
+
+	Super::BeginDestroy();
 }
 
 
@@ -492,9 +738,9 @@ UEdGraphNode* FInputSequenceGraphSchemaAction_AddPin::PerformAction(class UEdGra
 		UEdGraphNode::FCreatePinParams params;
 		params.Index = CorrectedInputIndex + execPinCount;
 		
-		const FName& pc = IsAxis ? (Is2DAxis ? UInputSequenceGraphSchema::PC_2DAxis : UInputSequenceGraphSchema::PC_Axis) : UInputSequenceGraphSchema::PC_Action;
+		const FName& pc = IsAxis ? (IsAxisRegion ? UInputSequenceGraphSchema::PC_AxisRegion : Is2DAxis ? UInputSequenceGraphSchema::PC_2DAxis : UInputSequenceGraphSchema::PC_Axis) : UInputSequenceGraphSchema::PC_Action;
 
-		AddPin(FromPin->GetOwningNode(), pc, InputName, params, InputAction);
+		AddPin(FromPin->GetOwningNode(), pc, InputName, params, InputAction.IsValid() ? InputAction.TryLoad() : nullptr);
 	}
 
 	return ResultNode;
@@ -510,6 +756,8 @@ const FName UInputSequenceGraphSchema::PC_2DAxis = FName("UInputSequenceGraphSch
 
 const FName UInputSequenceGraphSchema::PC_Axis = FName("UInputSequenceGraphSchema_PC_Axis");
 
+const FName UInputSequenceGraphSchema::PC_AxisRegion = FName("UInputSequenceGraphSchema_PC_AxisRegion");
+
 const FName UInputSequenceGraphSchema::PC_HubAdd = FName("UInputSequenceGraphSchema_PC_HubAdd");
 
 void UInputSequenceGraphSchema::GetGraphContextActions(FGraphContextMenuBuilder& ContextMenuBuilder) const
@@ -520,6 +768,12 @@ void UInputSequenceGraphSchema::GetGraphContextActions(FGraphContextMenuBuilder&
 		Action->NodeTemplate = NewObject<UInputSequenceGraphNode_Axis>(ContextMenuBuilder.OwnerOfTemporaries);
 	}
 
+	{
+		// Add Gesture node
+		TSharedPtr<FInputSequenceGraphSchemaAction_NewNode> Action = AddNewActionAs<FInputSequenceGraphSchemaAction_NewNode>(ContextMenuBuilder, FText::GetEmpty(), LOCTEXT("AddNode_Gesture", "Add Gesture node..."), LOCTEXT("AddNode_Gesture_Tooltip", "A new Gesture node"));
+		Action->NodeTemplate = NewObject<UInputSequenceGraphNode_Gesture>(ContextMenuBuilder.OwnerOfTemporaries);
+	}
+
 	{
 		// Add Press node
 		TSharedPtr<FInputSequenceGraphSchemaAction_NewNode> Action = AddNewActionAs<FInputSequenceGraphSchemaAction_NewNode>(ContextMenuBuilder, FText::GetEmpty(), LOCTEXT("AddNode_Press", "Add Press node..."), LOCTEXT("AddNode_Press_Tooltip", "A new Press node"));
@@ -623,8 +877,29 @@ public:
 
 	TSharedPtr<SEditableTextBox> GetSearchBox() { return GraphMenu->GetFilterTextBox(); }
 
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override
+	{
+		SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+		// Actions that depend on filter text are collected again when it changes
+
+		if (bIsFilterDriven && GraphMenu.IsValid() && GraphMenu->GetFilterTextBox()->GetText().ToString() != CollectedFilterText)
+		{
+			GraphMenu->RefreshAllActions(true);
+		}
+	}
+
 protected:
 
+	/* Filter text for actions that are too many to be collected without it, menu collects actions again when it changes */
+	const FString& UseFilterText()
+	{
+		bIsFilterDriven = true;
+		CollectedFilterText = GraphMenu.IsValid() ? GraphMenu->GetFilterTextBox()->GetText().ToString() : FString();
+
+		return CollectedFilterText;
+	}
+
 	virtual void OnCollectStaticSections(TArray<int32>& StaticSectionIDs) = 0;
 
 	virtual FText OnGetSectionTitle(int32 InSectionID) = 0;
@@ -637,6 +912,10 @@ private:
 
 	bool bAutoExpandMenu;
 
+	bool bIsFilterDriven = false;
+
+	FString CollectedFilterText;
+
 	TSharedPtr<SGraphActionMenu> GraphMenu;
 };
 
@@ -665,7 +944,12 @@ protected:
 
 	virtual void OnCollectStaticSections(TArray<int32>& StaticSectionIDs) override
 	{
-		StaticSectionIDs.Add(1);
+		const bool isGesture = Node && Node->IsA<UInputSequenceGraphNode_Gesture>();
+
+		if (!isGesture)
+		{
+			StaticSectionIDs.Add(1);
+		}
 
 		const bool isAxis = Node && Node->IsA<UInputSequenceGraphNode_Axis>();
 
@@ -685,7 +969,7 @@ protected:
 			if (InSectionID == 2) return NSLOCTEXT("SInputSequenceParameterMenu_Pin", "AddPin_Section_Axis2D", "Axis 2D");
 
 			if (InSectionID == 3) return NSLOCTEXT("SInputSequenceParameterMenu_Pin", "AddPin_Section_Enhanced_Axis", "Axis (Enhanced Input)");
-			if (InSectionID == 4) return NSLOCTEXT("SInputSequenceParameterMenu_Pin", "AddPin_Section_Enhanced_Axis2D", "Axis 2D (Enhanced Input)");
+			if (InSectionID == 4) return NSLOCTEXT("SInputSequenceParameterMenu_Pin", "AddPin_Section_Enhanced_AxisRegion", "Axis 2D/3D Region (Enhanced Input)");
 		}
 		else
 		{
@@ -696,55 +980,41 @@ protected:
 		return FText::GetEmpty();
 	}
 
-	void CollectAction(const FName& inputName, UInputAction* inputAction, TSet<int32>& alreadyAdded, int& mappingIndex, const FText& toolTip,  int32 sectionID, bool isAxis, bool is2DAxis, TArray<TSharedPtr<FEdGraphSchemaAction>>& schemaActions)
+	void CollectAction(const FName& inputName, const FSoftObjectPath& inputAction, int32 mappingIndex, int32 correctedIndex, const FText& toolTip, int32 sectionID, bool isAxis, bool is2DAxis, TArray<TSharedPtr<FEdGraphSchemaAction>>& schemaActions, bool isAxisRegion = false)
 	{
-		if (Node && Node->FindPin(inputName))
-		{
-			alreadyAdded.Add(mappingIndex);
-		}
-		else
-		{
-			TSharedPtr<FInputSequenceGraphSchemaAction_AddPin> schemaAction(
-				new FInputSequenceGraphSchemaAction_AddPin(
-					FText::GetEmpty()
-					, FText::FromName(inputName)
-					, toolTip
-					, 0
-					, sectionID
-				)
-			);
-
-			schemaAction->InputName = inputName;
-			schemaAction->InputAction = inputAction;
-			schemaAction->InputIndex = mappingIndex;
-			schemaAction->CorrectedInputIndex = 0;
-			schemaAction->IsAxis = isAxis;
-			schemaAction->Is2DAxis = is2DAxis;
+		TSharedPtr<FInputSequenceGraphSchemaAction_AddPin> schemaAction(
+			new FInputSequenceGraphSchemaAction_AddPin(
+				FText::GetEmpty()
+				, FText::FromName(inputName)
+				, toolTip
+				, 0
+				, sectionID
+			)
+		);
 
-			schemaActions.Add(schemaAction);
-		}
+		schemaAction->InputName = inputName;
+		schemaAction->InputAction = inputAction;
+		schemaAction->InputIndex = mappingIndex;
+		schemaAction->CorrectedInputIndex = correctedIndex;
+		schemaAction->IsAxis = isAxis;
+		schemaAction->Is2DAxis = is2DAxis;
+		schemaAction->IsAxisRegion = isAxisRegion;
 
-		mappingIndex++;
+		schemaActions.Add(schemaAction);
 	}
 
 	const FText simpleFormat = NSLOCTEXT("SInputSequenceParameterMenu_Pin", "AddPin_Tooltip", "Add {0} for {1}");
 	const FText complex2DFormat = NSLOCTEXT("SInputSequenceParameterMenu_Pin_2D_Complex", "AddPin_Tooltip", "Add Axis pin for 2D {0} ^ {1}");
 
+	/* Menu lists classic names, their 2D pairs, Enhanced Input Actions and Enhanced Input regions one after another, pins of node are kept in the same order */
 	virtual void CollectAllActions(FGraphActionListBuilderBase& OutAllActions) override
 	{
 		TSet<FName> inputNamesSet;
 
 		const bool isAxis = Node&& Node->IsA<UInputSequenceGraphNode_Axis>();
 
-		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-
-		FARFilter Filter;
-		Filter.ClassPaths.Add(UInputAction::StaticClass()->GetClassPathName());
-		Filter.bRecursiveClasses = true;
-		Filter.bRecursivePaths = true;
-
-		TArray<FAssetData> AssetList;
-		AssetRegistryModule.Get().GetAssets(Filter, AssetList);
+		// Gesture is a path of stick, so only 2D pins make sense there
+		const bool isGesture = Node && Node->IsA<UInputSequenceGraphNode_Gesture>();
 
 		if (isAxis)
 		{
@@ -761,113 +1031,240 @@ protected:
 			}
 		}
 
-		TSet<UInputAction*> enhInputActionsSet;
-		TSet<FName> enhInputNamesSet2D; ////// TODO
-		TSet<FName> enhInputNamesSet3D; ////// TODO
+		const TArray<FName> inputNames = inputNamesSet.Array();
+
+		// Only asset registry data is used, Input Actions are not loaded until one of them is added
+
+		TArray<FInputSequenceInputActionIndex::FEntry> enhInputActions;
+		TArray<FInputSequenceInputActionIndex::FEntry> enhInputRegionActions;
+
+		if (isAxis)
+		{
+			FInputSequenceInputActionIndex::Get().GetEntries(enhInputActions, [](EInputActionValueType valueType) { return valueType == EInputActionValueType::Axis1D; });
+			FInputSequenceInputActionIndex::Get().GetEntries(enhInputRegionActions, [](EInputActionValueType valueType) { return valueType == EInputActionValueType::Axis2D || valueType == EInputActionValueType::Axis3D; });
+		}
+		else
+		{
+			FInputSequenceInputActionIndex::Get().GetEntries(enhInputActions, [](EInputActionValueType valueType) { return valueType == EInputActionValueType::Boolean; });
+		}
+
+		// Mapping index of every entry of menu, entries of skipped sections are counted as well
+
+		const int32 numPairs = isAxis ? inputNames.Num() * (inputNames.Num() - 1) : 0;
+
+		const int32 classicBase = 0;
+		const int32 pairsBase = classicBase + (isGesture ? 0 : inputNames.Num());
+		const int32 enhancedBase = pairsBase + numPairs;
+		const int32 regionsBase = enhancedBase + (isGesture ? 0 : enhInputActions.Num());
 
-		for (const FAssetData& assetData : AssetList)
+		auto getPairIndex = [&](int32 indexA, int32 indexB) { return pairsBase + indexA * (inputNames.Num() - 1) + (indexB < indexA ? indexB : indexB - 1); };
+
+		// Mapping indices of pins node already has. 2D pairs are found from pins of node, not by testing every pair
+
+		TArray<int32> alreadyAdded;
+
+		TMap<FName, int32> inputNameIndice;
+		for (int32 i = 0; i < inputNames.Num(); i++) inputNameIndice.Add(inputNames[i], i);
+
+		if (Node)
 		{
-			if (UInputAction* inputAction = Cast<UInputAction>(assetData.GetAsset()))
+			if (!isGesture)
 			{
-				if (isAxis)
+				for (int32 i = 0; i < inputNames.Num(); i++)
 				{
-					if (inputAction->ValueType == EInputActionValueType::Axis1D)
-					{
-						enhInputActionsSet.FindOrAdd(inputAction);
-					}
-					else if (inputAction->ValueType == EInputActionValueType::Axis2D)
-					{
-						enhInputNamesSet2D.FindOrAdd(inputAction->GetFName());
-					}
-					else if (inputAction->ValueType == EInputActionValueType::Axis3D)
-					{
-						enhInputNamesSet3D.FindOrAdd(inputAction->GetFName());
-					}
+					if (Node->FindPin(inputNames[i])) alreadyAdded.Add(classicBase + i);
+				}
+
+				for (int32 i = 0; i < enhInputActions.Num(); i++)
+				{
+					if (Node->FindPin(enhInputActions[i].Name)) alreadyAdded.Add(enhancedBase + i);
 				}
-				else
+			}
+
+			for (int32 i = 0; i < enhInputRegionActions.Num(); i++)
+			{
+				if (Node->FindPin(enhInputRegionActions[i].Name)) alreadyAdded.Add(regionsBase + i);
+			}
+
+			if (numPairs > 0)
+			{
+				for (UEdGraphPin* pin : Node->Pins)
 				{
-					if (inputAction->ValueType == EInputActionValueType::Boolean)
+					FString lhs;
+					FString rhs;
+					if (pin && pin->PinName.ToString().Split(separator, &lhs, &rhs))
 					{
-						enhInputActionsSet.FindOrAdd(inputAction);
+						const int32* indexA = inputNameIndice.Find(FName(lhs));
+						const int32* indexB = inputNameIndice.Find(FName(rhs));
+
+						if (indexA && indexB && *indexA != *indexB) alreadyAdded.Add(getPairIndex(*indexA, *indexB));
 					}
 				}
 			}
 		}
 
-		int32 mappingIndex = 0;
+		alreadyAdded.Sort();
 
-		TSet<int32> alreadyAdded;
+		// Entries are visited in order of mapping index, so corrected index is a running count of already added entries before them
 
-		TArray<TSharedPtr<FEdGraphSchemaAction>> schemaActions;
+		int32 numAlreadyAddedBefore = 0;
 
-		// Classic Input
-		for (const FName& inputName : inputNamesSet)
-		{
-			CollectAction(
-				inputName
-				, nullptr
-				, alreadyAdded
-				, mappingIndex
-				, FText::Format(simpleFormat, FText::FromString(isAxis ? "Axis pin" : "Action pin"), FText::FromName(inputName))
-				, 1
-				, isAxis
-				, false
-				, schemaActions
-			);
-		}
+		auto getCorrectedIndex = [&](int32 mappingIndex) -> int32
+		{
+			while (numAlreadyAddedBefore < alreadyAdded.Num() && alreadyAdded[numAlreadyAddedBefore] < mappingIndex) numAlreadyAddedBefore++;
 
-		// Classic Input сomplex 2D
-		if (isAxis)
+			const bool isAlreadyAdded = numAlreadyAddedBefore < alreadyAdded.Num() && alreadyAdded[numAlreadyAddedBefore] == mappingIndex;
+
+			return isAlreadyAdded ? INDEX_NONE : numAlreadyAddedBefore;
+		};
+
+		TArray<TSharedPtr<FEdGraphSchemaAction>> schemaActions;
+
+		// Classic Input
+		if (!isGesture)
+		{
+			for (int32 i = 0; i < inputNames.Num(); i++)
+			{
+				const int32 correctedIndex = getCorrectedIndex(classicBase + i);
+
+				if (correctedIndex != INDEX_NONE)
+				{
+					CollectAction(
+						inputNames[i]
+						, FSoftObjectPath()
+						, classicBase + i
+						, correctedIndex
+						, FText::Format(simpleFormat, FText::FromString(isAxis ? "Axis pin" : "Action pin"), FText::FromName(inputNames[i]))
+						, 1
+						, isAxis
+						, false
+						, schemaActions
+					);
+				}
+			}
+		}
+
+		// Classic Input сomplex 2D, there are too many pairs to list them all, so only pairs of names that match filter text are listed
+		if (numPairs > 0)
 		{
-			for (const FName& inputNameA : inputNamesSet)
+			TArray<FString> filterTokens;
+			UseFilterText().ParseIntoArrayWS(filterTokens);
+
+			if (filterTokens.Num() == 0)
+			{
+				TSharedPtr<FInputSequenceGraphSchemaAction_AddPin> hintAction(
+					new FInputSequenceGraphSchemaAction_AddPin(
+						FText::GetEmpty()
+						, NSLOCTEXT("SInputSequenceParameterMenu_Pin", "AddPin_2DHint", "Search axis names to list their 2D pairs...")
+						, FText::Format(NSLOCTEXT("SInputSequenceParameterMenu_Pin", "AddPin_2DHint_Tooltip", "{0} pairs of axes"), FText::AsNumber(numPairs))
+						, 0
+						, 2
+					)
+				);
+
+				schemaActions.Add(hintAction);
+			}
+			else
 			{
-				for (const FName& inputNameB : inputNamesSet)
+				// Pair matches if every token is found in one of its names
+
+				filterTokens.SetNum(FMath::Min(filterTokens.Num(), 32));
+
+				const uint32 allTokensMask = filterTokens.Num() == 32 ? MAX_uint32 : (1u << filterTokens.Num()) - 1;
+
+				TArray<uint32> tokensMasks;
+				tokensMasks.SetNumZeroed(inputNames.Num());
+
+				for (int32 i = 0; i < inputNames.Num(); i++)
 				{
-					if (inputNameA != inputNameB)
+					const FString inputNameString = inputNames[i].ToString();
+
+					for (int32 tokenIndex = 0; tokenIndex < filterTokens.Num(); tokenIndex++)
 					{
-						FName pairedName = FName(inputNameA.ToString().Append(separator).Append(inputNameB.ToString()));
-
-						CollectAction(
-							pairedName
-							, nullptr
-							, alreadyAdded
-							, mappingIndex
-							, FText::Format(complex2DFormat, FText::FromName(inputNameA), FText::FromName(inputNameB))
-							, 2
-							, true
-							, true
-							, schemaActions
-						);
+						if (inputNameString.Contains(filterTokens[tokenIndex])) tokensMasks[i] |= 1u << tokenIndex;
+					}
+				}
+
+				for (int32 indexA = 0; indexA < inputNames.Num(); indexA++)
+				{
+					if (tokensMasks[indexA] == 0) continue;
+
+					for (int32 indexB = 0; indexB < inputNames.Num(); indexB++)
+					{
+						if (indexA == indexB || (tokensMasks[indexA] | tokensMasks[indexB]) != allTokensMask) continue;
+
+						const int32 mappingIndex = getPairIndex(indexA, indexB);
+						const int32 correctedIndex = getCorrectedIndex(mappingIndex);
+
+						if (correctedIndex != INDEX_NONE)
+						{
+							FName pairedName = FName(inputNames[indexA].ToString().Append(separator).Append(inputNames[indexB].ToString()));
+
+							CollectAction(
+								pairedName
+								, FSoftObjectPath()
+								, mappingIndex
+								, correctedIndex
+								, FText::Format(complex2DFormat, FText::FromName(inputNames[indexA]), FText::FromName(inputNames[indexB]))
+								, 2
+								, true
+								, true
+								, schemaActions
+							);
+						}
 					}
 				}
 			}
 		}
 
 		// Enhanced Input
-		for (UInputAction* enhInputAction : enhInputActionsSet)
-		{
-			CollectAction(
-				enhInputAction->GetFName()
-				, enhInputAction
-				, alreadyAdded
-				, mappingIndex
-				, FText::Format(simpleFormat, FText::FromString(isAxis ? "Axis pin" : "Action pin"), FText::FromName(enhInputAction->GetFName()))
-				, isAxis ? 3 : 2
-				, isAxis
-				, false
-				, schemaActions
-			);
+		if (!isGesture)
+		{
+			for (int32 i = 0; i < enhInputActions.Num(); i++)
+			{
+				const int32 correctedIndex = getCorrectedIndex(enhancedBase + i);
+
+				if (correctedIndex != INDEX_NONE)
+				{
+					CollectAction(
+						enhInputActions[i].Name
+						, enhInputActions[i].Path
+						, enhancedBase + i
+						, correctedIndex
+						, FText::Format(simpleFormat, FText::FromString(isAxis ? "Axis pin" : "Action pin"), FText::FromName(enhInputActions[i].Name))
+						, isAxis ? 3 : 2
+						, isAxis
+						, false
+						, schemaActions
+					);
+				}
+			}
 		}
 
-		for (TSharedPtr<FEdGraphSchemaAction> schemaAction : schemaActions)
+		// Enhanced Input 2D and 3D, matched against regions
+		for (int32 i = 0; i < enhInputRegionActions.Num(); i++)
 		{
-			TSharedPtr<FInputSequenceGraphSchemaAction_AddPin> addPinAction = StaticCastSharedPtr<FInputSequenceGraphSchemaAction_AddPin>(schemaAction);
-			
-			for (int32 alreadyAddedIndex : alreadyAdded)
+			const int32 correctedIndex = getCorrectedIndex(regionsBase + i);
+
+			if (correctedIndex != INDEX_NONE)
 			{
-				if (alreadyAddedIndex < addPinAction->InputIndex) addPinAction->CorrectedInputIndex++;
+				CollectAction(
+					enhInputRegionActions[i].Name
+					, enhInputRegionActions[i].Path
+					, regionsBase + i
+					, correctedIndex
+					, FText::Format(simpleFormat, FText::FromString("Axis region pin"), FText::FromName(enhInputRegionActions[i].Name))
+					, 4
+					, true
+					, false
+					, schemaActions
+					, true
+				);
 			}
+		}
 
+		for (TSharedPtr<FEdGraphSchemaAction> schemaAction : schemaActions)
+		{
 			OutAllActions.AddAction(schemaAction);
 		}
 	}
@@ -900,6 +1297,35 @@ void SInputSequenceGraphNode_Dynamic::Construct(const FArguments& InArgs, UEdGra
 		pressNode->OnUpdateGraphNode.BindLambda([&]() { UpdateGraphNode(); });
 	}
 
+	SAssignNew(DebugTimerBar, SBox)
+		.WidthOverride_Lambda([this]() { return FOptionalSize(GetDesiredSize().X); })
+		.HeightOverride(4)
+		[
+			SNew(SProgressBar)
+			.Percent_Lambda([this]()
+				{
+					const FInputSequenceDebugNodeState* debugNodeState = GetDebugNodeState();
+					return debugNodeState ? TOptional<float>(debugNodeState->TimerProgress) : TOptional<float>();
+				})
+			.FillColorAndOpacity(FLinearColor::Yellow)
+		];
+
+	SAssignNew(HeatmapCounts, SBorder)
+		.BorderImage(FAppStyle::GetBrush("Menu.Background"))
+		.BorderBackgroundColor(FLinearColor(0, 0, 0, 0.6f))
+		.Padding(FMargin(4, 1))
+		[
+			SNew(STextBlock)
+			.ToolTipText(NSLOCTEXT("SInputSequenceGraphNode_Dynamic", "HeatmapCounts_Tooltip", "Times node was entered, passed and reset"))
+			.Text_Lambda([this]()
+				{
+					const FInputSequenceHeatmapNodeState* heatmapNodeState = GetHeatmapNodeState();
+					return heatmapNodeState
+						? FText::Format(NSLOCTEXT("SInputSequenceGraphNode_Dynamic", "HeatmapCounts", "{0} / {1} / {2}"), FText::AsNumber(heatmapNodeState->NumEnters), FText::AsNumber(heatmapNodeState->NumPasses), FText::AsNumber(heatmapNodeState->NumResets))
+						: FText::GetEmpty();
+				})
+		];
+
 	UpdateGraphNode();
 }
 
@@ -911,6 +1337,75 @@ SInputSequenceGraphNode_Dynamic::~SInputSequenceGraphNode_Dynamic()
 	}
 }
 
+FSlateColor SInputSequenceGraphNode_Dynamic::GetNodeBodyColor() const
+{
+	FLinearColor color = SGraphNode::GetNodeBodyColor().GetSpecifiedColor();
+
+	if (const FInputSequenceHeatmapNodeState* heatmapNodeState = GetHeatmapNodeState())
+	{
+		color = FLinearColor::LerpUsingHSV(FLinearColor(0.1f, 0.2f, 0.8f), FLinearColor(1.f, 0.1f, 0.05f), heatmapNodeState->Heat);
+	}
+
+	if (const FInputSequenceDebugNodeState* debugNodeState = GetDebugNodeState())
+	{
+		if (debugNodeState->bIsActive) color = FLinearColor(0.1f, 0.8f, 0.2f);
+
+		// Events flash and fade out, so states passed or reset within one frame are seen as well
+
+		const float flash = 1 - (float)(FPlatformTime::Seconds() - debugNodeState->LastEventTime) / DebugFlashTime;
+
+		if (flash > 0)
+		{
+			FLinearColor eventColor = FLinearColor(0.2f, 0.6f, 1.f);
+			if (debugNodeState->LastEvent == InputSequenceCore::EStateEvent::Pass) eventColor = FLinearColor::White;
+			if (debugNodeState->LastEvent == InputSequenceCore::EStateEvent::Reset) eventColor = FLinearColor::Red;
+
+			color = FMath::Lerp(color, eventColor, flash);
+		}
+	}
+
+	return color;
+}
+
+TArray<FOverlayWidgetInfo> SInputSequenceGraphNode_Dynamic::GetOverlayWidgets(bool bSelected, const FVector2D& WidgetSize) const
+{
+	TArray<FOverlayWidgetInfo> widgets = SGraphNode::GetOverlayWidgets(bSelected, WidgetSize);
+
+	const FInputSequenceDebugNodeState* debugNodeState = GetDebugNodeState();
+
+	if (debugNodeState && debugNodeState->bIsActive && debugNodeState->TimerProgress >= 0)
+	{
+		FOverlayWidgetInfo timerInfo(DebugTimerBar);
+		timerInfo.OverlayOffset = FVector2D(0, WidgetSize.Y + 2);
+
+		widgets.Add(timerInfo);
+	}
+
+	if (GetHeatmapNodeState())
+	{
+		FOverlayWidgetInfo countsInfo(HeatmapCounts);
+		countsInfo.OverlayOffset = FVector2D(0, -HeatmapCounts->GetDesiredSize().Y - 2);
+
+		widgets.Add(countsInfo);
+	}
+
+	return widgets;
+}
+
+const FInputSequenceDebugNodeState* SInputSequenceGraphNode_Dynamic::GetDebugNodeState() const
+{
+	const UInputSequenceGraph* graph = GraphNode ? Cast<UInputSequenceGraph>(GraphNode->GetGraph()) : nullptr;
+
+	return graph ? graph->GetDebugNodeState(GraphNode->NodeGuid) : nullptr;
+}
+
+const FInputSequenceHeatmapNodeState* SInputSequenceGraphNode_Dynamic::GetHeatmapNodeState() const
+{
+	const UInputSequenceGraph* graph = GraphNode ? Cast<UInputSequenceGraph>(GraphNode->GetGraph()) : nullptr;
+
+	return graph ? graph->GetHeatmapNodeState(GraphNode->NodeGuid) : nullptr;
+}
+
 
 
 #pragma region UInputSequenceGraphNode_Base
@@ -934,6 +1429,51 @@ void UInputSequenceGraphNode_Base::AutowireNewNode(UEdGraphPin* FromPin)
 	}
 }
 
+bool UInputSequenceGraphNode_Base::Modify(bool bAlwaysMarkDirty)
+{
+	MarkCompileDirty();
+
+	return Super::Modify(bAlwaysMarkDirty);
+}
+
+void UInputSequenceGraphNode_Base::PinDefaultValueChanged(UEdGraphPin* Pin)
+{
+	Super::PinDefaultValueChanged(Pin);
+
+	MarkCompileDirty();
+}
+
+void UInputSequenceGraphNode_Base::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::PinConnectionListChanged(Pin);
+
+	MarkCompileDirty();
+}
+
+void UInputSequenceGraphNode_Base::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	MarkCompileDirty();
+}
+
+void UInputSequenceGraphNode_Base::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	MarkCompileDirty();
+}
+
+void UInputSequenceGraphNode_Base::MarkCompileDirty()
+{
+	// Templates of context menu actions are not in graph
+
+	if (UInputSequenceGraph* inputSequenceGraph = Cast<UInputSequenceGraph>(GetGraph()))
+	{
+		inputSequenceGraph->MarkNodeDirty(this);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
 #pragma endregion
 
@@ -1165,6 +1705,52 @@ FText UInputSequenceGraphNode_Axis::GetTooltipText() const
 
 
 
+#pragma region UInputSequenceGraphNode_Gesture
+#define LOCTEXT_NAMESPACE "UInputSequenceGraphNode_Gesture"
+
+UInputSequenceGraphNode_Gesture::UInputSequenceGraphNode_Gesture(const FObjectInitializer& ObjectInitializer) :Super(ObjectInitializer)
+{
+	// Quarter-circle forward
+	Directions = { -90.f, -45.f, 0.f };
+
+	Tolerance = 22.5f;
+	MinMagnitude = 0.5f;
+	MaxDuration = 0.3f;
+}
+
+FText UInputSequenceGraphNode_Gesture::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("UInputSequenceGraphNode_Gesture_Title", "Gesture node");
+}
+
+FText UInputSequenceGraphNode_Gesture::GetTooltipText() const
+{
+	return LOCTEXT("UInputSequenceGraphNode_Gesture_ToolTip", "This is a Gesture node of Input sequence...");
+}
+
+TArray<FInputSequenceAxisRegion> UInputSequenceGraphNode_Gesture::GetGestureSteps() const
+{
+	TArray<FInputSequenceAxisRegion> gestureSteps;
+
+	for (float direction : Directions)
+	{
+		const double directionRad = FMath::DegreesToRadians(direction);
+
+		FInputSequenceAxisRegion& gestureStep = gestureSteps.AddDefaulted_GetRef();
+		gestureStep.Shape = EInputSequenceAxisRegionShape::Cone;
+		gestureStep.NumDimensions = 2;
+		gestureStep.A = FVector(FMath::Cos(directionRad), FMath::Sin(directionRad), 0);
+		gestureStep.B = FVector(Tolerance, MinMagnitude, 0);
+	}
+
+	return gestureSteps;
+}
+
+#undef LOCTEXT_NAMESPACE
+#pragma endregion
+
+
+
 #pragma region SToolTip_Mock
 #define LOCTEXT_NAMESPACE "SToolTip_Mock"
 
@@ -2859,6 +3445,178 @@ FReply SGraphPin_Axis::OnClicked_Raw_RemovePin() const
 
 
 
+#pragma region SGraphPin_AxisRegion
+#define LOCTEXT_NAMESPACE "SGraphPin_AxisRegion"
+
+void SGraphPin_AxisRegion::Construct(const FArguments& InArgs, UEdGraphPin* InPin)
+{
+	SGraphPin_Axis::Construct(SGraphPin_Axis::FArguments(), InPin);
+}
+
+TSharedRef<SWidget> SGraphPin_AxisRegion::GetDefaultValueWidget()
+{
+	return SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2)
+		[
+			SNew(SComboButton)
+			.IsEnabled(this, &SGraphPin_AxisRegion::GetDefaultValueIsEditable)
+			.OnGetMenuContent(this, &SGraphPin_AxisRegion::OnGetShapeMenuContent)
+			.ButtonContent()
+			[
+				SNew(STextBlock)
+				.Font(FAppStyle::GetFontStyle("Graph.VectorEditableTextBox"))
+				.Text(this, &SGraphPin_AxisRegion::GetShapeText)
+			]
+		]
+
+		+ SVerticalBox::Slot().AutoHeight()
+		[
+			MakeVectorRow(0)
+		]
+
+		+ SVerticalBox::Slot().AutoHeight()
+		[
+			MakeVectorRow(1)
+		];
+}
+
+TSharedRef<SWidget> SGraphPin_AxisRegion::MakeVectorRow(int32 VectorIndex)
+{
+	const FLinearColor LabelClr = FLinearColor(1.f, 1.f, 1.f, 0.4f);
+
+	TSharedRef<SHorizontalBox> row = SNew(SHorizontalBox)
+
+		+ SHorizontalBox::Slot().AutoWidth().Padding(2).VAlign(VAlign_Center)
+		[
+			SNew(SBox).WidthOverride(48)
+			[
+				SNew(STextBlock)
+				.Font(FAppStyle::GetFontStyle("Graph.VectorEditableTextBox"))
+				.Text(this, &SGraphPin_AxisRegion::GetVectorLabel, VectorIndex)
+				.ColorAndOpacity(LabelClr)
+			]
+		];
+
+	for (int32 componentIndex = 0; componentIndex < 3; componentIndex++)
+	{
+		row->AddSlot().AutoWidth().Padding(2).VAlign(VAlign_Center)
+		[
+			SNew(SNumericEntryBox<float>)
+			.Visibility(this, &SGraphPin_AxisRegion::GetComponentVisibility, VectorIndex, componentIndex)
+			.IsEnabled(this, &SGraphPin_AxisRegion::GetDefaultValueIsEditable)
+			.Value(this, &SGraphPin_AxisRegion::GetComponentValue, VectorIndex, componentIndex)
+			.OnValueCommitted(this, &SGraphPin_AxisRegion::OnComponentCommitted, VectorIndex, componentIndex)
+			.Font(FAppStyle::GetFontStyle("Graph.VectorEditableTextBox"))
+			.EditableTextBoxStyle(&FAppStyle::GetWidgetStyle<FEditableTextBoxStyle>("Graph.VectorEditableTextBox"))
+			.BorderForegroundColor(FLinearColor::White)
+			.BorderBackgroundColor(FLinearColor::White)
+		];
+	}
+
+	return row;
+}
+
+FInputSequenceAxisRegion SGraphPin_AxisRegion::GetRegion() const
+{
+	FInputSequenceAxisRegion region;
+	region.InitFromString(GraphPinObj->GetDefaultAsString());
+	region.NumDimensions = GetAxisRegionNumDimensions(GraphPinObj);
+
+	return region;
+}
+
+void SGraphPin_AxisRegion::SetRegion(const FInputSequenceAxisRegion& Region)
+{
+	if (GraphPinObj->IsPendingKill())
+	{
+		return;
+	}
+
+	const FString RegionString = Region.ToString();
+
+	if (GraphPinObj->GetDefaultAsString() != RegionString)
+	{
+		const FScopedTransaction Transaction(LOCTEXT("ChangeRegionPinValue", "Change Region Pin Value"));
+		GraphPinObj->Modify();
+
+		GraphPinObj->GetSchema()->TrySetDefaultValue(*GraphPinObj, RegionString);
+	}
+}
+
+FText SGraphPin_AxisRegion::GetShapeText() const
+{
+	return StaticEnum<EInputSequenceAxisRegionShape>()->GetDisplayNameTextByValue((int64)GetRegion().Shape);
+}
+
+TSharedRef<SWidget> SGraphPin_AxisRegion::OnGetShapeMenuContent()
+{
+	FMenuBuilder menuBuilder(true, nullptr);
+
+	for (EInputSequenceAxisRegionShape shape : { EInputSequenceAxisRegionShape::Box, EInputSequenceAxisRegionShape::Sphere, EInputSequenceAxisRegionShape::Cone })
+	{
+		menuBuilder.AddMenuEntry(
+			StaticEnum<EInputSequenceAxisRegionShape>()->GetDisplayNameTextByValue((int64)shape)
+			, FText::GetEmpty()
+			, FSlateIcon()
+			, FUIAction(FExecuteAction::CreateSP(this, &SGraphPin_AxisRegion::OnShapeSelected, shape))
+		);
+	}
+
+	return menuBuilder.MakeWidget();
+}
+
+void SGraphPin_AxisRegion::OnShapeSelected(EInputSequenceAxisRegionShape Shape)
+{
+	FInputSequenceAxisRegion region = GetRegion();
+	region.Shape = Shape;
+
+	SetRegion(region);
+}
+
+FText SGraphPin_AxisRegion::GetVectorLabel(int32 VectorIndex) const
+{
+	switch (GetRegion().Shape)
+	{
+	case EInputSequenceAxisRegionShape::Sphere: return VectorIndex == 0 ? LOCTEXT("SphereCenter", "center:") : LOCTEXT("SphereRadius", "radius:");
+	case EInputSequenceAxisRegionShape::Cone: return VectorIndex == 0 ? LOCTEXT("ConeDirection", "dir:") : LOCTEXT("ConeAngleAndLength", "deg, len:");
+	default: return VectorIndex == 0 ? LOCTEXT("BoxMin", "min:") : LOCTEXT("BoxMax", "max:");
+	}
+}
+
+EVisibility SGraphPin_AxisRegion::GetComponentVisibility(int32 VectorIndex, int32 ComponentIndex) const
+{
+	const FInputSequenceAxisRegion region = GetRegion();
+
+	if (VectorIndex == 1)
+	{
+		if (region.Shape == EInputSequenceAxisRegionShape::Sphere) return ComponentIndex == 0 ? EVisibility::Visible : EVisibility::Collapsed;
+		if (region.Shape == EInputSequenceAxisRegionShape::Cone) return EVisibility::Visible;
+	}
+
+	return ComponentIndex == 2 && region.NumDimensions < 3 ? EVisibility::Collapsed : EVisibility::Visible;
+}
+
+TOptional<float> SGraphPin_AxisRegion::GetComponentValue(int32 VectorIndex, int32 ComponentIndex) const
+{
+	const FInputSequenceAxisRegion region = GetRegion();
+
+	return (float)(VectorIndex == 0 ? region.A : region.B)[ComponentIndex];
+}
+
+void SGraphPin_AxisRegion::OnComponentCommitted(float NewValue, ETextCommit::Type CommitInfo, int32 VectorIndex, int32 ComponentIndex)
+{
+	FInputSequenceAxisRegion region = GetRegion();
+	(VectorIndex == 0 ? region.A : region.B)[ComponentIndex] = NewValue;
+
+	SetRegion(region);
+}
+
+#undef LOCTEXT_NAMESPACE
+#pragma endregion
+
+
+
 #pragma region SGraphPin_HubAdd
 #define LOCTEXT_NAMESPACE "SGraphPin_HubAdd"
 
@@ -3219,6 +3977,17 @@ FReply SGraphPin_HubExec::OnClicked_Raw_RemovePin() const
 const FName FInputSequenceAssetEditor::AppIdentifier(TEXT("FInputSequenceAssetEditor_AppIdentifier"));
 const FName FInputSequenceAssetEditor::DetailsTabId(TEXT("FInputSequenceAssetEditor_DetailsTab_Id"));
 const FName FInputSequenceAssetEditor::GraphTabId(TEXT("FInputSequenceAssetEditor_GraphTab_Id"));
+const FName FInputSequenceAssetEditor::AnalysisTabId(TEXT("FInputSequenceAssetEditor_AnalysisTab_Id"));
+const FName FInputSequenceAssetEditor::DebuggerTabId(TEXT("FInputSequenceAssetEditor_DebuggerTab_Id"));
+
+FInputSequenceAssetEditor::~FInputSequenceAssetEditor()
+{
+	FEditorDelegates::EndPIE.RemoveAll(this);
+
+	DetachDebugger();
+
+	SetHeatmapSource(EHeatmapSource::None);
+}
 
 void FInputSequenceAssetEditor::InitInputSequenceAssetEditor(const EToolkitMode::Type Mode, const TSharedPtr< class IToolkitHost >& InitToolkitHost, UInputSequenceAsset* inputSequenceAsset)
 {
@@ -3228,7 +3997,7 @@ void FInputSequenceAssetEditor::InitInputSequenceAssetEditor(const EToolkitMode:
 
 	InputSequenceAsset->SetFlags(RF_Transactional);
 
-	TSharedRef<FTabManager::FLayout> StandaloneDefaultLayout = FTabManager::NewLayout("FInputSequenceAssetEditor_StandaloneDefaultLayout")
+	TSharedRef<FTabManager::FLayout> StandaloneDefaultLayout = FTabManager::NewLayout("FInputSequenceAssetEditor_StandaloneDefaultLayout_v2")
 		->AddArea
 		(
 			FTabManager::NewPrimaryArea()->SetOrientation(Orient_Vertical)
@@ -3243,10 +4012,23 @@ void FInputSequenceAssetEditor::InitInputSequenceAssetEditor(const EToolkitMode:
 				FTabManager::NewSplitter()->SetOrientation(Orient_Horizontal)
 				->Split
 				(
-					FTabManager::NewStack()
+					FTabManager::NewSplitter()->SetOrientation(Orient_Vertical)
 					->SetSizeCoefficient(0.3f)
-					->AddTab(DetailsTabId, ETabState::OpenedTab)
-					->SetHideTabWell(true)
+					->Split
+					(
+						FTabManager::NewStack()
+						->SetSizeCoefficient(0.7f)
+						->AddTab(DetailsTabId, ETabState::OpenedTab)
+						->SetHideTabWell(true)
+					)
+					->Split
+					(
+						FTabManager::NewStack()
+						->SetSizeCoefficient(0.3f)
+						->AddTab(AnalysisTabId, ETabState::OpenedTab)
+						->AddTab(DebuggerTabId, ETabState::OpenedTab)
+						->SetForegroundTab(AnalysisTabId)
+					)
 				)
 				->Split
 				(
@@ -3259,6 +4041,21 @@ void FInputSequenceAssetEditor::InitInputSequenceAssetEditor(const EToolkitMode:
 		);
 
 	FAssetEditorToolkit::InitAssetEditor(Mode, InitToolkitHost, AppIdentifier, StandaloneDefaultLayout, true, true, InputSequenceAsset);
+
+	ToolkitCommands->MapAction(FInputSequenceEditorCommands::Get().AutoArrange, FExecuteAction::CreateSP(this, &FInputSequenceAssetEditor::AutoArrangeNodes));
+
+	TSharedPtr<FExtender> toolbarExtender = MakeShared<FExtender>();
+	toolbarExtender->AddToolBarExtension("Asset", EExtensionHook::After, ToolkitCommands, FToolBarExtensionDelegate::CreateLambda([](FToolBarBuilder& toolbarBuilder)
+		{
+			toolbarBuilder.BeginSection("Graph");
+			toolbarBuilder.AddToolBarButton(FInputSequenceEditorCommands::Get().AutoArrange, NAME_None, TAttribute<FText>(), TAttribute<FText>(), FSlateIcon(FAppStyle::GetAppStyleSetName(), "GraphEditor.StraightenConnections"));
+			toolbarBuilder.EndSection();
+		}));
+
+	AddToolbarExtender(toolbarExtender);
+	RegenerateMenusAndToolbars();
+
+	FEditorDelegates::EndPIE.AddSP(this, &FInputSequenceAssetEditor::OnEndPIE);
 }
 
 void FInputSequenceAssetEditor::RegisterTabSpawners(const TSharedRef<class FTabManager>& InTabManager)
@@ -3277,12 +4074,24 @@ void FInputSequenceAssetEditor::RegisterTabSpawners(const TSharedRef<class FTabM
 		.SetDisplayName(LOCTEXT("GraphTab_DisplayName", "Graph"))
 		.SetGroup(WorkspaceMenuCategoryRef)
 		.SetIcon(FSlateIcon(FAppStyle::GetAppStyleSetName(), "GraphEditor.EventGraph_16x"));
+
+	InTabManager->RegisterTabSpawner(AnalysisTabId, FOnSpawnTab::CreateSP(this, &FInputSequenceAssetEditor::SpawnTab_AnalysisTab))
+		.SetDisplayName(LOCTEXT("AnalysisTab_DisplayName", "Analysis"))
+		.SetGroup(WorkspaceMenuCategoryRef)
+		.SetIcon(FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Info"));
+
+	InTabManager->RegisterTabSpawner(DebuggerTabId, FOnSpawnTab::CreateSP(this, &FInputSequenceAssetEditor::SpawnTab_DebuggerTab))
+		.SetDisplayName(LOCTEXT("DebuggerTab_DisplayName", "Debugger"))
+		.SetGroup(WorkspaceMenuCategoryRef)
+		.SetIcon(FSlateIcon(FAppStyle::GetAppStyleSetName(), "Debug"));
 }
 
 void FInputSequenceAssetEditor::UnregisterTabSpawners(const TSharedRef<class FTabManager>& InTabManager)
 {
 	FAssetEditorToolkit::UnregisterTabSpawners(InTabManager);
 
+	InTabManager->UnregisterTabSpawner(DebuggerTabId);
+	InTabManager->UnregisterTabSpawner(AnalysisTabId);
 	InTabManager->UnregisterTabSpawner(GraphTabId);
 	InTabManager->UnregisterTabSpawner(DetailsTabId);
 }
@@ -3342,6 +4151,473 @@ TSharedRef<SDockTab> FInputSequenceAssetEditor::SpawnTab_GraphTab(const FSpawnTa
 		];
 }
 
+TSharedRef<SDockTab> FInputSequenceAssetEditor::SpawnTab_AnalysisTab(const FSpawnTabArgs& Args)
+{
+	check(Args.GetTabId() == AnalysisTabId);
+
+	TSharedRef<SDockTab> analysisTab = SNew(SDockTab)
+		.Label(LOCTEXT("AnalysisTab_Label", "Analysis"))
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot().AutoHeight().Padding(4)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("AnalysisTab_Analyze", "Analyze"))
+				.ToolTipText(LOCTEXT("AnalysisTab_Analyze_Tooltip", "Estimate worst case evaluation cost of asset and find unreachable nodes and ambiguous branches"))
+				.OnClicked_Lambda([this]() { RefreshAnalysis(); return FReply::Handled(); })
+			]
+			+ SVerticalBox::Slot().FillHeight(1)
+			[
+				SNew(SScrollBox)
+				+ SScrollBox::Slot()
+				[
+					SAssignNew(AnalysisBox, SVerticalBox)
+				]
+			]
+		];
+
+	RefreshAnalysis();
+
+	return analysisTab;
+}
+
+void FInputSequenceAssetEditor::RefreshAnalysis()
+{
+	if (!AnalysisBox.IsValid()) return;
+
+	AnalysisBox->ClearChildren();
+
+	FInputSequenceAnalysis analysis;
+	FInputSequenceAnalyzer::Analyze(InputSequenceAsset, analysis);
+
+	auto addLine = [&](const FText& text, const FSlateColor& color)
+	{
+		AnalysisBox->AddSlot().AutoHeight().Padding(4, 1)[SNew(STextBlock).Text(text).ColorAndOpacity(color)];
+	};
+
+	addLine(FText::Format(LOCTEXT("Analysis_States", "States: {0}"), FText::AsNumber(analysis.NumStates)), FSlateColor::UseForeground());
+	addLine(FText::Format(LOCTEXT("Analysis_MaxActiveStates", "Max active states: {0}"), FText::AsNumber(analysis.MaxActiveStates)), FSlateColor::UseForeground());
+	addLine(FText::Format(LOCTEXT("Analysis_MaxTransitionsPerEvent", "Max transitions per input event: {0}"), FText::AsNumber(analysis.MaxTransitionsPerEvent)), FSlateColor::UseForeground());
+	addLine(FText::Format(LOCTEXT("Analysis_FrameCost", "Max action tests per frame: {0} (~{1} us)"), FText::AsNumber(analysis.MaxActionTestsPerFrame), FText::AsNumber(analysis.EstimatedFrameCostMicroseconds)), FSlateColor::UseForeground());
+
+	TArray<FInputSequenceAnalysis::FMessage> messages;
+	analysis.GetMessages(messages);
+
+	for (const FInputSequenceAnalysis::FMessage& message : messages)
+	{
+		const FSlateColor color = message.bIsError ? FLinearColor::Red : FLinearColor::Yellow;
+
+		if (message.Node.IsValid())
+		{
+			// Messages about nodes jump to them
+
+			TWeakObjectPtr<UEdGraphNode> node = message.Node;
+
+			AnalysisBox->AddSlot().AutoHeight().Padding(4, 1)
+				[
+					SNew(SHyperlink)
+					.Text(message.Text)
+				.OnNavigate_Lambda([this, node]()
+					{
+						if (TSharedPtr<SGraphEditor> graphEditor = GraphEditorPtr.Pin())
+						{
+							if (node.IsValid()) graphEditor->JumpToNode(node.Get());
+						}
+					})
+				];
+		}
+		else
+		{
+			addLine(message.Text, color);
+		}
+	}
+}
+
+TSharedRef<SDockTab> FInputSequenceAssetEditor::SpawnTab_DebuggerTab(const FSpawnTabArgs& Args)
+{
+	check(Args.GetTabId() == DebuggerTabId);
+
+	return SNew(SDockTab)
+		.Label(LOCTEXT("DebuggerTab_Label", "Debugger"))
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot().AutoHeight().Padding(4)
+			[
+				SNew(SComboButton)
+				.ToolTipText(LOCTEXT("DebuggerTab_Instance_Tooltip", "Runtime instance of asset to show on graph while Play In Editor runs"))
+				.OnGetMenuContent_Lambda([this]() { return MakeDebugCandidatesMenu(); })
+				.ButtonContent()
+				[
+					SNew(STextBlock)
+					.Text_Lambda([this]()
+						{
+							UInputSequenceAsset* instance = DebuggedInstance.Get();
+							return instance ? GetDebugCandidateName(instance) : LOCTEXT("DebuggerTab_NoInstance", "No debug instance");
+						})
+				]
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(4, 1)
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Text_Lambda([this]() { return GetDebuggerStatusText(); })
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(4)
+			[
+				SNew(SSeparator)
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(4)
+			[
+				SNew(SComboButton)
+				.ToolTipText(LOCTEXT("DebuggerTab_Heatmap_Tooltip", "Hit counts to show on graph nodes as heatmap"))
+				.OnGetMenuContent_Lambda([this]() { return MakeHeatmapSourceMenu(); })
+				.ButtonContent()
+				[
+					SNew(STextBlock)
+					.Text_Lambda([this]()
+						{
+							switch (HeatmapSource)
+							{
+							case EHeatmapSource::Live: return LOCTEXT("DebuggerTab_Heatmap_Live", "Heatmap: Play In Editor");
+							case EHeatmapSource::File: return FText::Format(LOCTEXT("DebuggerTab_Heatmap_File", "Heatmap: {0}"), FText::FromString(FPaths::GetCleanFilename(HeatmapFilePath)));
+							default: return LOCTEXT("DebuggerTab_Heatmap_None", "No heatmap");
+							}
+						})
+				]
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(4, 1)
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Text_Lambda([this]() { return GetHeatmapStatusText(); })
+			]
+		];
+}
+
+void FInputSequenceAssetEditor::GetDebugCandidates(TArray<UInputSequenceAsset*>& outInstances) const
+{
+	if (!GEditor || !GEditor->PlayWorld) return;
+
+	// Asset is evaluated as is by callers that don't instance it, all of them share its state
+
+	outInstances.Add(InputSequenceAsset);
+
+	// Runtime instances are duplicates of asset with actor, component or subsystem as outer, duplicates keep name of asset
+
+	for (TObjectIterator<UInputSequenceAsset> it; it; ++it)
+	{
+		UInputSequenceAsset* instance = *it;
+
+		if (instance == InputSequenceAsset || !IsValid(instance) || instance->IsAsset() || instance->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject)) continue;
+
+		if (instance->GetFName() == InputSequenceAsset->GetFName()) outInstances.Add(instance);
+	}
+}
+
+FText FInputSequenceAssetEditor::GetDebugCandidateName(const UInputSequenceAsset* instance) const
+{
+	return instance == InputSequenceAsset ? LOCTEXT("DebuggerTab_SharedAsset", "Asset (shared)") : FText::FromString(instance->GetOuter()->GetName());
+}
+
+TSharedRef<SWidget> FInputSequenceAssetEditor::MakeDebugCandidatesMenu()
+{
+	FMenuBuilder menuBuilder(true, nullptr);
+
+	menuBuilder.AddMenuEntry(LOCTEXT("DebuggerTab_Detach", "None"), LOCTEXT("DebuggerTab_Detach_Tooltip", "Detach debugger"), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateLambda([this]() { AttachDebugger(nullptr); })));
+
+	TArray<UInputSequenceAsset*> instances;
+	GetDebugCandidates(instances);
+
+	if (instances.Num() == 0)
+	{
+		menuBuilder.AddMenuEntry(LOCTEXT("DebuggerTab_NoCandidates", "No instances, start Play In Editor"), FText::GetEmpty(), FSlateIcon(),
+			FUIAction(FExecuteAction(), FCanExecuteAction::CreateLambda([]() { return false; })));
+	}
+
+	for (UInputSequenceAsset* instance : instances)
+	{
+		TWeakObjectPtr<UInputSequenceAsset> weakInstance = instance;
+
+		menuBuilder.AddMenuEntry(GetDebugCandidateName(instance), FText::FromString(instance->GetPathName()), FSlateIcon(),
+			FUIAction(FExecuteAction::CreateLambda([this, weakInstance]() { AttachDebugger(weakInstance.Get()); })));
+	}
+
+	return menuBuilder.MakeWidget();
+}
+
+void FInputSequenceAssetEditor::AttachDebugger(UInputSequenceAsset* instance)
+{
+	DetachDebugger();
+
+	UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(InputSequenceAsset->EdGraph);
+
+	if (!instance || !graph) return;
+
+	// States are mapped to nodes the same way asset is compiled, instance made from other version of graph is still debugged but flagged
+
+	TArray<FInputSequenceState> states;
+	TArray<UEdGraphNode*> stateNodes;
+	graph->CompileStates(states, &stateNodes);
+
+	bIsDebuggedInstanceOutdated = !instance->GetCompiledData().IsUpToDate(FInputSequenceCompiledData::HashSource(states));
+
+	for (UEdGraphNode* stateNode : stateNodes)
+	{
+		DebugStateNodeGuids.Add(stateNode ? stateNode->NodeGuid : FGuid());
+	}
+
+	DebugRing = MakeUnique<InputSequenceCore::FDebugRing>();
+	DebugReadIndex = 0;
+	NumLostDebugRecords = 0;
+
+	instance->SetDebugRing(DebugRing.Get());
+	DebuggedInstance = instance;
+
+	DebuggerTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FInputSequenceAssetEditor::TickDebugger));
+}
+
+void FInputSequenceAssetEditor::DetachDebugger()
+{
+	if (UInputSequenceAsset* instance = DebuggedInstance.Get(true))
+	{
+		instance->SetDebugRing(nullptr);
+	}
+
+	DebuggedInstance.Reset();
+
+	if (DebuggerTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DebuggerTickHandle);
+		DebuggerTickHandle.Reset();
+	}
+
+	DebugRing.Reset();
+	DebugStateNodeGuids.Reset();
+
+	if (UInputSequenceGraph* graph = InputSequenceAsset ? Cast<UInputSequenceGraph>(InputSequenceAsset->EdGraph) : nullptr)
+	{
+		graph->DebugNodeStates.Reset();
+	}
+}
+
+bool FInputSequenceAssetEditor::TickDebugger(float DeltaTime)
+{
+	UInputSequenceAsset* instance = DebuggedInstance.Get();
+	UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(InputSequenceAsset->EdGraph);
+
+	if (!instance || !graph)
+	{
+		DetachDebugger();
+		return false;
+	}
+
+	DebugRecords.clear();
+	NumLostDebugRecords += DebugRing->Read(DebugReadIndex, DebugRecords);
+
+	const double now = FPlatformTime::Seconds();
+
+	for (TPair<FGuid, FInputSequenceDebugNodeState>& debugNodeState : graph->DebugNodeStates)
+	{
+		debugNodeState.Value.bIsActive = false;
+		debugNodeState.Value.TimerProgress = -1;
+	}
+
+	for (const InputSequenceCore::FDebugRecord& record : DebugRecords)
+	{
+		if (!DebugStateNodeGuids.IsValidIndex(record.StateIndex)) continue;
+
+		FInputSequenceDebugNodeState& debugNodeState = graph->DebugNodeStates.FindOrAdd(DebugStateNodeGuids[record.StateIndex]);
+		debugNodeState.LastEvent = record.Event;
+		debugNodeState.LastEventTime = now;
+	}
+
+	// Node can be compiled into several states, it is active if any of them is, and shows the most elapsed timer
+
+	for (uint16 stateIndex : instance->GetActiveStates())
+	{
+		if (!DebugStateNodeGuids.IsValidIndex(stateIndex)) continue;
+
+		FInputSequenceDebugNodeState& debugNodeState = graph->DebugNodeStates.FindOrAdd(DebugStateNodeGuids[stateIndex]);
+		debugNodeState.bIsActive = true;
+
+		float time, timeLimit;
+		if (instance->GetStateTimer(stateIndex, time, timeLimit))
+		{
+			debugNodeState.TimerProgress = FMath::Max(debugNodeState.TimerProgress, FMath::Clamp(time / timeLimit, 0.f, 1.f));
+		}
+	}
+
+	return true;
+}
+
+FText FInputSequenceAssetEditor::GetDebuggerStatusText() const
+{
+	if (!DebuggedInstance.IsValid()) return LOCTEXT("DebuggerTab_Status_Detached", "Select instance of asset while Play In Editor runs to see its active states, state events and timers on graph nodes");
+
+	FText status = FText::Format(LOCTEXT("DebuggerTab_Status", "Frame {0}, active states: {1}, lost events: {2}"),
+		FText::AsNumber(DebugRing->GetFrame()), FText::AsNumber(DebuggedInstance->GetNumActiveStates()), FText::AsNumber(NumLostDebugRecords));
+
+	if (bIsDebuggedInstanceOutdated)
+	{
+		status = FText::Format(LOCTEXT("DebuggerTab_Status_Outdated", "{0}\nInstance was made before last changes of graph, restart Play In Editor to debug them"), status);
+	}
+
+	return status;
+}
+
+TSharedRef<SWidget> FInputSequenceAssetEditor::MakeHeatmapSourceMenu()
+{
+	FMenuBuilder menuBuilder(true, nullptr);
+
+	menuBuilder.AddMenuEntry(LOCTEXT("DebuggerTab_Heatmap_Hide", "None"), LOCTEXT("DebuggerTab_Heatmap_Hide_Tooltip", "Hide heatmap"), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateLambda([this]() { SetHeatmapSource(EHeatmapSource::None); })));
+
+	menuBuilder.AddMenuEntry(LOCTEXT("DebuggerTab_Heatmap_ShowLive", "Play In Editor"), LOCTEXT("DebuggerTab_Heatmap_ShowLive_Tooltip", "Count state events of all Play In Editor instances of asset while heatmap is shown"), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateLambda([this]() { SetHeatmapSource(EHeatmapSource::Live); })));
+
+	menuBuilder.AddMenuEntry(LOCTEXT("DebuggerTab_Heatmap_ShowFile", "From File..."), LOCTEXT("DebuggerTab_Heatmap_ShowFile_Tooltip", "Show counts saved by InputSequence.HitCounters Save console command"), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateLambda([this]() { SetHeatmapSource(EHeatmapSource::File); })));
+
+	return menuBuilder.MakeWidget();
+}
+
+void FInputSequenceAssetEditor::SetHeatmapSource(EHeatmapSource source)
+{
+	FString filePath;
+
+	if (source == EHeatmapSource::File)
+	{
+		IDesktopPlatform* desktopPlatform = FDesktopPlatformModule::Get();
+
+		TArray<FString> filePaths;
+
+		if (!desktopPlatform || !desktopPlatform->OpenFileDialog(FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr), LOCTEXT("Heatmap_OpenFile", "Open Hit Counters").ToString(),
+			FPaths::ProjectSavedDir() / TEXT("InputSequence"), TEXT(""), TEXT("Input Sequence Hit Counters (*.ishits)|*.ishits"), EFileDialogFlags::None, filePaths) || filePaths.Num() == 0) return;
+
+		filePath = filePaths[0];
+	}
+
+	if (HeatmapTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(HeatmapTickHandle);
+		HeatmapTickHandle.Reset();
+	}
+
+	if (bIsHeatmapCountingStarted)
+	{
+		FInputSequenceHitCounters::Get().Stop();
+		bIsHeatmapCountingStarted = false;
+	}
+
+	HeatmapSource = source;
+	HeatmapFilePath = filePath;
+	HeatmapStateNodeGuids.Reset();
+
+	ShowHeatmap(nullptr);
+
+	UInputSequenceGraph* graph = InputSequenceAsset ? Cast<UInputSequenceGraph>(InputSequenceAsset->EdGraph) : nullptr;
+
+	if (source == EHeatmapSource::None || !graph) return;
+
+	// Counts are kept per compiled graph, states are mapped to nodes the same way asset is compiled
+
+	TArray<FInputSequenceState> states;
+	TArray<UEdGraphNode*> stateNodes;
+	graph->CompileStates(states, &stateNodes);
+
+	HeatmapSourceHash = FInputSequenceCompiledData::HashSource(states);
+
+	for (UEdGraphNode* stateNode : stateNodes)
+	{
+		HeatmapStateNodeGuids.Add(stateNode ? stateNode->NodeGuid : FGuid());
+	}
+
+	if (source == EHeatmapSource::Live)
+	{
+		FInputSequenceHitCounters& hitCounters = FInputSequenceHitCounters::Get();
+
+		if (!hitCounters.IsStarted())
+		{
+			hitCounters.Start();
+			bIsHeatmapCountingStarted = true;
+		}
+
+		HeatmapTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FInputSequenceAssetEditor::TickHeatmap), HeatmapTickInterval);
+
+		TickHeatmap(0);
+	}
+	else
+	{
+		TMap<FIoHash, FInputSequenceHitCountersRecord> records;
+		FInputSequenceHitCounters::LoadFromFile(filePath, records);
+
+		ShowHeatmap(records.Find(HeatmapSourceHash));
+	}
+}
+
+void FInputSequenceAssetEditor::ShowHeatmap(const FInputSequenceHitCountersRecord* record)
+{
+	UInputSequenceGraph* graph = InputSequenceAsset ? Cast<UInputSequenceGraph>(InputSequenceAsset->EdGraph) : nullptr;
+
+	if (!graph) return;
+
+	graph->HeatmapNodeStates.Reset();
+
+	bHasHeatmapCounts = record && record->NumStates() == HeatmapStateNodeGuids.Num();
+
+	if (!bHasHeatmapCounts) return;
+
+	for (int32 stateIndex = 0; stateIndex < HeatmapStateNodeGuids.Num(); stateIndex++)
+	{
+		if (!HeatmapStateNodeGuids[stateIndex].IsValid()) continue;
+
+		FInputSequenceHeatmapNodeState& heatmapNodeState = graph->HeatmapNodeStates.FindOrAdd(HeatmapStateNodeGuids[stateIndex]);
+		heatmapNodeState.NumEnters += record->Get(stateIndex, InputSequenceCore::EStateEvent::Enter);
+		heatmapNodeState.NumPasses += record->Get(stateIndex, InputSequenceCore::EStateEvent::Pass);
+		heatmapNodeState.NumResets += record->Get(stateIndex, InputSequenceCore::EStateEvent::Reset);
+	}
+
+	uint64 maxEnters = 0;
+	for (const TPair<FGuid, FInputSequenceHeatmapNodeState>& heatmapNodeState : graph->HeatmapNodeStates) maxEnters = FMath::Max(maxEnters, heatmapNodeState.Value.NumEnters);
+
+	if (maxEnters == 0) return;
+
+	for (TPair<FGuid, FInputSequenceHeatmapNodeState>& heatmapNodeState : graph->HeatmapNodeStates)
+	{
+		heatmapNodeState.Value.Heat = (float)(FMath::Loge(1.0 + heatmapNodeState.Value.NumEnters) / FMath::Loge(1.0 + maxEnters));
+	}
+}
+
+bool FInputSequenceAssetEditor::TickHeatmap(float DeltaTime)
+{
+	FInputSequenceHitCountersRecord record;
+	const bool bHasRecord = FInputSequenceHitCounters::Get().GetRecord(HeatmapSourceHash, record);
+
+	ShowHeatmap(bHasRecord ? &record : nullptr);
+
+	return true;
+}
+
+FText FInputSequenceAssetEditor::GetHeatmapStatusText() const
+{
+	switch (HeatmapSource)
+	{
+	case EHeatmapSource::Live:
+		return bHasHeatmapCounts
+			? LOCTEXT("DebuggerTab_HeatmapStatus_Live", "Times nodes are entered, passed and reset by all Play In Editor instances")
+			: LOCTEXT("DebuggerTab_HeatmapStatus_LiveWaiting", "Waiting for Play In Editor instances made from current version of graph");
+
+	case EHeatmapSource::File:
+		return bHasHeatmapCounts
+			? FText::Format(LOCTEXT("DebuggerTab_HeatmapStatus_File", "Times nodes were entered, passed and reset, saved in {0}"), FText::FromString(HeatmapFilePath))
+			: FText::Format(LOCTEXT("DebuggerTab_HeatmapStatus_FileMissing", "{0} has no counts of current version of graph"), FText::FromString(HeatmapFilePath));
+
+	default:
+		return LOCTEXT("DebuggerTab_HeatmapStatus_None", "Show how often nodes are entered, passed and reset, live from Play In Editor or from file saved by InputSequence.HitCounters Save");
+	}
+}
+
 void FInputSequenceAssetEditor::CreateCommandList()
 {
 	if (GraphEditorCommands.IsValid()) return;
@@ -3378,6 +4654,10 @@ void FInputSequenceAssetEditor::CreateCommandList()
 		FCanExecuteAction::CreateRaw(this, &FInputSequenceAssetEditor::CanDuplicateNodes)
 	);
 
+	GraphEditorCommands->MapAction(FInputSequenceEditorCommands::Get().AutoArrange,
+		FExecuteAction::CreateRaw(this, &FInputSequenceAssetEditor::AutoArrangeNodes)
+	);
+
 	GraphEditorCommands->MapAction(
 		FGraphEditorCommands::Get().CreateComment,
 		FExecuteAction::CreateRaw(this, &FInputSequenceAssetEditor::OnCreateComment),
@@ -3724,6 +5004,37 @@ bool FInputSequenceAssetEditor::CanPasteNodes() const
 	return false;
 }
 
+void FInputSequenceAssetEditor::AutoArrangeNodes()
+{
+	UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(InputSequenceAsset->EdGraph);
+
+	if (!graph) return;
+
+	TSharedPtr<SGraphEditor> graphEditor = GraphEditorPtr.Pin();
+
+	const FScopedTransaction Transaction(LOCTEXT("AutoArrange", "Auto Arrange"));
+
+	graph->Modify();
+
+	const double startTime = FPlatformTime::Seconds();
+
+	// Sizes come from node widgets, nodes never drawn yet get default size
+
+	FInputSequenceGraphLayout::Arrange(graph, [&](const UEdGraphNode* node) -> FVector2D
+		{
+			if (graphEditor.IsValid() && graphEditor->GetGraphPanel())
+			{
+				if (TSharedPtr<SGraphNode> nodeWidget = graphEditor->GetGraphPanel()->GetNodeWidgetFromGuid(node->NodeGuid)) return nodeWidget->GetDesiredSize();
+			}
+
+			return FVector2D(200, 100);
+		});
+
+	UE_LOG(LogInputSequence, Verbose, TEXT("Input Sequence %s: %d graph nodes arranged in %.2f ms"), *InputSequenceAsset->GetPathName(), graph->Nodes.Num(), (FPlatformTime::Seconds() - startTime) * 1000);
+
+	graph->NotifyGraphChanged();
+}
+
 void FInputSequenceAssetEditor::OnCreateComment()
 {
 	if (TSharedPtr<SGraphEditor> graphEditor = GraphEditorPtr.Pin())
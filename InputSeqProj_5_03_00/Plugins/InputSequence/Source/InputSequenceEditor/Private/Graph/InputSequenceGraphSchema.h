@@ -45,7 +45,9 @@ struct FInputSequenceGraphSchemaAction_AddPin : public FEdGraphSchemaAction
 	GENERATED_BODY()
 
 	FName InputName;
-	TObjectPtr<UObject> InputAction;
+
+	/* Enhanced Input Action of pin, loaded only when pin is added */
+	FSoftObjectPath InputAction;
 
 	int32 InputIndex;
 
@@ -53,11 +55,12 @@ struct FInputSequenceGraphSchemaAction_AddPin : public FEdGraphSchemaAction
 
 	uint8 IsAxis : 1;
 	uint8 Is2DAxis : 1;
+	uint8 IsAxisRegion : 1;
 
-	FInputSequenceGraphSchemaAction_AddPin() : FEdGraphSchemaAction(), InputName(NAME_None), InputAction(nullptr), InputIndex(INDEX_NONE), CorrectedInputIndex(INDEX_NONE), IsAxis(0), Is2DAxis(0) {}
+	FInputSequenceGraphSchemaAction_AddPin() : FEdGraphSchemaAction(), InputName(NAME_None), InputIndex(INDEX_NONE), CorrectedInputIndex(INDEX_NONE), IsAxis(0), Is2DAxis(0), IsAxisRegion(0) {}
 
 	FInputSequenceGraphSchemaAction_AddPin(FText InNodeCategory, FText InMenuDesc, FText InToolTip, const int32 InGrouping, int32 InSectionID)
-		: FEdGraphSchemaAction(MoveTemp(InNodeCategory), MoveTemp(InMenuDesc), MoveTemp(InToolTip), InGrouping, FText::GetEmpty(), InSectionID), InputName(NAME_None), InputAction(nullptr), InputIndex(INDEX_NONE), CorrectedInputIndex(INDEX_NONE), IsAxis(0), Is2DAxis(0)
+		: FEdGraphSchemaAction(MoveTemp(InNodeCategory), MoveTemp(InMenuDesc), MoveTemp(InToolTip), InGrouping, FText::GetEmpty(), InSectionID), InputName(NAME_None), InputIndex(INDEX_NONE), CorrectedInputIndex(INDEX_NONE), IsAxis(0), Is2DAxis(0), IsAxisRegion(0)
 	{}
 
 	virtual UEdGraphNode* PerformAction(class UEdGraph* ParentGraph, UEdGraphPin* FromPin, const FVector2D Location, bool bSelectNewNode = true) override;
@@ -80,6 +83,8 @@ public:
 
 	static const FName PC_Axis;
 
+	static const FName PC_AxisRegion;
+
 	static const FName PC_HubAdd;
 
 	virtual void GetGraphContextActions(FGraphContextMenuBuilder& ContextMenuBuilder) const override;
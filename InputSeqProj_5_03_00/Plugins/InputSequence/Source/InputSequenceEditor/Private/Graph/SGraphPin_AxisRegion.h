@@ -0,0 +1,41 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Graph/SGraphPin_Axis.h"
+#include "InputSequenceAsset.h"
+
+/* Pin of 2D or 3D Enhanced Input axis, default value is FInputSequenceAxisRegion in text form */
+class SGraphPin_AxisRegion : public SGraphPin_Axis
+{
+public:
+
+	SLATE_BEGIN_ARGS(SGraphPin_AxisRegion) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UEdGraphPin* InPin);
+
+protected:
+
+	virtual TSharedRef<SWidget> GetDefaultValueWidget() override;
+
+	TSharedRef<SWidget> MakeVectorRow(int32 VectorIndex);
+
+	FInputSequenceAxisRegion GetRegion() const;
+
+	void SetRegion(const FInputSequenceAxisRegion& Region);
+
+	FText GetShapeText() const;
+
+	TSharedRef<SWidget> OnGetShapeMenuContent();
+
+	void OnShapeSelected(EInputSequenceAxisRegionShape Shape);
+
+	FText GetVectorLabel(int32 VectorIndex) const;
+
+	EVisibility GetComponentVisibility(int32 VectorIndex, int32 ComponentIndex) const;
+
+	TOptional<float> GetComponentValue(int32 VectorIndex, int32 ComponentIndex) const;
+
+	void OnComponentCommitted(float NewValue, ETextCommit::Type CommitInfo, int32 VectorIndex, int32 ComponentIndex);
+};
\ No newline at end of file
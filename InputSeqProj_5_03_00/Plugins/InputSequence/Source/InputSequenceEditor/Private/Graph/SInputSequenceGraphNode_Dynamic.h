@@ -13,4 +13,20 @@ public:
 	void Construct(const FArguments& InArgs, UEdGraphNode* InNode);
 
 	virtual ~SInputSequenceGraphNode_Dynamic();
+
+	/* Tinted by debugger: active nodes are highlighted, entered, passed and reset nodes flash. Without debugger, tinted by heat of heatmap */
+	virtual FSlateColor GetNodeBodyColor() const override;
+
+	/* Timer of active node is shown as progress bar under it while debugger is attached, hit counts are shown above it while heatmap is shown */
+	virtual TArray<FOverlayWidgetInfo> GetOverlayWidgets(bool bSelected, const FVector2D& WidgetSize) const override;
+
+protected:
+
+	const struct FInputSequenceDebugNodeState* GetDebugNodeState() const;
+
+	const struct FInputSequenceHeatmapNodeState* GetHeatmapNodeState() const;
+
+	TSharedPtr<SWidget> DebugTimerBar;
+
+	TSharedPtr<SWidget> HeatmapCounts;
 };
\ No newline at end of file
@@ -0,0 +1,309 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceAnalyzer.h"
+#include "InputSequenceAsset.h"
+#include "InputSequenceEditorSettings.h"
+#include "Graph/InputSequenceGraph.h"
+#include "Graph/InputSequenceGraphNode_Base.h"
+#include "Graph/InputSequenceGraphNode_Hub.h"
+
+#define LOCTEXT_NAMESPACE "FInputSequenceAnalyzer"
+
+namespace
+{
+	/* States that are active after state passes: its next states with empty Input states jumped through, or its First Layer parent if it has no next states */
+	struct FPassFrontier
+	{
+		TArray<int32> States;
+
+		// Passed state and empty Input states jumped through
+		int32 Transitions = 0;
+	};
+
+	/* Worst case of subtree of state after it passes, every component is its own upper bound */
+	struct FWorstCase
+	{
+		int32 ActiveStates = 0;
+		int32 Transitions = 0;
+		int32 ActionTests = 0;
+	};
+
+	void BuildPassFrontier(const TArray<FInputSequenceState>& states, int32 stateIndex, FPassFrontier& outFrontier, TSet<int32>& visited)
+	{
+		outFrontier.Transitions++;
+
+		const FInputSequenceState& state = states[stateIndex];
+
+		if (state.NextIndice.Num() == 0)
+		{
+			if (states.IsValidIndex(state.FirstLayerParentIndex)) outFrontier.States.AddUnique(state.FirstLayerParentIndex);
+
+			return;
+		}
+
+		for (int32 nextIndex : state.NextIndice)
+		{
+			if (!states.IsValidIndex(nextIndex) || visited.Contains(nextIndex)) continue;
+
+			visited.Add(nextIndex);
+
+			const FInputSequenceState& nextState = states[nextIndex];
+
+			if (nextState.IsInputNode && nextState.IsEmpty())
+			{
+				BuildPassFrontier(states, nextIndex, outFrontier, visited);
+			}
+			else
+			{
+				outFrontier.States.Add(nextIndex);
+			}
+		}
+	}
+
+	int32 GetActionTests(const FInputSequenceState& state)
+	{
+		return state.IsInputNode ? 1 + state.InputActions.Num() + state.PressedActions.Num() : 1;
+	}
+
+	FWorstCase GetWorstCase(const TArray<FInputSequenceState>& states, const TArray<FPassFrontier>& frontiers, int32 stateIndex, TMap<int32, FWorstCase>& memo, TSet<int32>& onStack)
+	{
+		if (const FWorstCase* worstCase = memo.Find(stateIndex)) return *worstCase;
+
+		// Loops back to states that are already on path add nothing but themselves
+
+		if (onStack.Contains(stateIndex)) return FWorstCase();
+
+		onStack.Add(stateIndex);
+
+		FWorstCase result;
+
+		for (int32 activeIndex : frontiers[stateIndex].States)
+		{
+			const FInputSequenceState& activeState = states[activeIndex];
+
+			// Non Input states (Go To Start) are never passed, they only reset
+
+			const FWorstCase passed = activeState.IsInputNode ? GetWorstCase(states, frontiers, activeIndex, memo, onStack) : FWorstCase();
+
+			result.ActiveStates += FMath::Max(1, passed.ActiveStates);
+			result.Transitions += FMath::Max(activeState.IsInputNode ? frontiers[activeIndex].Transitions : 0, passed.Transitions);
+			result.ActionTests += FMath::Max(GetActionTests(activeState), passed.ActionTests);
+		}
+
+		onStack.Remove(stateIndex);
+
+		memo.Add(stateIndex, result);
+
+		return result;
+	}
+
+	bool AreRangesOverlapping(float minA, float maxA, float minB, float maxB)
+	{
+		return FMath::Min(minA, maxA) <= FMath::Max(minB, maxB) && FMath::Min(minB, maxB) <= FMath::Max(minA, maxA);
+	}
+
+	/* Same input can advance both actions. Regions and gesture paths are compared as they are, not by their geometry */
+	bool CanMatchSameInput(const FInputActionState& actionA, const FInputActionState& actionB)
+	{
+		if (actionA.IsGesture() || actionB.IsGesture())
+		{
+			if (actionA.GetGestureSteps().Num() != actionB.GetGestureSteps().Num()) return false;
+
+			for (int32 i = 0; i < actionA.GetGestureSteps().Num(); i++)
+			{
+				if (actionA.GetGestureSteps()[i].ToString() != actionB.GetGestureSteps()[i].ToString()) return false;
+			}
+
+			return true;
+		}
+
+		if (actionA.IsRegionAxis() || actionB.IsRegionAxis())
+		{
+			return actionA.IsRegionAxis() && actionB.IsRegionAxis() && actionA.GetRegion().ToString() == actionB.GetRegion().ToString();
+		}
+
+		return AreRangesOverlapping(actionA.GetX(), actionA.GetY(), actionB.GetX(), actionB.GetY());
+	}
+
+	/* Actions of states entered together that make both of them advance: for Input Actions one set has to contain the other, for axes every shared axis has to overlap */
+	bool GetAmbiguity(const FInputSequenceState& stateA, const FInputSequenceState& stateB, TArray<FName>& outSharedActions)
+	{
+		if (!stateA.IsInputNode || !stateB.IsInputNode || stateA.IsEmpty() || stateB.IsEmpty()) return false;
+
+		outSharedActions.Reset();
+
+		for (const TPair<FName, FInputActionState>& inputAction : stateA.InputActions)
+		{
+			if (stateB.InputActions.Contains(inputAction.Key)) outSharedActions.Add(inputAction.Key);
+		}
+
+		if (outSharedActions.Num() == 0) return false;
+
+		if (stateA.IsAxisNode || stateB.IsAxisNode)
+		{
+			if (stateA.IsAxisNode != stateB.IsAxisNode) return false;
+
+			for (const FName& sharedAction : outSharedActions)
+			{
+				if (!CanMatchSameInput(stateA.InputActions[sharedAction], stateB.InputActions[sharedAction])) return false;
+			}
+
+			return true;
+		}
+
+		return outSharedActions.Num() == stateA.InputActions.Num() || outSharedActions.Num() == stateB.InputActions.Num();
+	}
+}
+
+FText FInputSequenceAnalysis::DescribeState(int32 stateIndex) const
+{
+	if (StateNodes.IsValidIndex(stateIndex))
+	{
+		if (UEdGraphNode* node = StateNodes[stateIndex].Get())
+		{
+			return FText::Format(LOCTEXT("StateWithNode", "{0} (state {1})"), node->GetNodeTitle(ENodeTitleType::ListView), FText::AsNumber(stateIndex));
+		}
+	}
+
+	return FText::Format(LOCTEXT("State", "State {0}"), FText::AsNumber(stateIndex));
+}
+
+void FInputSequenceAnalysis::GetMessages(TArray<FMessage>& outMessages) const
+{
+	const UInputSequenceEditorSettings* settings = GetDefault<UInputSequenceEditorSettings>();
+
+	auto addMessage = [&](const FText& text, bool bIsError, UEdGraphNode* node = nullptr)
+	{
+		FMessage& message = outMessages.AddDefaulted_GetRef();
+		message.Text = text;
+		message.bIsError = bIsError;
+		message.Node = node;
+	};
+
+	if (MaxActiveStates > settings->MaxActiveStates)
+	{
+		addMessage(FText::Format(LOCTEXT("Message_MaxActiveStates", "Up to {0} states can be active at the same time, budget is {1}"), FText::AsNumber(MaxActiveStates), FText::AsNumber(settings->MaxActiveStates)), true);
+	}
+
+	if (MaxTransitionsPerEvent > settings->MaxTransitionsPerEvent)
+	{
+		addMessage(FText::Format(LOCTEXT("Message_MaxTransitionsPerEvent", "Up to {0} transitions can be made on one input event, budget is {1}"), FText::AsNumber(MaxTransitionsPerEvent), FText::AsNumber(settings->MaxTransitionsPerEvent)), true);
+	}
+
+	if (EstimatedFrameCostMicroseconds > settings->MaxFrameCostMicroseconds)
+	{
+		addMessage(FText::Format(LOCTEXT("Message_MaxFrameCost", "Evaluation can cost up to {0} us per frame ({1} action tests), budget is {2} us"), FText::AsNumber(EstimatedFrameCostMicroseconds), FText::AsNumber(MaxActionTestsPerFrame), FText::AsNumber(settings->MaxFrameCostMicroseconds)), true);
+	}
+
+	for (const TWeakObjectPtr<UEdGraphNode>& unreachableNode : UnreachableNodes)
+	{
+		if (UEdGraphNode* node = unreachableNode.Get())
+		{
+			addMessage(FText::Format(LOCTEXT("Message_UnreachableNode", "{0} is not reached from Start node"), node->GetNodeTitle(ENodeTitleType::ListView)), settings->bUnreachableNodesAreErrors, node);
+		}
+	}
+
+	for (const FInputSequenceAnalysis::FAmbiguity& ambiguity : Ambiguities)
+	{
+		TArray<FString> sharedActions;
+		for (const FName& sharedAction : ambiguity.SharedActions) sharedActions.Add(sharedAction.ToString());
+
+		addMessage(FText::Format(LOCTEXT("Message_Ambiguity", "{0} and {1} are active together and both advance on {2}"), DescribeState(ambiguity.StateA), DescribeState(ambiguity.StateB), FText::FromString(FString::Join(sharedActions, TEXT(", ")))), settings->bAmbiguitiesAreErrors, StateNodes.IsValidIndex(ambiguity.StateA) ? StateNodes[ambiguity.StateA].Get() : nullptr);
+	}
+}
+
+void FInputSequenceAnalyzer::Analyze(UInputSequenceAsset* asset, FInputSequenceAnalysis& outAnalysis)
+{
+	outAnalysis = FInputSequenceAnalysis();
+
+	if (!asset) return;
+
+	UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(asset->EdGraph);
+
+	if (!graph)
+	{
+		Analyze(asset->States, outAnalysis);
+		return;
+	}
+
+	TArray<FInputSequenceState> states;
+	TArray<UEdGraphNode*> stateNodes;
+	graph->CompileStates(states, &stateNodes);
+
+	Analyze(states, outAnalysis);
+
+	TSet<UEdGraphNode*> reachedNodes;
+
+	for (UEdGraphNode* stateNode : stateNodes)
+	{
+		outAnalysis.StateNodes.Add(stateNode);
+		reachedNodes.Add(stateNode);
+	}
+
+	// Hubs are not compiled into states, they are only passed through
+
+	for (UEdGraphNode* node : graph->Nodes)
+	{
+		if (node && node->IsA<UInputSequenceGraphNode_Base>() && !node->IsA<UInputSequenceGraphNode_Hub>() && !reachedNodes.Contains(node))
+		{
+			outAnalysis.UnreachableNodes.Add(node);
+		}
+	}
+}
+
+void FInputSequenceAnalyzer::Analyze(const TArray<FInputSequenceState>& states, FInputSequenceAnalysis& outAnalysis)
+{
+	outAnalysis.NumStates = states.Num();
+
+	if (states.Num() == 0) return;
+
+	TArray<FPassFrontier> frontiers;
+	frontiers.SetNum(states.Num());
+
+	for (int32 stateIndex = 0; stateIndex < states.Num(); stateIndex++)
+	{
+		TSet<int32> visited;
+		BuildPassFrontier(states, stateIndex, frontiers[stateIndex], visited);
+	}
+
+	// Start state is never active itself, evaluation begins by passing it
+
+	TMap<int32, FWorstCase> memo;
+	TSet<int32> onStack;
+
+	const FWorstCase worstCase = GetWorstCase(states, frontiers, 0, memo, onStack);
+
+	outAnalysis.MaxActiveStates = worstCase.ActiveStates;
+	outAnalysis.MaxTransitionsPerEvent = worstCase.Transitions;
+	outAnalysis.MaxActionTestsPerFrame = worstCase.ActionTests;
+	outAnalysis.EstimatedFrameCostMicroseconds = worstCase.ActionTests * GetDefault<UInputSequenceEditorSettings>()->NanosecondsPerActionTest / 1000.0;
+
+	TSet<TPair<int32, int32>> ambiguousPairs;
+	TArray<FName> sharedActions;
+
+	for (const FPassFrontier& frontier : frontiers)
+	{
+		for (int32 i = 0; i < frontier.States.Num(); i++)
+		{
+			for (int32 j = i + 1; j < frontier.States.Num(); j++)
+			{
+				const int32 stateA = FMath::Min(frontier.States[i], frontier.States[j]);
+				const int32 stateB = FMath::Max(frontier.States[i], frontier.States[j]);
+
+				if (ambiguousPairs.Contains(TPair<int32, int32>(stateA, stateB))) continue;
+
+				if (GetAmbiguity(states[stateA], states[stateB], sharedActions))
+				{
+					ambiguousPairs.Add(TPair<int32, int32>(stateA, stateB));
+
+					FInputSequenceAnalysis::FAmbiguity& ambiguity = outAnalysis.Ambiguities.AddDefaulted_GetRef();
+					ambiguity.StateA = stateA;
+					ambiguity.StateB = stateB;
+					ambiguity.SharedActions = sharedActions;
+				}
+			}
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
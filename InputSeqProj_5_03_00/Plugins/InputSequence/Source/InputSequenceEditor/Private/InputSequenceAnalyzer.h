@@ -0,0 +1,67 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UInputSequenceAsset;
+class UEdGraphNode;
+struct FInputSequenceState;
+
+/* Worst cases are upper bounds: every active state is assumed to stay active until it passes, and every state of active set is assumed to pass on the same input event */
+struct FInputSequenceAnalysis
+{
+	struct FAmbiguity
+	{
+		/* States entered together, input that advances StateA advances StateB as well */
+		int32 StateA = INDEX_NONE;
+		int32 StateB = INDEX_NONE;
+
+		TArray<FName> SharedActions;
+	};
+
+	struct FMessage
+	{
+		FText Text;
+
+		bool bIsError = false;
+
+		/* Node message is about, if any */
+		TWeakObjectPtr<UEdGraphNode> Node;
+	};
+
+	int32 NumStates = 0;
+
+	/* Graph node of every state, empty if asset has no graph */
+	TArray<TWeakObjectPtr<UEdGraphNode>> StateNodes;
+
+	/* Nodes that are not reached from Start node, so they are not compiled at all */
+	TArray<TWeakObjectPtr<UEdGraphNode>> UnreachableNodes;
+
+	TArray<FAmbiguity> Ambiguities;
+
+	int32 MaxActiveStates = 0;
+
+	int32 MaxTransitionsPerEvent = 0;
+
+	/* Action and pressed action tests made over worst case active set per frame */
+	int32 MaxActionTestsPerFrame = 0;
+
+	double EstimatedFrameCostMicroseconds = 0;
+
+	/* Readable description of state for messages */
+	FText DescribeState(int32 stateIndex) const;
+
+	/* Budget violations of Input Sequence Editor settings, unreachable nodes and ambiguities */
+	void GetMessages(TArray<FMessage>& outMessages) const;
+};
+
+class FInputSequenceAnalyzer
+{
+public:
+
+	/* Compiles asset graph (reusing compiled nodes) and analyzes States it is compiled into */
+	static void Analyze(UInputSequenceAsset* asset, FInputSequenceAnalysis& outAnalysis);
+
+	static void Analyze(const TArray<FInputSequenceState>& states, FInputSequenceAnalysis& outAnalysis);
+};
\ No newline at end of file
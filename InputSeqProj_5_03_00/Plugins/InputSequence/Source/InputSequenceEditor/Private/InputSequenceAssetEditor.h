@@ -4,9 +4,13 @@
 
 #include "EditorUndoClient.h"
 #include "Toolkits/AssetEditorToolkit.h"
+#include "Containers/Ticker.h"
+#include "IO/IoHash.h"
+#include "InputSequenceCore.h"
 
 class UInputSequenceAsset;
 class IDetailsView;
+struct FInputSequenceHitCountersRecord;
 
 class FInputSequenceAssetEditor : public FEditorUndoClient, public FAssetEditorToolkit
 {
@@ -15,6 +19,10 @@ public:
 	static const FName AppIdentifier;
 	static const FName DetailsTabId;
 	static const FName GraphTabId;
+	static const FName AnalysisTabId;
+	static const FName DebuggerTabId;
+
+	virtual ~FInputSequenceAssetEditor();
 
 	void InitInputSequenceAssetEditor(const EToolkitMode::Type Mode, const TSharedPtr< class IToolkitHost >& InitToolkitHost, UInputSequenceAsset* inputSequenceAsset);
 
@@ -31,6 +39,52 @@ protected:
 
 	TSharedRef<SDockTab> SpawnTab_DetailsTab(const FSpawnTabArgs& Args);
 	TSharedRef<SDockTab> SpawnTab_GraphTab(const FSpawnTabArgs& Args);
+	TSharedRef<SDockTab> SpawnTab_AnalysisTab(const FSpawnTabArgs& Args);
+	TSharedRef<SDockTab> SpawnTab_DebuggerTab(const FSpawnTabArgs& Args);
+
+	/* Analyzes asset and fills Analysis tab with worst case estimations and messages */
+	void RefreshAnalysis();
+
+	/* Runtime instances of asset in Play In Editor worlds, and asset itself for sequences fed to it directly (e.g. OnInput from Blueprint) */
+	void GetDebugCandidates(TArray<UInputSequenceAsset*>& outInstances) const;
+
+	/* Owner of instance, or "Asset (shared)" for asset itself */
+	FText GetDebugCandidateName(const UInputSequenceAsset* instance) const;
+
+	TSharedRef<SWidget> MakeDebugCandidatesMenu();
+
+	/* Attaches ring to instance, so its state events are shown on graph nodes. Nullptr only detaches current instance */
+	void AttachDebugger(UInputSequenceAsset* instance);
+
+	void DetachDebugger();
+
+	/* Reads state events and active states of debugged instance into graph node states */
+	bool TickDebugger(float DeltaTime);
+
+	void OnEndPIE(const bool bIsSimulating) { DetachDebugger(); }
+
+	FText GetDebuggerStatusText() const;
+
+	/* Source of hit counts shown as heatmap on graph nodes */
+	enum class EHeatmapSource : uint8
+	{
+		None,
+		/* Counts of Play In Editor instances, counting is started while heatmap is shown */
+		Live,
+		/* Counts saved by InputSequence.HitCounters console command */
+		File
+	};
+
+	void SetHeatmapSource(EHeatmapSource source);
+
+	TSharedRef<SWidget> MakeHeatmapSourceMenu();
+
+	/* Sums counts of states into graph nodes they are compiled from. Counts are shown only if they are made with current version of graph */
+	void ShowHeatmap(const FInputSequenceHitCountersRecord* record);
+
+	bool TickHeatmap(float DeltaTime);
+
+	FText GetHeatmapStatusText() const;
 
 	void CreateCommandList();
 
@@ -71,6 +125,9 @@ protected:
 
 	bool CanDuplicateNodes() const { return CanCopyNodes(); }
 
+	/* Layered layout of nodes reached from Start node, see FInputSequenceGraphLayout */
+	void AutoArrangeNodes();
+
 	void OnCreateComment();
 
 	bool CanCreateComment() const;
@@ -84,4 +141,40 @@ protected:
 	TWeakPtr<SGraphEditor> GraphEditorPtr;
 
 	TSharedPtr<IDetailsView> DetailsView;
+
+	TSharedPtr<class SVerticalBox> AnalysisBox;
+
+	TWeakObjectPtr<UInputSequenceAsset> DebuggedInstance;
+
+	/* Owned by editor, instance only writes into it while attached */
+	TUniquePtr<InputSequenceCore::FDebugRing> DebugRing;
+
+	uint64 DebugReadIndex = 0;
+
+	uint64 NumLostDebugRecords = 0;
+
+	std::vector<InputSequenceCore::FDebugRecord> DebugRecords;
+
+	/* Graph node guid per compiled state of debugged instance */
+	TArray<FGuid> DebugStateNodeGuids;
+
+	/* Set if instance was made before last changes of graph, so its states may not match nodes */
+	bool bIsDebuggedInstanceOutdated = false;
+
+	FTSTicker::FDelegateHandle DebuggerTickHandle;
+
+	EHeatmapSource HeatmapSource = EHeatmapSource::None;
+
+	FString HeatmapFilePath;
+
+	/* Source hash and graph node guid per compiled state of graph when heatmap was shown, counts are looked up by this hash */
+	FIoHash HeatmapSourceHash;
+	TArray<FGuid> HeatmapStateNodeGuids;
+
+	bool bHasHeatmapCounts = false;
+
+	/* Set if counting was started for heatmap, so it is stopped with heatmap */
+	bool bIsHeatmapCountingStarted = false;
+
+	FTSTicker::FDelegateHandle HeatmapTickHandle;
 };
\ No newline at end of file
@@ -0,0 +1,208 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceCompiler.h"
+#include "InputSequence.h"
+#include "InputSequenceAsset.h"
+#include "Graph/InputSequenceGraph.h"
+#include "Hash/Blake3.h"
+#include "DerivedDataCacheInterface.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+// Change to invalidate all cached compiled data regardless of compiler and blob versions
+#define INPUTSEQUENCE_DDC_VERSION TEXT("8D1C5A7E2B6F4A93B0E47C2D9F1A6E35")
+
+bool FInputSequenceCompiler::Compile(UInputSequenceAsset* asset, bool bForce)
+{
+	if (!asset) return false;
+
+	UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(asset->EdGraph);
+
+	if (!graph)
+	{
+		// Nothing to compile from, keep saved data or rebuild it from saved States
+
+		if (asset->States.Num() > 0 && (bForce || !asset->GetCompiledData().IsUpToDate(FInputSequenceCompiledData::HashSource(asset->States))))
+		{
+			asset->RebuildCompiledData();
+			return true;
+		}
+
+		return false;
+	}
+
+	// Graph is hashed before it is walked, so unchanged graph is neither walked nor packed again
+
+	const FIoHash graphHash = HashGraph(graph);
+
+	if (!bForce && graph->CompiledGraphHash == graphHash && asset->GetCompiledData().IsUpToDate()) return false;
+
+	const FString cacheKey = GetCacheKey(graphHash);
+
+	TArray<uint8> cachedData;
+	if (!bForce && GetDerivedDataCacheRef().GetSynchronous(*cacheKey, cachedData, asset->GetPathName()))
+	{
+		TArray<FInputSequenceState> states;
+		FInputSequenceCompiledData compiledData;
+
+		if (LoadFromCache(cachedData, states, compiledData) && compiledData.IsUpToDate())
+		{
+			asset->States = MoveTemp(states);
+			asset->SetCompiledData(compiledData);
+
+			graph->CompiledGraphHash = graphHash;
+
+			return true;
+		}
+	}
+
+	graph->CompileStates(asset->States);
+	graph->CompiledGraphHash = graphHash;
+
+	UE_LOG(LogInputSequence, Verbose, TEXT("Input Sequence %s: %d graph nodes compiled into %d states"), *asset->GetPathName(), graph->Nodes.Num(), asset->States.Num());
+
+	const bool bIsOutdated = bForce || !asset->GetCompiledData().IsUpToDate(FInputSequenceCompiledData::HashSource(asset->States));
+
+	if (bIsOutdated) asset->RebuildCompiledData();
+
+	FInputSequenceCompiledData compiledData = asset->GetCompiledData();
+
+	if (compiledData.IsValid())
+	{
+		cachedData.Reset();
+		SaveToCache(asset->States, compiledData, cachedData);
+
+		GetDerivedDataCacheRef().Put(*cacheKey, cachedData, asset->GetPathName());
+	}
+
+	return bIsOutdated;
+}
+
+FIoHash FInputSequenceCompiler::HashGraph(const UInputSequenceGraph* graph)
+{
+	FBlake3 hasher;
+
+	auto hashValue = [&hasher](const auto& value) { hasher.Update(&value, sizeof(value)); };
+
+	auto hashString = [&hasher, &hashValue](const FString& string)
+	{
+		hashValue(string.Len());
+		hasher.Update(*string, string.Len() * sizeof(TCHAR));
+	};
+
+	hashValue(FInputSequenceCompiledData::CompilerVersion);
+	hashValue(graph->Nodes.Num());
+
+	// Order of nodes, pins and links is hashed as well, as Start node is the first one and states are numbered in order links are walked
+
+	for (const UEdGraphNode* node : graph->Nodes)
+	{
+		if (!node)
+		{
+			hashValue(FGuid());
+			continue;
+		}
+
+		hashValue(node->NodeGuid);
+		hashString(node->GetClass()->GetPathName());
+
+		// Position, comment and other properties of base graph node do not affect States
+
+		for (TFieldIterator<FProperty> It(node->GetClass()); It; ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_Transient) || UEdGraphNode::StaticClass()->IsChildOf(It->GetOwnerClass())) continue;
+
+			FString value;
+			It->ExportTextItem_InContainer(value, node, nullptr, nullptr, PPF_None);
+
+			hashString(It->GetName());
+			hashString(value);
+		}
+
+		hashValue(node->Pins.Num());
+
+		for (const UEdGraphPin* pin : node->Pins)
+		{
+			hashString(pin->PinName.ToString());
+			hashString(pin->PinType.PinCategory.ToString());
+			hashValue((uint8)pin->Direction);
+			hashString(pin->GetDefaultAsString());
+
+			hashValue(pin->LinkedTo.Num());
+
+			for (const UEdGraphPin* linkedPin : pin->LinkedTo)
+			{
+				hashValue(linkedPin && linkedPin->GetOwningNode() ? linkedPin->GetOwningNode()->NodeGuid : FGuid());
+				hashString(linkedPin ? linkedPin->PinName.ToString() : FString());
+			}
+		}
+	}
+
+	return FIoHash(hasher.Finalize());
+}
+
+bool FInputSequenceCompiler::CompileLive(UInputSequenceAsset* asset)
+{
+	if (!asset) return false;
+
+	UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(asset->EdGraph);
+
+	if (!graph) return false;
+
+	const double startTime = FPlatformTime::Seconds();
+
+	// States follow edited graph from now on, graph is hashed again when it is compiled fully
+	graph->CompiledGraphHash = FIoHash::Zero;
+
+	graph->CompileStates(asset->States);
+
+	if (asset->GetCompiledData().IsUpToDate(FInputSequenceCompiledData::HashSource(asset->States))) return false;
+
+	asset->RebuildCompiledData();
+
+	UE_LOG(LogInputSequence, Verbose, TEXT("Input Sequence %s: live compiled %d states in %.2f ms"), *asset->GetPathName(), asset->States.Num(), (FPlatformTime::Seconds() - startTime) * 1000);
+
+	return true;
+}
+
+FString FInputSequenceCompiler::GetCacheKey(const FIoHash& graphHash)
+{
+	const FString version = FString::Printf(TEXT("%s_%u_%u_%d"), INPUTSEQUENCE_DDC_VERSION, FInputSequenceCompiledData::CompilerVersion, FInputSequenceCompiledData::BlobVersion, (int32)FInputSequenceCustomVersion::LatestVersion);
+
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("INPUTSEQ"), *version, *LexToString(graphHash));
+}
+
+bool FInputSequenceCompiler::LoadFromCache(const TArray<uint8>& cachedData, TArray<FInputSequenceState>& outStates, FInputSequenceCompiledData& outCompiledData)
+{
+	FMemoryReader reader(cachedData, true);
+	reader.SetCustomVersion(FInputSequenceCustomVersion::GUID, FInputSequenceCustomVersion::LatestVersion, TEXT("InputSequenceVer"));
+
+	FObjectAndNameAsStringProxyArchive archive(reader, true);
+
+	int32 numStates = 0;
+	archive << numStates;
+
+	if (archive.IsError() || numStates < 0 || numStates >= FInputSequenceCompactState::IndexNone) return false;
+
+	outStates.SetNum(numStates);
+	for (FInputSequenceState& state : outStates) FInputSequenceState::StaticStruct()->SerializeItem(archive, &state, nullptr);
+
+	outCompiledData.Serialize(archive);
+
+	return !archive.IsError() && outCompiledData.IsValid();
+}
+
+void FInputSequenceCompiler::SaveToCache(TArray<FInputSequenceState>& states, FInputSequenceCompiledData& compiledData, TArray<uint8>& outCachedData)
+{
+	FMemoryWriter writer(outCachedData, true);
+
+	FObjectAndNameAsStringProxyArchive archive(writer, false);
+
+	int32 numStates = states.Num();
+	archive << numStates;
+
+	for (FInputSequenceState& state : states) FInputSequenceState::StaticStruct()->SerializeItem(archive, &state, nullptr);
+
+	compiledData.Serialize(archive);
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+class UInputSequenceAsset;
+class UInputSequenceGraph;
+struct FInputSequenceCompiledData;
+struct FInputSequenceState;
+
+class FInputSequenceCompiler
+{
+public:
+
+	/* Compiles asset graph into States and compiled data. Unless forced, graph is hashed first: asset is kept as is if it was compiled from the same graph,
+	or States and compiled data are taken from DDC if the same graph was compiled before, so graph is walked only when it is new */
+	static bool Compile(UInputSequenceAsset* asset, bool bForce);
+
+	/* Hash of everything in graph that affects States: node guids and classes, properties of node classes, pin defaults and links, and compiler version */
+	static FIoHash HashGraph(const UInputSequenceGraph* graph);
+
+	static void CompileIfOutdated(UInputSequenceAsset* asset) { Compile(asset, false); }
+
+	/* Recompiles asset right after its graph is edited, so it can be played in editor without saving. Only dirty nodes are compiled again and DDC is not queried, as edited graph is hardly cached */
+	static bool CompileLive(UInputSequenceAsset* asset);
+
+protected:
+
+	static FString GetCacheKey(const FIoHash& graphHash);
+
+	static bool LoadFromCache(const TArray<uint8>& cachedData, TArray<FInputSequenceState>& outStates, FInputSequenceCompiledData& outCompiledData);
+
+	static void SaveToCache(TArray<FInputSequenceState>& states, FInputSequenceCompiledData& compiledData, TArray<uint8>& outCachedData);
+};
\ No newline at end of file
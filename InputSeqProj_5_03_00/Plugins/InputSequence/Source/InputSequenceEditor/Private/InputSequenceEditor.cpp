@@ -4,6 +4,10 @@
 #include "AssetToolsModule.h"
 #include "AssetTypeActions/AssetTypeActions_InputSequenceAsset.h"
 #include "Graph/InputSequenceGraphFactories.h"
+#include "InputSequenceAsset.h"
+#include "InputSequenceCompiler.h"
+#include "InputSequenceEditorCommands.h"
+#include "InputSequenceInputActionIndex.h"
 
 #define LOCTEXT_NAMESPACE "FInputSequenceEditorModule"
 
@@ -12,6 +16,8 @@ const FName PropertyEditorModuleName("PropertyEditor");
 
 void FInputSequenceEditorModule::StartupModule()
 {
+	FInputSequenceEditorCommands::Register();
+
 	RegisteredAssetTypeActions.Add(MakeShared<FAssetTypeActions_InputSequenceAsset>());
 
 	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(AssetToolsModuleName).Get();
@@ -28,10 +34,16 @@ void FInputSequenceEditorModule::StartupModule()
 
 	InputSequenceGraphPinConnectionFactory = MakeShareable(new FInputSequenceGraphPinConnectionFactory);
 	FEdGraphUtilities::RegisterVisualPinConnectionFactory(InputSequenceGraphPinConnectionFactory);
+
+	UInputSequenceAsset::CompileDelegate.BindStatic(&FInputSequenceCompiler::CompileIfOutdated);
 }
 
 void FInputSequenceEditorModule::ShutdownModule()
 {
+	UInputSequenceAsset::CompileDelegate.Unbind();
+
+	FInputSequenceInputActionIndex::Shutdown();
+
 	FEdGraphUtilities::UnregisterVisualPinConnectionFactory(InputSequenceGraphPinConnectionFactory);
 	InputSequenceGraphPinConnectionFactory.Reset();
 
@@ -51,6 +63,8 @@ void FInputSequenceEditorModule::ShutdownModule()
 	}
 
 	RegisteredAssetTypeActions.Empty();
+
+	FInputSequenceEditorCommands::Unregister();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,12 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceEditorCommands.h"
+
+#define LOCTEXT_NAMESPACE "FInputSequenceEditorCommands"
+
+void FInputSequenceEditorCommands::RegisterCommands()
+{
+	UI_COMMAND(AutoArrange, "Auto Arrange", "Place nodes in columns by their depth in sequence, ordered to reduce crossing links", EUserInterfaceActionType::Button, FInputChord());
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
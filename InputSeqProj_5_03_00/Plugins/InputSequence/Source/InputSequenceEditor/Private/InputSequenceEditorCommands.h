@@ -0,0 +1,19 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Framework/Commands/Commands.h"
+#include "Styling/AppStyle.h"
+
+class FInputSequenceEditorCommands : public TCommands<FInputSequenceEditorCommands>
+{
+public:
+
+	FInputSequenceEditorCommands()
+		: TCommands<FInputSequenceEditorCommands>(TEXT("InputSequenceEditor"), NSLOCTEXT("Contexts", "InputSequenceEditor", "Input Sequence Editor"), NAME_None, FAppStyle::GetAppStyleSetName())
+	{}
+
+	virtual void RegisterCommands() override;
+
+	TSharedPtr<FUICommandInfo> AutoArrange;
+};
\ No newline at end of file
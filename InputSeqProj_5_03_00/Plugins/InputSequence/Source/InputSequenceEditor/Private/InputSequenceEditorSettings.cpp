@@ -0,0 +1,17 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceEditorSettings.h"
+
+UInputSequenceEditorSettings::UInputSequenceEditorSettings(const FObjectInitializer& objInit) :Super(objInit)
+{
+	bValidateBudgets = true;
+
+	MaxActiveStates = 64;
+	MaxTransitionsPerEvent = 32;
+	MaxFrameCostMicroseconds = 20;
+
+	NanosecondsPerActionTest = 10;
+
+	bUnreachableNodesAreErrors = false;
+	bAmbiguitiesAreErrors = false;
+}
\ No newline at end of file
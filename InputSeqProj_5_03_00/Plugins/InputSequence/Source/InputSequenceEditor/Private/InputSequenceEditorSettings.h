@@ -0,0 +1,44 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+#include "InputSequenceEditorSettings.generated.h"
+
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Input Sequence Editor"))
+class UInputSequenceEditorSettings : public UDeveloperSettings
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	virtual FName GetCategoryName() const override { return FName("Plugins"); }
+
+	/* If checked, Input Sequence Assets are analyzed by Data Validation against budgets below */
+	UPROPERTY(config, EditAnywhere, Category = "Validation")
+		bool bValidateBudgets;
+
+	/* Upper bound of states that can be active at the same time */
+	UPROPERTY(config, EditAnywhere, Category = "Validation", meta = (ClampMin = "1", EditCondition = "bValidateBudgets"))
+		int32 MaxActiveStates;
+
+	/* Upper bound of transitions that one input event can cause */
+	UPROPERTY(config, EditAnywhere, Category = "Validation", meta = (ClampMin = "1", EditCondition = "bValidateBudgets"))
+		int32 MaxTransitionsPerEvent;
+
+	/* Upper bound of estimated evaluation cost of asset per frame, in microseconds */
+	UPROPERTY(config, EditAnywhere, Category = "Validation", meta = (ClampMin = "0", EditCondition = "bValidateBudgets"))
+		float MaxFrameCostMicroseconds;
+
+	/* Cost of one action test used for frame cost estimation, measure it on target hardware with InputSequenceBenchmark commandlet */
+	UPROPERTY(config, EditAnywhere, Category = "Validation", meta = (ClampMin = "0"))
+		float NanosecondsPerActionTest;
+
+	/* If checked, nodes not reached from Start node fail validation, otherwise they are warnings */
+	UPROPERTY(config, EditAnywhere, Category = "Validation", meta = (EditCondition = "bValidateBudgets"))
+		bool bUnreachableNodesAreErrors;
+
+	/* If checked, ambiguous branches fail validation, otherwise they are warnings */
+	UPROPERTY(config, EditAnywhere, Category = "Validation", meta = (EditCondition = "bValidateBudgets"))
+		bool bAmbiguitiesAreErrors;
+};
\ No newline at end of file
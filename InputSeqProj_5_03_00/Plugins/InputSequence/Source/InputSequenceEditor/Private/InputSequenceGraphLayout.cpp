@@ -0,0 +1,314 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceGraphLayout.h"
+#include "InputSequenceAsset.h"
+#include "Graph/InputSequenceGraph.h"
+#include "Graph/InputSequenceGraphSchema.h"
+#include "Graph/InputSequenceGraphNode_Hub.h"
+#include "Settings/EditorStyleSettings.h"
+
+namespace
+{
+	const float LayerSpacing = 80;
+
+	const float NodeSpacing = 24;
+
+	/* Long links pass layers through dummy nodes, so they take part in ordering and get their own lanes */
+	const FVector2D DummyNodeSize(0, 16);
+
+	const int32 MaxSweeps = 24;
+
+	/* Sweeps without improvement of crossings before ordering stops */
+	const int32 MaxIdleSweeps = 4;
+
+	struct FLayoutNode
+	{
+		/* Nullptr for dummy node */
+		UEdGraphNode* Node = nullptr;
+
+		int32 Layer = INDEX_NONE;
+
+		FVector2D Size = FVector2D::ZeroVector;
+
+		FVector2D Position = FVector2D::ZeroVector;
+
+		// Neighbours in adjacent layers only
+		TArray<int32> Preds;
+		TArray<int32> Succs;
+
+		double Barycenter = 0;
+	};
+
+	/* Unlike GetNextNodes, hubs are not jumped through */
+	void GetLinkedNodes(UEdGraphNode* node, TArray<UEdGraphNode*>& outLinkedNodes)
+	{
+		for (UEdGraphPin* pin : node->Pins)
+		{
+			if (pin && pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Exec && pin->Direction == EGPD_Output)
+			{
+				for (UEdGraphPin* linkedPin : pin->LinkedTo)
+				{
+					if (linkedPin && linkedPin->GetOwningNode()) outLinkedNodes.AddUnique(linkedPin->GetOwningNode());
+				}
+			}
+		}
+	}
+
+	/* Crossings between two adjacent layers are inversions of link ends in lower layer once links are sorted by upper ends */
+	int64 CountCrossings(const TArray<FLayoutNode>& nodes, const TArray<int32>& upperLayer, int32 numLowerNodes, const TArray<int32>& positions, TArray<TPair<int32, int32>>& links, TArray<int32>& tree)
+	{
+		links.Reset();
+
+		for (const int32 upperIndex : upperLayer)
+		{
+			for (const int32 lowerIndex : nodes[upperIndex].Succs) links.Emplace(positions[upperIndex], positions[lowerIndex]);
+		}
+
+		links.Sort();
+
+		tree.Reset();
+		tree.SetNumZeroed(numLowerNodes + 1);
+
+		int64 crossings = 0;
+
+		for (int32 i = 0; i < links.Num(); i++)
+		{
+			// Links added before with lower end at or before this one do not cross it
+
+			int32 numNotCrossing = 0;
+			for (int32 j = links[i].Value + 1; j > 0; j -= j & -j) numNotCrossing += tree[j];
+
+			crossings += i - numNotCrossing;
+
+			for (int32 j = links[i].Value + 1; j <= numLowerNodes; j += j & -j) tree[j]++;
+		}
+
+		return crossings;
+	}
+}
+
+void FInputSequenceGraphLayout::Arrange(UInputSequenceGraph* graph, TFunctionRef<FVector2D(const UEdGraphNode*)> getNodeSize)
+{
+	if (!graph || graph->Nodes.Num() == 0) return;
+
+	TArray<FInputSequenceState> states;
+	TArray<UEdGraphNode*> stateNodes;
+	graph->CompileStates(states, &stateNodes);
+
+	TArray<FLayoutNode> nodes;
+	TMap<UEdGraphNode*, int32> nodeIndice;
+
+	// Node is compiled into state per First Layer parent and pressed actions, it is placed by the shallowest one.
+	// States come in breadth-first order, so first state of node is the shallowest. Layers are doubled to leave room for hubs
+
+	for (int32 i = 0; i < states.Num(); i++)
+	{
+		if (!stateNodes[i] || nodeIndice.Contains(stateNodes[i])) continue;
+
+		nodeIndice.Add(stateNodes[i], nodes.Num());
+
+		FLayoutNode& node = nodes.AddDefaulted_GetRef();
+		node.Node = stateNodes[i];
+		node.Layer = states[i].DepthIndex * 2;
+	}
+
+	if (nodes.Num() == 0) return;
+
+	// Hubs are not compiled, they are placed one layer after node that first reaches them. Nodes array grows with hubs, so hubs are walked as well
+
+	TArray<TPair<int32, int32>> links;
+	TArray<UEdGraphNode*> linkedNodes;
+
+	for (int32 i = 0; i < nodes.Num(); i++)
+	{
+		linkedNodes.Reset();
+		GetLinkedNodes(nodes[i].Node, linkedNodes);
+
+		for (UEdGraphNode* linkedNode : linkedNodes)
+		{
+			int32 linkedIndex = INDEX_NONE;
+
+			if (const int32* foundIndex = nodeIndice.Find(linkedNode))
+			{
+				linkedIndex = *foundIndex;
+			}
+			else if (linkedNode->IsA<UInputSequenceGraphNode_Hub>())
+			{
+				linkedIndex = nodes.Num();
+				nodeIndice.Add(linkedNode, linkedIndex);
+
+				FLayoutNode& hubNode = nodes.AddDefaulted_GetRef();
+				hubNode.Node = linkedNode;
+				hubNode.Layer = nodes[i].Layer + 1;
+			}
+
+			if (linkedIndex != INDEX_NONE) links.Emplace(i, linkedIndex);
+		}
+	}
+
+	// Layers are compacted, as most nodes are not followed by hubs
+
+	TArray<int32> usedLayers;
+	for (const FLayoutNode& node : nodes) usedLayers.AddUnique(node.Layer);
+	usedLayers.Sort();
+
+	TArray<int32> layerMap;
+	layerMap.Init(INDEX_NONE, usedLayers.Last() + 1);
+	for (int32 i = 0; i < usedLayers.Num(); i++) layerMap[usedLayers[i]] = i;
+
+	const int32 numRealNodes = nodes.Num();
+
+	for (int32 i = 0; i < numRealNodes; i++)
+	{
+		nodes[i].Layer = layerMap[nodes[i].Layer];
+		nodes[i].Size = getNodeSize(nodes[i].Node);
+	}
+
+	// Links back to earlier layers and within layer do not take part in ordering, long links are split by dummy nodes
+
+	for (const TPair<int32, int32>& link : links)
+	{
+		int32 fromIndex = link.Key;
+		const int32 toIndex = link.Value;
+
+		if (nodes[toIndex].Layer <= nodes[fromIndex].Layer) continue;
+
+		for (int32 layer = nodes[fromIndex].Layer + 1; layer < nodes[toIndex].Layer; layer++)
+		{
+			const int32 dummyIndex = nodes.Num();
+
+			FLayoutNode& dummyNode = nodes.AddDefaulted_GetRef();
+			dummyNode.Layer = layer;
+			dummyNode.Size = DummyNodeSize;
+
+			nodes[fromIndex].Succs.Add(dummyIndex);
+			dummyNode.Preds.Add(fromIndex);
+
+			fromIndex = dummyIndex;
+		}
+
+		nodes[fromIndex].Succs.Add(toIndex);
+		nodes[toIndex].Preds.Add(fromIndex);
+	}
+
+	// Initial order is order nodes are reached in
+
+	TArray<TArray<int32>> layers;
+	layers.SetNum(usedLayers.Num());
+
+	TArray<int32> positions;
+	positions.SetNum(nodes.Num());
+
+	for (int32 i = 0; i < nodes.Num(); i++)
+	{
+		positions[i] = layers[nodes[i].Layer].Add(i);
+	}
+
+	// Crossings are reduced by barycenter heuristic, sweeping down by predecessors and up by successors. Best order found is kept
+
+	TArray<int32> tree;
+	TArray<TPair<int32, int32>> crossingLinks;
+
+	auto countAllCrossings = [&]()
+	{
+		int64 crossings = 0;
+		for (int32 layer = 0; layer + 1 < layers.Num(); layer++) crossings += CountCrossings(nodes, layers[layer], layers[layer + 1].Num(), positions, crossingLinks, tree);
+
+		return crossings;
+	};
+
+	auto orderLayer = [&](TArray<int32>& layer, bool bByPreds)
+	{
+		for (const int32 index : layer)
+		{
+			const TArray<int32>& neighbours = bByPreds ? nodes[index].Preds : nodes[index].Succs;
+
+			double sum = 0;
+			for (const int32 neighbourIndex : neighbours) sum += positions[neighbourIndex];
+
+			// Nodes without neighbours keep their place
+			nodes[index].Barycenter = neighbours.Num() > 0 ? sum / neighbours.Num() : positions[index];
+		}
+
+		layer.StableSort([&](const int32 a, const int32 b) { return nodes[a].Barycenter < nodes[b].Barycenter; });
+
+		for (int32 i = 0; i < layer.Num(); i++) positions[layer[i]] = i;
+	};
+
+	int64 bestCrossings = countAllCrossings();
+	TArray<TArray<int32>> bestLayers = layers;
+
+	for (int32 sweep = 0, idleSweeps = 0; sweep < MaxSweeps && bestCrossings > 0 && idleSweeps < MaxIdleSweeps; sweep++)
+	{
+		if (sweep % 2 == 0)
+		{
+			for (int32 layer = 1; layer < layers.Num(); layer++) orderLayer(layers[layer], true);
+		}
+		else
+		{
+			for (int32 layer = layers.Num() - 2; layer >= 0; layer--) orderLayer(layers[layer], false);
+		}
+
+		const int64 crossings = countAllCrossings();
+
+		if (crossings < bestCrossings)
+		{
+			bestCrossings = crossings;
+			bestLayers = layers;
+			idleSweeps = 0;
+		}
+		else
+		{
+			idleSweeps++;
+		}
+	}
+
+	// Columns are as wide as their widest node. Node is aligned with its predecessors where it does not overlap nodes above it
+
+	float layerX = 0;
+
+	for (const TArray<int32>& layer : bestLayers)
+	{
+		float layerWidth = 0;
+		float prevBottom = -NodeSpacing;
+
+		for (const int32 index : layer)
+		{
+			FLayoutNode& node = nodes[index];
+
+			float top = prevBottom + NodeSpacing;
+
+			if (node.Preds.Num() > 0)
+			{
+				float predsCenter = 0;
+				for (const int32 predIndex : node.Preds) predsCenter += nodes[predIndex].Position.Y + nodes[predIndex].Size.Y / 2;
+
+				top = FMath::Max(top, predsCenter / node.Preds.Num() - node.Size.Y / 2);
+			}
+
+			node.Position = FVector2D(layerX, top);
+
+			prevBottom = top + node.Size.Y;
+			layerWidth = FMath::Max(layerWidth, node.Size.X);
+		}
+
+		layerX += layerWidth + LayerSpacing;
+	}
+
+	// Start node is the first one, graph is moved so it stays in place
+
+	const FVector2D offset = FVector2D(nodes[0].Node->NodePosX, nodes[0].Node->NodePosY) - nodes[0].Position;
+
+	const uint32 gridSnapSize = GetDefault<UEditorStyleSettings>()->GridSnapSize;
+
+	for (int32 i = 0; i < numRealNodes; i++)
+	{
+		UEdGraphNode* node = nodes[i].Node;
+
+		node->Modify();
+
+		node->NodePosX = FMath::RoundToInt(nodes[i].Position.X + offset.X);
+		node->NodePosY = FMath::RoundToInt(nodes[i].Position.Y + offset.Y);
+		node->SnapToGrid(gridSnapSize);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UInputSequenceGraph;
+class UEdGraphNode;
+
+class FInputSequenceGraphLayout
+{
+public:
+
+	/* Layered layout: nodes reached from Start node are placed in columns by DepthIndex of their states and ordered within columns to reduce crossing links.
+	Hubs get columns between nodes they join. Start node keeps its position, unreachable nodes and comments are not moved */
+	static void Arrange(UInputSequenceGraph* graph, TFunctionRef<FVector2D(const UEdGraphNode*)> getNodeSize);
+};
\ No newline at end of file
@@ -0,0 +1,524 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceGraphText.h"
+#include "InputSequenceAsset.h"
+#include "InputSequenceCompiler.h"
+#include "InputSequenceGraphLayout.h"
+#include "Graph/InputSequenceGraph.h"
+#include "Graph/InputSequenceGraphSchema.h"
+#include "Graph/InputSequenceGraphNode_Axis.h"
+#include "Graph/InputSequenceGraphNode_Gesture.h"
+#include "Graph/InputSequenceGraphNode_GoToStart.h"
+#include "Graph/InputSequenceGraphNode_Hub.h"
+#include "Graph/InputSequenceGraphNode_Press.h"
+#include "Graph/InputSequenceGraphNode_Release.h"
+#include "Graph/InputSequenceGraphNode_Start.h"
+#include "Dom/JsonObject.h"
+#include "JsonObjectConverter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	struct FNodeType
+	{
+		const TCHAR* Name;
+
+		UClass* (*GetClass)();
+	};
+
+	// Derived classes go first, so node is matched by its most derived type
+	const FNodeType NodeTypes[] =
+	{
+		{ TEXT("Start"), &UInputSequenceGraphNode_Start::StaticClass },
+		{ TEXT("Press"), &UInputSequenceGraphNode_Press::StaticClass },
+		{ TEXT("Release"), &UInputSequenceGraphNode_Release::StaticClass },
+		{ TEXT("Gesture"), &UInputSequenceGraphNode_Gesture::StaticClass },
+		{ TEXT("Axis"), &UInputSequenceGraphNode_Axis::StaticClass },
+		{ TEXT("Hub"), &UInputSequenceGraphNode_Hub::StaticClass },
+		{ TEXT("GoToStart"), &UInputSequenceGraphNode_GoToStart::StaticClass },
+	};
+
+	struct FPinCategory
+	{
+		const TCHAR* Name;
+
+		const FName& Category;
+	};
+
+	const FPinCategory PinCategories[] =
+	{
+		{ TEXT("Exec"), UInputSequenceGraphSchema::PC_Exec },
+		{ TEXT("Action"), UInputSequenceGraphSchema::PC_Action },
+		{ TEXT("Axis"), UInputSequenceGraphSchema::PC_Axis },
+		{ TEXT("2DAxis"), UInputSequenceGraphSchema::PC_2DAxis },
+		{ TEXT("AxisRegion"), UInputSequenceGraphSchema::PC_AxisRegion },
+	};
+
+	const TCHAR* GetNodeTypeName(const UEdGraphNode* node)
+	{
+		for (const FNodeType& nodeType : NodeTypes)
+		{
+			if (node->IsA(nodeType.GetClass())) return nodeType.Name;
+		}
+
+		return nullptr;
+	}
+
+	UClass* FindNodeClass(const FName& typeName)
+	{
+		for (const FNodeType& nodeType : NodeTypes)
+		{
+			if (typeName == nodeType.Name) return nodeType.GetClass();
+		}
+
+		return nullptr;
+	}
+
+	const TCHAR* GetPinCategoryName(const FName& category)
+	{
+		for (const FPinCategory& pinCategory : PinCategories)
+		{
+			if (category == pinCategory.Category) return pinCategory.Name;
+		}
+
+		return nullptr;
+	}
+
+	FName FindPinCategory(const FString& categoryName)
+	{
+		for (const FPinCategory& pinCategory : PinCategories)
+		{
+			if (categoryName == pinCategory.Name) return pinCategory.Category;
+		}
+
+		return NAME_None;
+	}
+
+	/* Default pins of node types are not written, except Hub exec outputs, which are added by user */
+	bool IsExportedPin(const UEdGraphNode* node, const UEdGraphPin* pin)
+	{
+		if (pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Exec) return pin->Direction == EGPD_Output && node->IsA<UInputSequenceGraphNode_Hub>();
+
+		return GetPinCategoryName(pin->PinType.PinCategory) != nullptr;
+	}
+
+	void WriteLine(const TSharedRef<FJsonObject>& jsonObject, FString& outText)
+	{
+		FString line;
+
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&line);
+		FJsonSerializer::Serialize(jsonObject, writer);
+
+		outText += line;
+		outText += TEXT('\n');
+	}
+
+	bool ParseNode(const FJsonObject& jsonObject, FInputSequenceGraphDocument::FNode& outNode, FString& outError)
+	{
+		outNode.Id = jsonObject.GetStringField(TEXT("node"));
+
+		FString typeName;
+		if (!jsonObject.TryGetStringField(TEXT("type"), typeName) || !FindNodeClass(FName(*typeName)))
+		{
+			outError = FString::Printf(TEXT("unknown type \"%s\" of node %s"), *typeName, *outNode.Id);
+			return false;
+		}
+
+		outNode.Type = FName(*typeName);
+
+		outNode.bHasPosition = jsonObject.TryGetNumberField(TEXT("x"), outNode.PosX) && jsonObject.TryGetNumberField(TEXT("y"), outNode.PosY);
+
+		const TArray<TSharedPtr<FJsonValue>>* pinValues = nullptr;
+		if (jsonObject.TryGetArrayField(TEXT("pins"), pinValues))
+		{
+			outNode.Pins.Reserve(pinValues->Num());
+
+			for (const TSharedPtr<FJsonValue>& pinValue : *pinValues)
+			{
+				const TSharedPtr<FJsonObject>* pinObject = nullptr;
+				if (!pinValue.IsValid() || !pinValue->TryGetObject(pinObject))
+				{
+					outError = FString::Printf(TEXT("pin of node %s is not an object"), *outNode.Id);
+					return false;
+				}
+
+				FInputSequenceGraphDocument::FPin& pin = outNode.Pins.AddDefaulted_GetRef();
+
+				FString pinName;
+				(*pinObject)->TryGetStringField(TEXT("name"), pinName);
+				pin.Name = pinName.IsEmpty() ? NAME_None : FName(*pinName);
+
+				FString categoryName;
+				(*pinObject)->TryGetStringField(TEXT("category"), categoryName);
+				pin.Category = FindPinCategory(categoryName);
+
+				if (pin.Category.IsNone())
+				{
+					outError = FString::Printf(TEXT("unknown category \"%s\" of pin %s of node %s"), *categoryName, *pinName, *outNode.Id);
+					return false;
+				}
+
+				FString direction;
+				pin.Direction = (*pinObject)->TryGetStringField(TEXT("dir"), direction) && direction == TEXT("in") ? EGPD_Input : EGPD_Output;
+
+				(*pinObject)->TryGetStringField(TEXT("default"), pin.DefaultValue);
+				(*pinObject)->TryGetStringField(TEXT("action"), pin.InputAction);
+			}
+		}
+
+		const TSharedPtr<FJsonObject>* properties = nullptr;
+		if (jsonObject.TryGetObjectField(TEXT("properties"), properties)) outNode.Properties = *properties;
+
+		return true;
+	}
+
+	bool ParseLink(const FJsonObject& jsonObject, FInputSequenceGraphDocument::FLink& outLink, FString& outError)
+	{
+		if (!jsonObject.TryGetStringField(TEXT("to"), outLink.ToNode))
+		{
+			outError = TEXT("link has no \"to\" node");
+			return false;
+		}
+
+		outLink.FromNode = jsonObject.GetStringField(TEXT("from"));
+
+		FString pinName;
+		outLink.FromPin = jsonObject.TryGetStringField(TEXT("fromPin"), pinName) && !pinName.IsEmpty() ? FName(*pinName) : NAME_None;
+		outLink.ToPin = jsonObject.TryGetStringField(TEXT("toPin"), pinName) && !pinName.IsEmpty() ? FName(*pinName) : NAME_None;
+
+		return true;
+	}
+}
+
+void FInputSequenceGraphText::Export(const UInputSequenceAsset* asset, FString& outText)
+{
+	const UEdGraph* graph = asset ? asset->EdGraph : nullptr;
+
+	if (!graph) return;
+
+	TMap<const UEdGraphNode*, FString> nodeIds;
+	nodeIds.Reserve(graph->Nodes.Num());
+
+	for (const UEdGraphNode* node : graph->Nodes)
+	{
+		// Comments and unknown nodes are not written
+		const TCHAR* typeName = node ? GetNodeTypeName(node) : nullptr;
+
+		if (!typeName) continue;
+
+		const FString& nodeId = nodeIds.Add(node, FString::Printf(TEXT("N%d"), nodeIds.Num()));
+
+		TSharedRef<FJsonObject> nodeObject = MakeShared<FJsonObject>();
+		nodeObject->SetStringField(TEXT("node"), nodeId);
+		nodeObject->SetStringField(TEXT("type"), typeName);
+		nodeObject->SetNumberField(TEXT("x"), node->NodePosX);
+		nodeObject->SetNumberField(TEXT("y"), node->NodePosY);
+
+		const UInputSequenceGraphNode_Input* inputNode = Cast<UInputSequenceGraphNode_Input>(node);
+
+		TArray<TSharedPtr<FJsonValue>> pinValues;
+
+		for (const UEdGraphPin* pin : node->Pins)
+		{
+			if (!pin || !IsExportedPin(node, pin)) continue;
+
+			TSharedRef<FJsonObject> pinObject = MakeShared<FJsonObject>();
+
+			if (!pin->PinName.IsNone()) pinObject->SetStringField(TEXT("name"), pin->PinName.ToString());
+			pinObject->SetStringField(TEXT("category"), GetPinCategoryName(pin->PinType.PinCategory));
+
+			if (pin->Direction == EGPD_Input) pinObject->SetStringField(TEXT("dir"), TEXT("in"));
+			if (!pin->DefaultValue.IsEmpty()) pinObject->SetStringField(TEXT("default"), pin->DefaultValue);
+
+			if (inputNode)
+			{
+				if (const TObjectPtr<UObject>* inputAction = inputNode->GetPinsInputActions().Find(pin->PinName))
+				{
+					if (*inputAction) pinObject->SetStringField(TEXT("action"), (*inputAction)->GetPathName());
+				}
+			}
+
+			pinValues.Add(MakeShared<FJsonValueObject>(pinObject));
+		}
+
+		if (pinValues.Num() > 0) nodeObject->SetArrayField(TEXT("pins"), pinValues);
+
+		TSharedRef<FJsonObject> properties = MakeShared<FJsonObject>();
+		if (FJsonObjectConverter::UStructToJsonObject(node->GetClass(), node, properties, CPF_Edit, CPF_Transient) && properties->Values.Num() > 0)
+		{
+			nodeObject->SetObjectField(TEXT("properties"), properties);
+		}
+
+		WriteLine(nodeObject, outText);
+	}
+
+	// Links are written from output pins only, so each link is written once
+
+	for (const TPair<const UEdGraphNode*, FString>& nodeId : nodeIds)
+	{
+		for (const UEdGraphPin* pin : nodeId.Key->Pins)
+		{
+			if (!pin || pin->Direction != EGPD_Output) continue;
+
+			for (const UEdGraphPin* linkedPin : pin->LinkedTo)
+			{
+				const FString* linkedNodeId = linkedPin ? nodeIds.Find(linkedPin->GetOwningNode()) : nullptr;
+
+				if (!linkedNodeId) continue;
+
+				TSharedRef<FJsonObject> linkObject = MakeShared<FJsonObject>();
+				linkObject->SetStringField(TEXT("from"), nodeId.Value);
+				if (!pin->PinName.IsNone()) linkObject->SetStringField(TEXT("fromPin"), pin->PinName.ToString());
+				linkObject->SetStringField(TEXT("to"), *linkedNodeId);
+				if (!linkedPin->PinName.IsNone()) linkObject->SetStringField(TEXT("toPin"), linkedPin->PinName.ToString());
+
+				WriteLine(linkObject, outText);
+			}
+		}
+	}
+}
+
+bool FInputSequenceGraphText::Parse(const FString& text, FInputSequenceGraphDocument& outDocument, FString& outError)
+{
+	outDocument = FInputSequenceGraphDocument();
+
+	int32 lineNumber = 0;
+
+	for (int32 lineStart = 0; lineStart < text.Len();)
+	{
+		int32 lineEnd = text.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, lineStart);
+		if (lineEnd == INDEX_NONE) lineEnd = text.Len();
+
+		const FStringView line = FStringView(*text + lineStart, lineEnd - lineStart).TrimStartAndEnd();
+
+		lineStart = lineEnd + 1;
+		lineNumber++;
+
+		if (line.IsEmpty() || line[0] == TEXT('#')) continue;
+
+		TSharedPtr<FJsonObject> jsonObject;
+
+		TSharedRef<TJsonReader<TCHAR>> reader = TJsonReaderFactory<TCHAR>::Create(FString(line));
+		if (!FJsonSerializer::Deserialize(reader, jsonObject) || !jsonObject.IsValid())
+		{
+			outError = FString::Printf(TEXT("Line %d: %s"), lineNumber, *reader->GetErrorMessage());
+			return false;
+		}
+
+		FString lineError;
+
+		if (jsonObject->HasField(TEXT("node")))
+		{
+			FInputSequenceGraphDocument::FNode& node = outDocument.Nodes.AddDefaulted_GetRef();
+			node.LineNumber = lineNumber;
+
+			if (!ParseNode(*jsonObject, node, lineError))
+			{
+				outError = FString::Printf(TEXT("Line %d: %s"), lineNumber, *lineError);
+				return false;
+			}
+		}
+		else if (jsonObject->HasField(TEXT("from")))
+		{
+			FInputSequenceGraphDocument::FLink& link = outDocument.Links.AddDefaulted_GetRef();
+			link.LineNumber = lineNumber;
+
+			if (!ParseLink(*jsonObject, link, lineError))
+			{
+				outError = FString::Printf(TEXT("Line %d: %s"), lineNumber, *lineError);
+				return false;
+			}
+		}
+		else
+		{
+			outError = FString::Printf(TEXT("Line %d: neither node nor link"), lineNumber);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FInputSequenceGraphText::Import(UInputSequenceAsset* asset, const FInputSequenceGraphDocument& document, FString& outError)
+{
+	if (!asset) return false;
+
+	// Nodes are built in transient package and moved into graph only when whole document is valid, so failed import leaves no objects under asset
+
+	TArray<TObjectPtr<UEdGraphNode>> graphNodes;
+	graphNodes.Reserve(document.Nodes.Num() + 1);
+
+	TMap<FString, UEdGraphNode*> nodes;
+	nodes.Reserve(document.Nodes.Num());
+
+	UEdGraphNode* startNode = nullptr;
+
+	bool bAllNodesPlaced = true;
+
+	for (const FInputSequenceGraphDocument::FNode& documentNode : document.Nodes)
+	{
+		if (nodes.Contains(documentNode.Id))
+		{
+			outError = FString::Printf(TEXT("Line %d: node %s is declared twice"), documentNode.LineNumber, *documentNode.Id);
+			return false;
+		}
+
+		UClass* nodeClass = FindNodeClass(documentNode.Type);
+
+		const bool bIsStartNode = nodeClass == UInputSequenceGraphNode_Start::StaticClass();
+
+		if (bIsStartNode && startNode)
+		{
+			outError = FString::Printf(TEXT("Line %d: graph has one Start node only"), documentNode.LineNumber);
+			return false;
+		}
+
+		UEdGraphNode* node = NewObject<UEdGraphNode>(GetTransientPackage(), nodeClass, NAME_None, RF_Transactional);
+
+		// Compilation starts from the first node, so it is Start node
+		if (bIsStartNode)
+		{
+			graphNodes.Insert(node, 0);
+			startNode = node;
+		}
+		else
+		{
+			graphNodes.Add(node);
+		}
+
+		node->CreateNewGuid();
+		node->PostPlacedNewNode();
+		node->AllocateDefaultPins();
+
+		node->NodePosX = documentNode.PosX;
+		node->NodePosY = documentNode.PosY;
+
+		bAllNodesPlaced &= documentNode.bHasPosition;
+
+		if (documentNode.Properties.IsValid() && !FJsonObjectConverter::JsonObjectToUStruct(documentNode.Properties.ToSharedRef(), nodeClass, node, CPF_Edit, CPF_Transient))
+		{
+			outError = FString::Printf(TEXT("Line %d: properties of node %s do not match its type"), documentNode.LineNumber, *documentNode.Id);
+			return false;
+		}
+
+		// Added pins go before Add pin, as if they were added by user
+
+		const int32 addPinIndex = node->Pins.IndexOfByPredicate([](const UEdGraphPin* pin)
+			{
+				return pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_Add || pin->PinType.PinCategory == UInputSequenceGraphSchema::PC_HubAdd;
+			});
+
+		int32 numAddedPins = 0;
+
+		for (const FInputSequenceGraphDocument::FPin& documentPin : documentNode.Pins)
+		{
+			UEdGraphPin* pin = node->FindPin(documentPin.Name, documentPin.Direction);
+
+			if (!pin)
+			{
+				UEdGraphNode::FCreatePinParams params;
+				params.Index = addPinIndex == INDEX_NONE ? INDEX_NONE : addPinIndex + numAddedPins++;
+
+				pin = node->CreatePin(documentPin.Direction, documentPin.Category, documentPin.Name, params);
+			}
+
+			pin->DefaultValue = documentPin.DefaultValue;
+
+			if (!documentPin.InputAction.IsEmpty())
+			{
+				if (UInputSequenceGraphNode_Input* inputNode = Cast<UInputSequenceGraphNode_Input>(node))
+				{
+					if (UObject* inputAction = FSoftObjectPath(documentPin.InputAction).TryLoad())
+					{
+						inputNode->GetPinsInputActions().Add(documentPin.Name, inputAction);
+					}
+					else
+					{
+						outError = FString::Printf(TEXT("Line %d: Input Action %s of pin %s is not found"), documentNode.LineNumber, *documentPin.InputAction, *documentPin.Name.ToString());
+						return false;
+					}
+				}
+			}
+		}
+
+		nodes.Add(documentNode.Id, node);
+	}
+
+	if (!startNode)
+	{
+		startNode = NewObject<UInputSequenceGraphNode_Start>(GetTransientPackage(), NAME_None, RF_Transactional);
+		graphNodes.Insert(startNode, 0);
+
+		startNode->CreateNewGuid();
+		startNode->PostPlacedNewNode();
+		startNode->AllocateDefaultPins();
+	}
+
+	for (const FInputSequenceGraphDocument::FLink& link : document.Links)
+	{
+		UEdGraphNode* const* fromNode = nodes.Find(link.FromNode);
+		UEdGraphNode* const* toNode = nodes.Find(link.ToNode);
+
+		UEdGraphPin* fromPin = fromNode ? (*fromNode)->FindPin(link.FromPin, EGPD_Output) : nullptr;
+		UEdGraphPin* toPin = toNode ? (*toNode)->FindPin(link.ToPin, EGPD_Input) : nullptr;
+
+		if (!fromPin || !toPin)
+		{
+			outError = FString::Printf(TEXT("Line %d: link %s.%s -> %s.%s does not match nodes or their pins"), link.LineNumber, *link.FromNode, *link.FromPin.ToString(), *link.ToNode, *link.ToPin.ToString());
+			return false;
+		}
+
+		fromPin->MakeLinkTo(toPin);
+	}
+
+	asset->Modify();
+
+	UInputSequenceGraph* graph = Cast<UInputSequenceGraph>(asset->EdGraph);
+
+	if (!graph)
+	{
+		graph = NewObject<UInputSequenceGraph>(asset, NAME_None, RF_Transactional);
+		asset->EdGraph = graph;
+	}
+
+	graph->Modify();
+
+	// Old nodes are removed as editor deletes them, so they are unlinked and restored by undo
+
+	const TArray<TObjectPtr<UEdGraphNode>> oldNodes = graph->Nodes;
+
+	for (UEdGraphNode* oldNode : oldNodes)
+	{
+		if (!oldNode) continue;
+
+		oldNode->Modify();
+		graph->RemoveNode(oldNode);
+	}
+
+	graph->Nodes.Reset();
+
+	// Nodes are set to array directly instead of AddNode, which notifies graph editor per node
+
+	for (UEdGraphNode* node : graphNodes)
+	{
+		node->Rename(nullptr, graph, REN_DontCreateRedirectors);
+	}
+
+	graph->Nodes = MoveTemp(graphNodes);
+
+	if (!bAllNodesPlaced)
+	{
+		FInputSequenceGraphLayout::Arrange(graph, [](const UEdGraphNode* node) { return FVector2D(200, 100); });
+	}
+
+	graph->MarkAllNodesDirty();
+	graph->NotifyGraphChanged();
+
+	FInputSequenceCompiler::Compile(asset, false);
+
+	asset->MarkPackageDirty();
+
+	return true;
+}
\ No newline at end of file
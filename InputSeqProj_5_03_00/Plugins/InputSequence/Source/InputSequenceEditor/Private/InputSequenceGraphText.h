@@ -0,0 +1,84 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+
+class UInputSequenceAsset;
+class FJsonObject;
+
+/* Graph described by text, made without UObjects, so files can be parsed off game thread */
+struct FInputSequenceGraphDocument
+{
+	struct FPin
+	{
+		FName Name;
+
+		FName Category;
+
+		EEdGraphPinDirection Direction = EGPD_Output;
+
+		/* Range of Axis pin, sector of 2D Axis pin or region of Axis Region pin, in pin default value format */
+		FString DefaultValue;
+
+		/* Object path of Input Action of pin, empty if there is none */
+		FString InputAction;
+	};
+
+	struct FNode
+	{
+		FString Id;
+
+		/* Start, Press, Release, Axis, Gesture, Hub or GoToStart */
+		FName Type;
+
+		bool bHasPosition = false;
+
+		int32 PosX = 0;
+		int32 PosY = 0;
+
+		/* Pins added to default pins of node type */
+		TArray<FPin> Pins;
+
+		/* Editable properties of node, by property names */
+		TSharedPtr<FJsonObject> Properties;
+
+		int32 LineNumber = 0;
+	};
+
+	struct FLink
+	{
+		FString FromNode;
+		FName FromPin;
+
+		FString ToNode;
+		FName ToPin;
+
+		int32 LineNumber = 0;
+	};
+
+	TArray<FNode> Nodes;
+
+	TArray<FLink> Links;
+};
+
+/* Text format of graphs, one JSON object per line:
+ * {"node":"N1","type":"Press","x":300,"y":0,"pins":[{"name":"Jump","category":"Action","action":"/Game/Input/IA_Jump.IA_Jump"}],"properties":{"isOverridingResetAfterTime":true}}
+ * {"from":"N0","to":"N1"}
+ * Links may name pins with "fromPin" and "toPin", exec pins have no names. Empty lines and lines starting with # are skipped.
+ * If any node has no position, imported graph is arranged by FInputSequenceGraphLayout.
+ */
+class FInputSequenceGraphText
+{
+public:
+
+	/* Writes nodes first and links after them */
+	static void Export(const UInputSequenceAsset* asset, FString& outText);
+
+	/* Reads text line by line, can run on any thread */
+	static bool Parse(const FString& text, FInputSequenceGraphDocument& outDocument, FString& outError);
+
+	/* Replaces graph of asset with nodes of document and compiles it once, graph is left as is if document is invalid. Nodes are not transacted one by one and graph is notified once, so cost is linear in size of document. Game thread only */
+	static bool Import(UInputSequenceAsset* asset, const FInputSequenceGraphDocument& document, FString& outError);
+};
\ No newline at end of file
@@ -0,0 +1,145 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceInputActionIndex.h"
+#include "InputSequence.h"
+#include "InputAction.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+namespace
+{
+	TUniquePtr<FInputSequenceInputActionIndex> InputActionIndex;
+}
+
+FInputSequenceInputActionIndex& FInputSequenceInputActionIndex::Get()
+{
+	if (!InputActionIndex.IsValid()) InputActionIndex = MakeUnique<FInputSequenceInputActionIndex>();
+
+	return *InputActionIndex;
+}
+
+void FInputSequenceInputActionIndex::Shutdown()
+{
+	InputActionIndex.Reset();
+}
+
+FInputSequenceInputActionIndex::~FInputSequenceInputActionIndex()
+{
+	if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+	{
+		IAssetRegistry& assetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		assetRegistry.OnAssetAdded().Remove(OnAssetAddedHandle);
+		assetRegistry.OnAssetRemoved().Remove(OnAssetRemovedHandle);
+		assetRegistry.OnAssetRenamed().Remove(OnAssetRenamedHandle);
+		assetRegistry.OnAssetUpdated().Remove(OnAssetUpdatedHandle);
+	}
+
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnObjectPropertyChangedHandle);
+}
+
+void FInputSequenceInputActionIndex::GetEntries(TArray<FEntry>& outEntries, TFunctionRef<bool(EInputActionValueType)> valueTypeFilter)
+{
+	Build();
+
+	for (const TPair<FSoftObjectPath, FEntry>& entry : Entries)
+	{
+		if (valueTypeFilter(entry.Value.ValueType)) outEntries.Add(entry.Value);
+	}
+
+	// Registry order is not stable, menus are
+	outEntries.Sort([](const FEntry& lhs, const FEntry& rhs) { return lhs.Name.LexicalLess(rhs.Name); });
+}
+
+void FInputSequenceInputActionIndex::Build()
+{
+	if (bIsBuilt) return;
+
+	bIsBuilt = true;
+
+	IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FARFilter filter;
+	filter.ClassPaths.Add(UInputAction::StaticClass()->GetClassPathName());
+	filter.bRecursiveClasses = true;
+	filter.bRecursivePaths = true;
+
+	TArray<FAssetData> assetList;
+	assetRegistry.GetAssets(filter, assetList);
+
+	for (const FAssetData& assetData : assetList)
+	{
+		AddOrUpdate(assetData);
+	}
+
+	OnAssetAddedHandle = assetRegistry.OnAssetAdded().AddRaw(this, &FInputSequenceInputActionIndex::OnAssetAdded);
+	OnAssetRemovedHandle = assetRegistry.OnAssetRemoved().AddRaw(this, &FInputSequenceInputActionIndex::OnAssetRemoved);
+	OnAssetRenamedHandle = assetRegistry.OnAssetRenamed().AddRaw(this, &FInputSequenceInputActionIndex::OnAssetRenamed);
+	OnAssetUpdatedHandle = assetRegistry.OnAssetUpdated().AddRaw(this, &FInputSequenceInputActionIndex::OnAssetAdded);
+
+	// Tags are updated only on save, while edited Input Action is loaded anyway
+	OnObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FInputSequenceInputActionIndex::OnObjectPropertyChanged);
+
+	UE_LOG(LogInputSequence, Verbose, TEXT("Input Action index is built from %d assets"), Entries.Num());
+}
+
+void FInputSequenceInputActionIndex::AddOrUpdate(const FAssetData& assetData)
+{
+	if (!IsInputAction(assetData)) return;
+
+	FEntry entry;
+	entry.Path = assetData.GetSoftObjectPath();
+	entry.Name = assetData.AssetName;
+
+	FString valueTypeString;
+
+	if (assetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UInputAction, ValueType), valueTypeString))
+	{
+		const int64 valueType = StaticEnum<EInputActionValueType>()->GetValueByNameString(valueTypeString);
+
+		if (valueType != INDEX_NONE) entry.ValueType = (EInputActionValueType)valueType;
+	}
+	else if (UInputAction* inputAction = Cast<UInputAction>(assetData.FastGetAsset(false)))
+	{
+		entry.ValueType = inputAction->ValueType;
+	}
+	else if (UInputAction* loadedInputAction = Cast<UInputAction>(assetData.GetAsset()))
+	{
+		// Assets saved before value type was a tag are loaded once per session
+
+		entry.ValueType = loadedInputAction->ValueType;
+	}
+
+	Entries.Add(entry.Path, entry);
+}
+
+void FInputSequenceInputActionIndex::OnAssetRemoved(const FAssetData& assetData)
+{
+	Entries.Remove(assetData.GetSoftObjectPath());
+}
+
+void FInputSequenceInputActionIndex::OnAssetRenamed(const FAssetData& assetData, const FString& oldObjectPath)
+{
+	Entries.Remove(FSoftObjectPath(oldObjectPath));
+
+	AddOrUpdate(assetData);
+}
+
+void FInputSequenceInputActionIndex::OnObjectPropertyChanged(UObject* object, FPropertyChangedEvent& propertyChangedEvent)
+{
+	if (UInputAction* inputAction = Cast<UInputAction>(object))
+	{
+		if (FEntry* entry = Entries.Find(FSoftObjectPath(inputAction)))
+		{
+			entry->ValueType = inputAction->ValueType;
+		}
+	}
+}
+
+bool FInputSequenceInputActionIndex::IsInputAction(const FAssetData& assetData)
+{
+	if (assetData.AssetClassPath == UInputAction::StaticClass()->GetClassPathName()) return true;
+
+	// Subclasses of Input Action are rare, their classes are loaded anyway as they are native or Blueprint generated
+	if (UClass* assetClass = FindObject<UClass>(assetData.AssetClassPath)) return assetClass->IsChildOf<UInputAction>();
+
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionValue.h"
+
+struct FAssetData;
+
+/* Value types of all Input Action assets of project, taken from asset registry tags, so add pin menus don't load Input Actions they list. Kept up to date by asset registry callbacks */
+class FInputSequenceInputActionIndex
+{
+public:
+
+	struct FEntry
+	{
+		FSoftObjectPath Path;
+
+		FName Name;
+
+		EInputActionValueType ValueType = EInputActionValueType::Boolean;
+	};
+
+	static FInputSequenceInputActionIndex& Get();
+
+	/* Frees index and unsubscribes from asset registry, called on module shutdown */
+	static void Shutdown();
+
+	void GetEntries(TArray<FEntry>& outEntries, TFunctionRef<bool(EInputActionValueType)> valueTypeFilter);
+
+	~FInputSequenceInputActionIndex();
+
+protected:
+
+	void Build();
+
+	void AddOrUpdate(const FAssetData& assetData);
+
+	void OnAssetAdded(const FAssetData& assetData) { AddOrUpdate(assetData); }
+
+	void OnAssetRemoved(const FAssetData& assetData);
+
+	void OnAssetRenamed(const FAssetData& assetData, const FString& oldObjectPath);
+
+	void OnObjectPropertyChanged(UObject* object, FPropertyChangedEvent& propertyChangedEvent);
+
+	static bool IsInputAction(const FAssetData& assetData);
+
+	TMap<FSoftObjectPath, FEntry> Entries;
+
+	bool bIsBuilt = false;
+
+	FDelegateHandle OnAssetAddedHandle;
+	FDelegateHandle OnAssetRemovedHandle;
+	FDelegateHandle OnAssetRenamedHandle;
+	FDelegateHandle OnAssetUpdatedHandle;
+	FDelegateHandle OnObjectPropertyChangedHandle;
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#include "InputSequenceValidator.h"
+#include "InputSequenceAnalyzer.h"
+#include "InputSequenceAsset.h"
+
+#define LOCTEXT_NAMESPACE "UInputSequenceValidator"
+
+UInputSequenceValidator::UInputSequenceValidator(const FObjectInitializer& objInit) :Super(objInit) {}
+
+bool UInputSequenceValidator::CanValidateAsset_Implementation(UObject* InAsset) const
+{
+	return GetDefault<UInputSequenceEditorSettings>()->bValidateBudgets && InAsset && InAsset->IsA<UInputSequenceAsset>();
+}
+
+EDataValidationResult UInputSequenceValidator::ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors)
+{
+	FInputSequenceAnalysis analysis;
+	FInputSequenceAnalyzer::Analyze(Cast<UInputSequenceAsset>(InAsset), analysis);
+
+	TArray<FInputSequenceAnalysis::FMessage> messages;
+	analysis.GetMessages(messages);
+
+	bool bHasErrors = false;
+
+	for (const FInputSequenceAnalysis::FMessage& message : messages)
+	{
+		if (message.bIsError)
+		{
+			AssetFails(InAsset, message.Text, ValidationErrors);
+			bHasErrors = true;
+		}
+		else
+		{
+			AssetWarning(InAsset, message.Text);
+		}
+	}
+
+	if (!bHasErrors) AssetPasses(InAsset);
+
+	return GetValidationResult();
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,19 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+#include "EditorValidatorBase.h"
+#include "InputSequenceValidator.generated.h"
+
+/* Checks Input Sequence Assets against budgets of Input Sequence Editor settings, so assets that are too expensive to evaluate can't be submitted */
+UCLASS()
+class UInputSequenceValidator : public UEditorValidatorBase
+{
+	GENERATED_UCLASS_BODY()
+
+protected:
+
+	virtual bool CanValidateAsset_Implementation(UObject* InAsset) const override;
+
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors) override;
+};
\ No newline at end of file
@@ -0,0 +1,142 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+// Microbenchmark of InputSequenceCore evaluator and input stream codec: InputSequenceCoreBenchmark [NumSequences] [NumFrames]
+
+#include "InputSequenceCoreTestGraph.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace InputSequenceCoreTests;
+
+namespace
+{
+	/* Combo graph: every sequence is a chain of actions and one axis step, sequences share names the way fighting game combos do */
+	void BuildComboGraph(FTestGraph& graph, uint32_t numSequences, uint32_t numNames, uint32_t chainLength)
+	{
+		for (uint32_t i = 0; i < numNames; i++) graph.AddName();
+
+		const uint16_t nameAxis = graph.AddName();
+
+		graph.AddStart();
+
+		std::mt19937 random(7);
+
+		for (uint32_t sequence = 0; sequence < numSequences; sequence++)
+		{
+			uint16_t stateIndex = 0;
+
+			for (uint32_t step = 0; step < chainLength; step++)
+			{
+				const uint16_t nameId = (uint16_t)(random() % numNames);
+				stateIndex = graph.AddInput(stateIndex, { FTestGraph::MakeAction(nameId, { EInputEvent::Pressed }) });
+			}
+
+			const float axisMin = (random() % 8) / 8.f;
+			stateIndex = graph.AddInput(stateIndex, { FTestGraph::MakeAxis(nameAxis, axisMin, axisMin + 0.125f) }, EStateFlags::AxisNode);
+
+			graph.GetState(stateIndex).PassEventClass = 0;
+
+			graph.AddReset(stateIndex);
+		}
+
+		graph.Build();
+	}
+
+	template<typename TFunction>
+	double MeasureNsPerFrame(uint32_t numFrames, TFunction&& function)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		for (uint32_t frame = 0; frame < numFrames; frame++) function(frame);
+
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / numFrames;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const uint32_t numSequences = argc > 1 ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 256;
+	const uint32_t numFrames = argc > 2 ? (uint32_t)std::strtoul(argv[2], nullptr, 10) : 200000;
+
+	constexpr uint32_t numNames = 12;
+	constexpr uint32_t chainLength = 4;
+
+	FTestGraph graph;
+	BuildComboGraph(graph, numSequences, numNames, chainLength);
+
+	const FGraphView view = graph.GetView();
+
+	// Input is generated up front, so only evaluation is measured
+
+	std::mt19937 random(11);
+
+	std::vector<FActionInput> frameActions(numFrames);
+	std::vector<FAxisInput> frameAxes(numFrames);
+
+	for (uint32_t frame = 0; frame < numFrames; frame++)
+	{
+		// Every press is released on next frame, so axis steps see no held actions
+		frameActions[frame] = frame % 2 == 0 ? FActionInput{ (uint32_t)(random() % numNames), EInputEvent::Pressed } : FActionInput{ frameActions[frame - 1].NameId, EInputEvent::Released };
+		frameAxes[frame] = { numNames, (random() % 1000) / 1000.f };
+	}
+
+	std::vector<FEventCall> eventCalls;
+	std::vector<FResetSource> resetSources;
+
+	uint64_t numEventCalls = 0;
+
+	std::printf("%u sequences, %d states, %d actions, %u frames\n", numSequences, view.NumStates(), view.NumActions(), numFrames);
+
+	for (const bool bFilterAxisInput : { false, true })
+	{
+		FSettings settings;
+		settings.bFilterAxisInput = bFilterAxisInput;
+
+		FInstance instance;
+		instance.Reset(view);
+
+		const double nsPerFrame = MeasureNsPerFrame(numFrames, [&](uint32_t frame)
+		{
+			eventCalls.clear();
+			instance.OnInput(view, settings, 1 / 60.f, false, &frameActions[frame], 1, &frameAxes[frame], 1, eventCalls, resetSources);
+
+			numEventCalls += eventCalls.size();
+		});
+
+		std::printf("OnInput%s: %.1f ns/frame\n", bFilterAxisInput ? " (filtered axes)" : "", nsPerFrame);
+	}
+
+	{
+		FInputStreamCodec writerCodec;
+		FInputStreamCodec readerCodec;
+
+		FBitWriter writer;
+
+		std::vector<FActionInput> actionInputs;
+		std::vector<FAxisInput> axisInputs;
+
+		uint64_t numBits = 0;
+
+		const double nsPerFrame = MeasureNsPerFrame(numFrames, [&](uint32_t frame)
+		{
+			writer.Reset();
+			writerCodec.Write(view, &frameActions[frame], 1, &frameAxes[frame], 1, writer, actionInputs, axisInputs);
+
+			numBits += writer.GetNumBits();
+
+			FBitReader reader(writer.GetData().data(), writer.GetData().size());
+			readerCodec.Read(view, reader, actionInputs, axisInputs);
+		});
+
+		std::printf("Input stream write and read: %.1f ns/frame, %.1f bits/frame\n", nsPerFrame, (double)numBits / numFrames);
+	}
+
+	std::printf("%llu event calls\n", (unsigned long long)numEventCalls);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+#pragma once
+
+// Builds compiled blobs for tests and benchmark of InputSequenceCore, laid out the same way as FInputSequenceCompiledData::Build does it
+
+#include "InputSequenceCore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+namespace InputSequenceCoreTests
+{
+	using namespace InputSequenceCore;
+
+	struct FTestState
+	{
+		EStateFlags Flags = EStateFlags::None;
+
+		/* -1 for Start node */
+		int32_t FirstLayerParentIndex = 0;
+
+		float TimeParam = 0;
+
+		std::vector<FCompactAction> Actions;
+
+		std::vector<uint16_t> NextIndice;
+
+		std::vector<uint16_t> PressedActions;
+
+		/* Event class index called when state is passed, -1 for none */
+		int32_t PassEventClass = -1;
+	};
+
+	class FTestGraph
+	{
+	public:
+
+		static FCompactAction MakeAction(uint16_t nameId, std::initializer_list<EInputEvent> inputEvents)
+		{
+			FCompactAction action = MakeEmptyAction(nameId);
+
+			for (EInputEvent inputEvent : inputEvents) action.InputEvents[action.NumInputEvents++] = (uint8_t)inputEvent;
+
+			return action;
+		}
+
+		static FCompactAction MakeAxis(uint16_t nameId, float min, float max)
+		{
+			FCompactAction action = MakeEmptyAction(nameId);
+			action.X = min;
+			action.Y = max;
+
+			return action;
+		}
+
+		/* Region of 2D or 3D axis, region is added to graph */
+		FCompactAction MakeRegionAxis(uint16_t nameId, ERegionShape shape, const FCompactRegion& region)
+		{
+			FCompactAction action = MakeEmptyAction(nameId);
+			action.RegionShape = shape;
+			action.RegionIndex = (uint16_t)Regions.size();
+			action.NumRegions = 1;
+
+			Regions.push_back(region);
+
+			return action;
+		}
+
+		uint16_t AddName() { return (uint16_t)NumNames++; }
+
+		uint16_t AddState(const FTestState& state)
+		{
+			States.push_back(state);
+			return (uint16_t)(States.size() - 1);
+		}
+
+		FTestState& GetState(uint16_t stateIndex) { return States[stateIndex]; }
+
+		/* Start node, must be added first */
+		uint16_t AddStart() { FTestState state; state.FirstLayerParentIndex = -1; return AddState(state); }
+
+		/* Input node linked from parent, first layer nodes are linked from Start node */
+		uint16_t AddInput(uint16_t parentIndex, std::initializer_list<FCompactAction> actions, EStateFlags flags = EStateFlags::None)
+		{
+			FTestState state;
+			state.Flags = EStateFlags::InputNode | flags;
+			state.FirstLayerParentIndex = parentIndex == 0 ? 0 : GetFirstLayerParent(parentIndex);
+			state.Actions = actions;
+
+			return Link(parentIndex, AddState(state));
+		}
+
+		/* Node that is not an input node (e.g. Reset node), active state of it goes back to First Layer parent */
+		uint16_t AddReset(uint16_t parentIndex)
+		{
+			FTestState state;
+			state.FirstLayerParentIndex = GetFirstLayerParent(parentIndex);
+
+			return Link(parentIndex, AddState(state));
+		}
+
+		uint16_t Link(uint16_t fromIndex, uint16_t toIndex)
+		{
+			States[fromIndex].NextIndice.push_back(toIndex);
+			return toIndex;
+		}
+
+		void Build()
+		{
+			std::vector<FCompactState> compactStates;
+			std::vector<FCompactAction> compactActions;
+			std::vector<FCompactEventList> eventLists;
+			std::vector<uint16_t> indices;
+
+			NumEventClasses = 0;
+
+			// Event list 0 is shared by all states without events
+
+			eventLists.push_back({ 0, 0 });
+
+			for (const FTestState& state : States)
+			{
+				FCompactState compactState;
+				std::memset(&compactState, 0, sizeof(compactState));
+
+				compactState.TimeParam = state.TimeParam;
+				compactState.FirstLayerParentIndex = state.FirstLayerParentIndex < 0 ? FCompactState::IndexNone : (uint16_t)state.FirstLayerParentIndex;
+				compactState.Flags = state.Flags;
+				compactState.StateObjectIndex = FCompactState::IndexNone;
+
+				if (state.PassEventClass >= 0)
+				{
+					compactState.PassEventList = (uint16_t)eventLists.size();
+
+					eventLists.push_back({ (uint32_t)indices.size(), 1 });
+					indices.push_back((uint16_t)state.PassEventClass);
+
+					NumEventClasses = std::max(NumEventClasses, (size_t)state.PassEventClass + 1);
+				}
+
+				compactState.FirstAction = (uint32_t)compactActions.size();
+				compactState.NumActions = (uint8_t)state.Actions.size();
+				compactActions.insert(compactActions.end(), state.Actions.begin(), state.Actions.end());
+
+				compactState.FirstNext = (uint32_t)indices.size();
+				compactState.NumNext = (uint16_t)state.NextIndice.size();
+				indices.insert(indices.end(), state.NextIndice.begin(), state.NextIndice.end());
+
+				compactState.FirstPressed = (uint32_t)indices.size();
+				compactState.NumPressed = (uint8_t)state.PressedActions.size();
+				indices.insert(indices.end(), state.PressedActions.begin(), state.PressedActions.end());
+
+				compactStates.push_back(compactState);
+			}
+
+			FCompiledHeader header;
+			header.Magic = Magic;
+			header.Version = BlobVersion;
+			header.NumNames = (uint32_t)NumNames;
+
+			uint32_t offset = sizeof(FCompiledHeader);
+
+			header.NumStates = (uint32_t)compactStates.size();
+			header.StatesOffset = offset = Align(offset, alignof(FCompactState));
+			offset += (uint32_t)(compactStates.size() * sizeof(FCompactState));
+
+			header.NumActions = (uint32_t)compactActions.size();
+			header.ActionsOffset = offset = Align(offset, alignof(FCompactAction));
+			offset += (uint32_t)(compactActions.size() * sizeof(FCompactAction));
+
+			header.NumEventLists = (uint32_t)eventLists.size();
+			header.EventListsOffset = offset = Align(offset, alignof(FCompactEventList));
+			offset += (uint32_t)(eventLists.size() * sizeof(FCompactEventList));
+
+			header.NumIndices = (uint32_t)indices.size();
+			header.IndicesOffset = offset = Align(offset, alignof(uint16_t));
+			offset += (uint32_t)(indices.size() * sizeof(uint16_t));
+
+			header.NumRegions = (uint32_t)Regions.size();
+			header.RegionsOffset = offset = Align(offset, alignof(FCompactRegion));
+			offset += (uint32_t)(Regions.size() * sizeof(FCompactRegion));
+
+			// Regions are read with aligned loads, blob is kept in storage of regions to have their alignment
+
+			Storage.assign((offset + sizeof(FCompactRegion) - 1) / sizeof(FCompactRegion), FCompactRegion());
+			BlobSize = offset;
+
+			uint8_t* blob = reinterpret_cast<uint8_t*>(Storage.data());
+			std::memset(blob, 0, Storage.size() * sizeof(FCompactRegion));
+
+			std::memcpy(blob, &header, sizeof(header));
+			if (!compactStates.empty()) std::memcpy(blob + header.StatesOffset, compactStates.data(), compactStates.size() * sizeof(FCompactState));
+			if (!compactActions.empty()) std::memcpy(blob + header.ActionsOffset, compactActions.data(), compactActions.size() * sizeof(FCompactAction));
+			std::memcpy(blob + header.EventListsOffset, eventLists.data(), eventLists.size() * sizeof(FCompactEventList));
+			if (!indices.empty()) std::memcpy(blob + header.IndicesOffset, indices.data(), indices.size() * sizeof(uint16_t));
+			if (!Regions.empty()) std::memcpy(blob + header.RegionsOffset, Regions.data(), Regions.size() * sizeof(FCompactRegion));
+		}
+
+		FGraphView GetView() const { return FGraphView(reinterpret_cast<const uint8_t*>(Storage.data()), BlobSize); }
+
+		bool Validate() const { return GetView().Validate(NumNames, 0, 1, NumEventClasses); }
+
+	protected:
+
+		static FCompactAction MakeEmptyAction(uint16_t nameId)
+		{
+			FCompactAction action;
+			std::memset(&action, 0, sizeof(action));
+
+			action.Z = -1; // Not a 2D sector
+			action.NameIndex = nameId;
+
+			return action;
+		}
+
+		static uint32_t Align(uint32_t offset, uint32_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+
+		int32_t GetFirstLayerParent(uint16_t stateIndex) const { return States[stateIndex].FirstLayerParentIndex == 0 ? stateIndex : States[stateIndex].FirstLayerParentIndex; }
+
+		size_t NumNames = 0;
+
+		size_t NumEventClasses = 0;
+
+		std::vector<FTestState> States;
+
+		std::vector<FCompactRegion> Regions;
+
+		std::vector<FCompactRegion> Storage;
+
+		size_t BlobSize = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,448 @@
+// Copyright 2022 Pentangle Studio Licensed under the Apache License, Version 2.0 (the «License»);
+
+// Unit tests of InputSequenceCore. Run without arguments to run all tests, or with test name to run one of them
+
+#include "InputSequenceCoreTestGraph.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace InputSequenceCoreTests;
+
+namespace
+{
+	int NumFailures = 0;
+
+#define CHECK(Expr) do { if (!(Expr)) { std::printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #Expr); NumFailures++; } } while (0)
+
+	bool Contains(const std::vector<uint16_t>& values, uint16_t value) { return std::find(values.begin(), values.end(), value) != values.end(); }
+
+	/* Instance over test graph, fed with one frame of input per Step call */
+	struct FTestInstance
+	{
+		explicit FTestInstance(const FTestGraph& graph) : Graph(graph.GetView()) { Instance.Reset(Graph); }
+
+		void Step(std::initializer_list<FActionInput> actionInputs, std::initializer_list<FAxisInput> axisInputs = {}, float deltaTime = 0.01f)
+		{
+			const std::vector<FActionInput> actions(actionInputs);
+			const std::vector<FAxisInput> axes(axisInputs);
+
+			EventCalls.clear();
+			Instance.OnInput(Graph, Settings, deltaTime, false, actions.data(), actions.size(), axes.data(), axes.size(), EventCalls, ResetSources);
+		}
+
+		FGraphView Graph;
+
+		FSettings Settings;
+
+		FInstance Instance;
+
+		std::vector<FEventCall> EventCalls;
+
+		std::vector<FResetSource> ResetSources;
+	};
+
+	/* Start -> A -> B -> Reset node, B calls event class 0 when it is passed */
+	struct FSequenceGraph : FTestGraph
+	{
+		FSequenceGraph()
+		{
+			NameA = AddName();
+			NameB = AddName();
+			NameC = AddName();
+
+			AddStart();
+			StateA = AddInput(0, { MakeAction(NameA, { EInputEvent::Pressed }) });
+			StateB = AddInput(StateA, { MakeAction(NameB, { EInputEvent::Pressed }) });
+			StateReset = AddReset(StateB);
+
+			GetState(StateB).PassEventClass = 0;
+
+			Build();
+		}
+
+		uint16_t NameA, NameB, NameC;
+
+		uint16_t StateA, StateB, StateReset;
+	};
+
+	void TestMatching()
+	{
+		FSequenceGraph graph;
+		CHECK(graph.Validate());
+
+		FTestInstance test(graph);
+
+		test.Step({});
+		CHECK(test.Instance.IsStateActive(graph.StateA));
+
+		test.Step({ { graph.NameB, EInputEvent::Pressed } });
+		CHECK(test.Instance.IsStateActive(graph.StateA));
+		CHECK(test.Instance.GetPassedStates().empty());
+
+		test.Step({ { graph.NameB, EInputEvent::Released }, { graph.NameA, EInputEvent::Pressed } });
+		CHECK(Contains(test.Instance.GetPassedStates(), graph.StateA));
+		CHECK(test.Instance.IsStateActive(graph.StateB));
+		CHECK(!test.Instance.IsStateActive(graph.StateA));
+
+		test.Step({ { graph.NameA, EInputEvent::Released }, { graph.NameB, EInputEvent::Pressed } });
+		CHECK(Contains(test.Instance.GetPassedStates(), graph.StateB));
+		CHECK(test.Instance.IsStateActive(graph.StateReset));
+		CHECK(test.EventCalls.size() == 1 && test.EventCalls[0].StateIndex == graph.StateB && test.EventCalls[0].EventClassIndex == 0);
+
+		// Reset node sends sequence back to its First Layer node
+
+		test.Step({ { graph.NameB, EInputEvent::Released } });
+		CHECK(test.ResetSources.size() == 1 && test.ResetSources[0].SourceIndex == graph.StateReset);
+		CHECK(test.Instance.IsStateActive(graph.StateA));
+		CHECK(test.Instance.GetNumActiveStates() == 1);
+	}
+
+	void TestResets()
+	{
+		FSequenceGraph graph;
+
+		// External request resets all active states
+
+		{
+			FTestInstance test(graph);
+
+			test.Step({ { graph.NameA, EInputEvent::Pressed } });
+			CHECK(test.Instance.IsStateActive(graph.StateB));
+
+			test.Instance.RequestReset(7);
+			test.Step({});
+			CHECK(test.ResetSources.size() == 1 && test.ResetSources[0].SourceIndex == -1 && test.ResetSources[0].ExternalId == 7);
+			CHECK(test.Instance.GetNumActiveStates() == 0);
+
+			// Actions still held would step sequence again right away
+
+			test.Step({ { graph.NameA, EInputEvent::Released } });
+			CHECK(test.Instance.IsStateActive(graph.StateA));
+		}
+
+		// State is reset after time if settings ask for it
+
+		{
+			FTestInstance test(graph);
+			test.Settings.bIsResetAfterTime = true;
+			test.Settings.ResetAfterTime = 0.2f;
+
+			test.Step({ { graph.NameA, EInputEvent::Pressed } });
+			test.Step({ { graph.NameA, EInputEvent::Released } }, {}, 0.1f);
+			CHECK(test.Instance.IsStateActive(graph.StateB));
+
+			test.Step({}, {}, 0.15f);
+			CHECK(!test.Instance.IsStateActive(graph.StateB));
+			CHECK(test.Instance.IsStateActive(graph.StateA));
+		}
+
+		// Action that state does not have resets it if precise match is required
+
+		{
+			FTestInstance test(graph);
+			test.Settings.bRequirePreciseMatch = true;
+
+			test.Step({ { graph.NameA, EInputEvent::Pressed } });
+			test.Step({ { graph.NameA, EInputEvent::Released }, { graph.NameC, EInputEvent::Pressed } });
+			CHECK(!test.Instance.IsStateActive(graph.StateB));
+			CHECK(test.Instance.IsStateActive(graph.StateA));
+			CHECK(test.Instance.GetFrameStats().Resets == 1);
+		}
+
+		// Same action is ignored without precise match
+
+		{
+			FTestInstance test(graph);
+
+			test.Step({ { graph.NameA, EInputEvent::Pressed } });
+			test.Step({ { graph.NameA, EInputEvent::Released }, { graph.NameC, EInputEvent::Pressed } });
+			CHECK(test.Instance.IsStateActive(graph.StateB));
+		}
+	}
+
+	void TestAxisFilter()
+	{
+		FTestGraph graph;
+		const uint16_t nameAxis = graph.AddName();
+
+		graph.AddStart();
+		const uint16_t stateAxis = graph.AddInput(0, { FTestGraph::MakeAxis(nameAxis, 0.5f, 1.f) }, EStateFlags::AxisNode);
+		const uint16_t stateNext = graph.AddInput(stateAxis, { FTestGraph::MakeAxis(nameAxis, -1.f, -0.5f) }, EStateFlags::AxisNode);
+		graph.Build();
+		CHECK(graph.Validate());
+
+		FTestInstance test(graph);
+		test.Settings.bFilterAxisInput = true;
+
+		test.Step({}, { { nameAxis, 0.2f } });
+		CHECK(test.Instance.GetFrameStats().AxisZoneChanges == 1);
+		CHECK(test.Instance.IsStateActive(stateAxis));
+
+		// Moves inside of zone are not applied
+
+		test.Step({}, { { nameAxis, 0.3f } });
+		CHECK(test.Instance.GetFrameStats().AxisZoneChanges == 0);
+
+		test.Step({}, { { nameAxis, 0.7f } });
+		CHECK(test.Instance.GetFrameStats().AxisZoneChanges == 1);
+		CHECK(test.Instance.IsStateActive(stateNext));
+
+		test.Step({}, { { nameAxis, -0.7f } });
+		CHECK(test.Instance.GetFrameStats().AxisZoneChanges == 1);
+		CHECK(Contains(test.Instance.GetPassedStates(), stateNext));
+
+		// Range is matched against held zone on frames without zone change, so node entered while axis is already in its range passes
+
+		FTestGraph holdGraph;
+		const uint16_t nameHoldAxis = holdGraph.AddName();
+
+		holdGraph.AddStart();
+		const uint16_t stateFirst = holdGraph.AddInput(0, { FTestGraph::MakeAxis(nameHoldAxis, 0.5f, 1.f) }, EStateFlags::AxisNode);
+		const uint16_t stateHold = holdGraph.AddInput(stateFirst, { FTestGraph::MakeAxis(nameHoldAxis, 0.5f, 1.f) }, EStateFlags::AxisNode);
+		holdGraph.Build();
+
+		FTestInstance testHold(holdGraph);
+		testHold.Settings.bFilterAxisInput = true;
+
+		testHold.Step({});
+		testHold.Step({}, { { nameHoldAxis, 0.7f } });
+		CHECK(testHold.Instance.IsStateActive(stateHold));
+
+		testHold.Step({}, { { nameHoldAxis, 0.8f } });
+		CHECK(testHold.Instance.GetFrameStats().AxisZoneChanges == 0);
+		CHECK(Contains(testHold.Instance.GetPassedStates(), stateHold));
+
+		// Toggling filter drops held zones
+
+		testHold.Settings.bFilterAxisInput = false;
+		testHold.Step({});
+		testHold.Settings.bFilterAxisInput = true;
+		testHold.Step({});
+		CHECK(testHold.Instance.IsStateActive(stateFirst));
+		CHECK(testHold.Instance.GetPassedStates().empty());
+
+		// Hysteresis keeps zone while value stays close to its bounds
+
+		FTestInstance testHysteresis(graph);
+		testHysteresis.Settings.bFilterAxisInput = true;
+		testHysteresis.Settings.AxisHysteresis = 0.1f;
+
+		testHysteresis.Step({}, { { nameAxis, 0.2f } });
+		testHysteresis.Step({}, { { nameAxis, 0.55f } });
+		CHECK(testHysteresis.Instance.GetFrameStats().AxisZoneChanges == 0);
+		CHECK(testHysteresis.Instance.IsStateActive(stateAxis));
+
+		testHysteresis.Step({}, { { nameAxis, 0.65f } });
+		CHECK(testHysteresis.Instance.GetFrameStats().AxisZoneChanges == 1);
+		CHECK(testHysteresis.Instance.IsStateActive(stateNext));
+	}
+
+	void TestCodecRoundTrip()
+	{
+		FTestGraph graph;
+		const uint16_t nameAction = graph.AddName();
+		const uint16_t nameAxis = graph.AddName();
+		const uint16_t nameStick = graph.AddName();
+
+		FCompactRegion box = { { -1, -1, -1, 0 }, { 1, 1, 1, 0 } };
+
+		graph.AddStart();
+		const uint16_t stateAction = graph.AddInput(0, { FTestGraph::MakeAction(nameAction, { EInputEvent::Pressed }) });
+		graph.AddInput(stateAction, { FTestGraph::MakeAxis(nameAxis, 0.5f, 1.f) }, EStateFlags::AxisNode);
+		graph.AddInput(0, { graph.MakeRegionAxis(nameStick, ERegionShape::Box, box) }, EStateFlags::AxisNode);
+		graph.Build();
+		CHECK(graph.Validate());
+
+		const FGraphView view = graph.GetView();
+
+		struct FFrame
+		{
+			std::vector<FActionInput> Actions;
+			std::vector<FAxisInput> Axes;
+		};
+
+		const FFrame frames[] =
+		{
+			{ { { nameAction, EInputEvent::Pressed } }, { { nameAxis, 0.7f }, { nameStick, 0.1f, 0.2f, 0.3f } } },
+			{ {}, { { nameAxis, 0.8f }, { nameStick, 0.1f, 0.2f, 0.3f } } },
+			{ { { nameAction, EInputEvent::Released }, { 50, EInputEvent::DoubleClick } }, { { nameAxis, 0.2f } } },
+			{ {}, { { nameStick, -0.4f, 0.f, 0.9f } } },
+		};
+
+		FInputStreamCodec writerCodec;
+		FInputStreamCodec readerCodec;
+
+		for (const FFrame& frame : frames)
+		{
+			FBitWriter writer;
+
+			std::vector<FActionInput> writtenActions;
+			std::vector<FAxisInput> writtenAxes;
+			writerCodec.Write(view, frame.Actions.data(), frame.Actions.size(), frame.Axes.data(), frame.Axes.size(), writer, writtenActions, writtenAxes);
+
+			float deltaTime = 1 / 60.f;
+			FInputStreamCodec::WriteDeltaTime(writer, deltaTime);
+
+			const uint16_t passedStates[] = { stateAction };
+			writerCodec.WritePassedStates(view, passedStates, 1, writer);
+
+			FBitReader reader(writer.GetData().data(), writer.GetData().size());
+
+			std::vector<FActionInput> readActions;
+			std::vector<FAxisInput> readAxes;
+			CHECK(readerCodec.Read(view, reader, readActions, readAxes));
+
+			float readDeltaTime = 0;
+			CHECK(FInputStreamCodec::ReadDeltaTime(reader, readDeltaTime));
+			CHECK(readDeltaTime == deltaTime);
+
+			std::vector<uint16_t> readPassedStates;
+			CHECK(readerCodec.ReadPassedStates(view, reader, readPassedStates));
+			CHECK(readPassedStates.size() == 1 && readPassedStates[0] == stateAction);
+
+			CHECK(readActions.size() == writtenActions.size() && writtenActions.size() == frame.Actions.size());
+			for (size_t i = 0; i < readActions.size() && i < writtenActions.size(); i++)
+			{
+				CHECK(readActions[i].NameId == writtenActions[i].NameId && readActions[i].Event == writtenActions[i].Event);
+			}
+
+			CHECK(readAxes.size() == writtenAxes.size() && writtenAxes.size() == frame.Axes.size());
+			for (size_t i = 0; i < readAxes.size() && i < writtenAxes.size(); i++)
+			{
+				CHECK(readAxes[i].NameId == writtenAxes[i].NameId);
+				CHECK(readAxes[i].Value == writtenAxes[i].Value && readAxes[i].ValueY == writtenAxes[i].ValueY && readAxes[i].ValueZ == writtenAxes[i].ValueZ);
+			}
+		}
+
+		// Names graph does not know are all sent as one id past its names
+
+		{
+			FBitWriter writer;
+
+			const FActionInput unknownAction = { 50, EInputEvent::Pressed };
+
+			std::vector<FActionInput> writtenActions;
+			std::vector<FAxisInput> writtenAxes;
+			writerCodec.Write(view, &unknownAction, 1, nullptr, 0, writer, writtenActions, writtenAxes);
+
+			CHECK(writtenActions.size() == 1 && writtenActions[0].NameId == (uint32_t)view.NumNames());
+		}
+
+		// Events that don't fit action event bits are dropped, not sent as other event
+
+		{
+			FBitWriter writer;
+
+			const FActionInput actionInputs[] = { { nameAction, EInputEvent::Axis }, { nameAction, EInputEvent::Pressed } };
+
+			std::vector<FActionInput> writtenActions;
+			std::vector<FAxisInput> writtenAxes;
+			writerCodec.Write(view, actionInputs, 2, nullptr, 0, writer, writtenActions, writtenAxes);
+
+			CHECK(writtenActions.size() == 1 && writtenActions[0].Event == EInputEvent::Pressed);
+
+			FBitReader reader(writer.GetData().data(), writer.GetData().size());
+
+			std::vector<FActionInput> readActions;
+			std::vector<FAxisInput> readAxes;
+			CHECK(readerCodec.Read(view, reader, readActions, readAxes));
+			CHECK(readActions.size() == 1 && readActions[0].NameId == nameAction && readActions[0].Event == EInputEvent::Pressed);
+		}
+
+		// Truncated frame is rejected
+
+		{
+			FBitWriter writer;
+
+			std::vector<FActionInput> writtenActions;
+			std::vector<FAxisInput> writtenAxes;
+			writerCodec.Write(view, frames[0].Actions.data(), frames[0].Actions.size(), frames[0].Axes.data(), frames[0].Axes.size(), writer, writtenActions, writtenAxes);
+
+			FBitReader reader(writer.GetData().data(), writer.GetData().size() / 2);
+
+			std::vector<FActionInput> readActions;
+			std::vector<FAxisInput> readAxes;
+			CHECK(!readerCodec.Read(view, reader, readActions, readAxes));
+		}
+	}
+
+	void TestDebugRing()
+	{
+		FDebugRing ring;
+
+		ring.BeginFrame();
+		ring.Write(3, EStateEvent::Enter);
+		ring.Write(4, EStateEvent::Pass);
+
+		uint64_t readIndex = 0;
+		std::vector<FDebugRecord> records;
+
+		CHECK(ring.Read(readIndex, records) == 0);
+		CHECK(readIndex == 2);
+		CHECK(records.size() == 2);
+		CHECK(records.size() == 2 && records[0].Frame == 1 && records[0].StateIndex == 3 && records[0].Event == EStateEvent::Enter);
+		CHECK(records.size() == 2 && records[1].Frame == 1 && records[1].StateIndex == 4 && records[1].Event == EStateEvent::Pass);
+
+		// Nothing new to read
+
+		records.clear();
+		CHECK(ring.Read(readIndex, records) == 0);
+		CHECK(records.empty());
+
+		// Writer laps reader, records it did not get to are reported as lost
+
+		ring.BeginFrame();
+
+		constexpr uint32_t numOverflow = 10;
+
+		for (uint32_t i = 0; i < FDebugRing::Capacity + numOverflow; i++) ring.Write((uint16_t)i, EStateEvent::Reset);
+
+		records.clear();
+		CHECK(ring.Read(readIndex, records) == numOverflow);
+		CHECK(records.size() == FDebugRing::Capacity);
+		CHECK(!records.empty() && records.front().StateIndex == numOverflow && records.back().StateIndex == FDebugRing::Capacity + numOverflow - 1);
+		CHECK(!records.empty() && records.back().Frame == 2);
+	}
+
+	struct FTest
+	{
+		const char* Name;
+
+		void (*Run)();
+	};
+
+	const FTest Tests[] =
+	{
+		{ "Matching", TestMatching },
+		{ "Resets", TestResets },
+		{ "AxisFilter", TestAxisFilter },
+		{ "CodecRoundTrip", TestCodecRoundTrip },
+		{ "DebugRing", TestDebugRing },
+	};
+}
+
+int main(int argc, char** argv)
+{
+	bool bIsFound = false;
+
+	for (const FTest& test : Tests)
+	{
+		if (argc > 1 && std::strcmp(argv[1], test.Name) != 0) continue;
+
+		bIsFound = true;
+
+		const int numFailuresBefore = NumFailures;
+		test.Run();
+
+		std::printf("%s: %s\n", test.Name, NumFailures == numFailuresBefore ? "passed" : "FAILED");
+	}
+
+	if (!bIsFound)
+	{
+		std::printf("Unknown test %s\n", argv[1]);
+		return 1;
+	}
+
+	return NumFailures == 0 ? 0 : 1;
+}
\ No newline at end of file